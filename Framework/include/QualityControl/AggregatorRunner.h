@@ -62,6 +62,7 @@ class Aggregator;
 namespace repository
 {
 class DatabaseInterface;
+class AsyncDatabase;
 }
 } // namespace o2::quality_control
 
@@ -187,6 +188,7 @@ class AggregatorRunner : public framework::Task
   std::vector<std::shared_ptr<Aggregator>> mAggregators;
   std::unordered_map<std::string, std::shared_ptr<Aggregator>> mAggregatorsMap;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
+  std::shared_ptr<o2::quality_control::repository::AsyncDatabase> mAsyncDatabase; // same as mDatabase if asynchronous storage is enabled
   AggregatorRunnerConfig mRunnerConfig;
   std::vector<AggregatorConfig> mAggregatorsConfig;
   core::QualityObjectsMapType mQualityObjects; // where we cache the incoming quality objects and the output of the aggregators
@@ -0,0 +1,148 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   AsyncDatabase.h
+///
+
+#ifndef QC_REPOSITORY_ASYNCDATABASE_H
+#define QC_REPOSITORY_ASYNCDATABASE_H
+
+#include "QualityControl/DatabaseInterface.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Decorator of a DatabaseInterface which stores MonitorObjects and QualityObjects in the background.
+///
+/// storeMO and storeQO only enqueue the objects, while a pool of worker threads, each with its own backend instance,
+/// performs the actual storage. If a newer version of an object arrives while the previous one is still waiting in the
+/// queue, the previous one is dropped (coalesced). The queue is bounded: once full, the caller is blocked until there is
+/// space (back-pressure) or, if configured so, the new object is dropped. Objects with the same path are never stored
+/// concurrently, so their order is preserved. All the other calls are forwarded synchronously to a dedicated backend.
+class AsyncDatabase : public DatabaseInterface
+{
+ public:
+  using BackendFactory = std::function<std::unique_ptr<DatabaseInterface>()>;
+
+  struct Config {
+    size_t workers = 1;
+    size_t queueCapacity = 1000;
+    bool dropWhenFull = false;
+
+    /// \brief Reads the "asyncStorage*" keys of the "database" configuration structure.
+    static Config fromDatabaseConfig(const std::unordered_map<std::string, std::string>& databaseConfig);
+  };
+
+  struct Statistics {
+    uint64_t enqueued = 0;  ///< objects accepted in the queue
+    uint64_t stored = 0;    ///< objects passed to the backend successfully
+    uint64_t coalesced = 0; ///< queued objects replaced by a newer version before being stored
+    uint64_t dropped = 0;   ///< objects rejected because the queue was full
+    uint64_t failed = 0;    ///< objects for which the backend threw an exception or which it did not store
+    uint64_t skipped = 0;   ///< objects not stored because an object they should follow was not stored, see storeMOAfter
+    double blockedSeconds = 0; ///< total time the callers were blocked by a full queue
+    size_t queueSize = 0;      ///< objects waiting in the queue at the moment of the call
+  };
+
+  AsyncDatabase(BackendFactory backendFactory, Config config);
+  /// Stores everything which is still queued and stops the workers.
+  ~AsyncDatabase() override;
+
+  /// \brief Tells whether the asynchronous storage was requested in the "database" configuration structure.
+  static bool isEnabled(const std::unordered_map<std::string, std::string>& databaseConfig);
+
+  void connect(const std::string& host, const std::string& database, const std::string& username, const std::string& password) override;
+  void connect(const std::unordered_map<std::string, std::string>& config) override;
+
+  // storage
+  void storeMO(std::shared_ptr<const o2::quality_control::core::MonitorObject> mo) override;
+  void storeQO(std::shared_ptr<const o2::quality_control::core::QualityObject> qo) override;
+  void storeQCFC(std::shared_ptr<const o2::quality_control::QualityControlFlagCollection> qcfc) override;
+  void storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, std::map<std::string, std::string> const& metadata,
+                std::string const& detectorName, std::string const& taskName, long from = -1, long to = -1) override;
+
+  // retrieval
+  void* retrieveAny(std::type_info const& tinfo, std::string const& path,
+                    std::map<std::string, std::string> const& metadata, long timestamp = Timestamp::Current,
+                    std::map<std::string, std::string>* headers = nullptr,
+                    const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") override;
+  std::shared_ptr<o2::quality_control::core::MonitorObject> retrieveMO(std::string objectPath, std::string objectName, long timestamp = Timestamp::Current, const core::Activity& activity = {}) override;
+  std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(std::string qoPath, long timestamp = Timestamp::Current, const core::Activity& activity = {}) override;
+  std::shared_ptr<o2::quality_control::QualityControlFlagCollection> retrieveQCFC(const std::string& name, const std::string& detector, int runNumber = 0,
+                                                                                  const std::string& passName = "", const std::string& periodName = "",
+                                                                                  const std::string& provenance = "", long timestamp = Timestamp::Current) override;
+  TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = Timestamp::Current, std::map<std::string, std::string>* headers = nullptr) override;
+  std::string retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata) override;
+
+  void disconnect() override;
+  void prepareTaskDataContainer(std::string taskName) override;
+  std::vector<std::string> getPublishedObjectNames(std::string taskName) override;
+  void truncate(std::string path, std::string objectName) override;
+  void setMaxObjectSize(size_t maxObjectSize) override;
+  core::ValidityInterval getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata = {}) override;
+  /// \brief Sums the statistics of all the backends.
+  CompressionStatistics getCompressionStatistics() const override;
+
+  /// \brief Enqueues the MO so that it is stored only after the objects with the given paths which are already queued.
+  ///
+  /// It allows to publish an object which tells that others have been stored, e.g. a publication marker.
+  /// Thus, the MO is not stored at all if the latest version of any of these objects could not be stored.
+  void storeMOAfter(std::shared_ptr<const o2::quality_control::core::MonitorObject> mo, std::vector<std::string> precedingPaths);
+
+  /// \brief Blocks until all the queued objects have been stored (or failed to be).
+  void flush();
+
+  Statistics getStatistics() const;
+
+ private:
+  struct Job {
+    std::shared_ptr<const core::MonitorObject> mo;
+    std::shared_ptr<const core::QualityObject> qo;
+    std::vector<std::string> precedingPaths; ///< the job waits until these paths are neither queued nor being stored
+  };
+
+  bool isReady(const std::string& path) const;
+
+  void enqueue(const std::string& path, Job&& job);
+  void runWorker(size_t workerId);
+
+  Config mConfig;
+  std::unique_ptr<DatabaseInterface> mSyncBackend;               ///< used for all the calls made on the caller thread
+  std::vector<std::unique_ptr<DatabaseInterface>> mWorkerBackends; ///< one per worker, backends are not thread-safe
+  std::vector<std::thread> mWorkers;
+
+  mutable std::mutex mMutex;
+  std::condition_variable mJobAvailable;
+  std::condition_variable mSpaceAvailable;
+  std::condition_variable mAllDone;
+  std::deque<std::string> mQueueOrder;              ///< paths in the order of their first enqueueing
+  std::unordered_map<std::string, Job> mPendingJobs; ///< the latest version of each queued path
+  std::unordered_set<std::string> mPathsInFlight;    ///< paths which are being stored at the moment
+  std::unordered_set<std::string> mFailedPaths;      ///< paths whose latest version could not be stored
+  bool mStopping = false;
+
+  Statistics mStatistics;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_ASYNCDATABASE_H
@@ -20,8 +20,12 @@
 #include "QualityControl/DatabaseInterface.h"
 #include <Common/Timer.h>
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <utility>
+
+class TClass;
 
 namespace o2::ccdb
 {
@@ -31,6 +35,8 @@ class CcdbApi;
 namespace o2::quality_control::repository
 {
 
+class ObjectCache;
+
 /*
  * Notes (also concerning the underlying CcdbApi)
  * - having 1 file per object per version server-side might lead to a tremendous number of files.
@@ -127,9 +133,46 @@ class CcdbDatabase : public DatabaseInterface
 
   void setMaxObjectSize(size_t maxObjectSize) override;
 
+  /// \brief Sets the compression of the stored MonitorObjects and objects stored with storeAny.
+  /// \param settings ROOT compression settings (100 * algorithm + level), 0 for no compression
+  /// or -1 to keep the default of the CCDB API.
+  void setCompressionSettings(int settings) { mCompressionSettings = settings; }
+  int getCompressionSettings() const { return mCompressionSettings; }
+  CompressionStatistics getCompressionStatistics() const override;
+
+  /// \brief Converts the value of the "compression" key of the database configuration to ROOT compression settings.
+  ///
+  /// Accepts "default" (or an empty string), "none" and "<algorithm>[:<level>]", where the algorithm is one of
+  /// "zlib", "lzma", "lz4" and "zstd" and the level is between 1 and 9. Throws if the value is not valid.
+  static int parseCompressionSettings(const std::string& value);
+
+  /// \brief Sets for how long the storage is suspended after a failure, 60 seconds by default.
+  void setFailureDelay(int seconds) { mFailureDelay = seconds; }
+
+  static constexpr int storeObjectTooBig = -1;      ///< the object is bigger than the maximum object size, as returned by CcdbApi
+  static constexpr int storeNotAttempted = -100;    ///< the storage is suspended following a failure
+  static constexpr int storeInvalidValidity = -101; ///< the validity start is after its end
+  /// \brief Returns the result of the last storeMO(), storeQO() or storeAny() call which did not throw.
+  ///
+  /// 0 means that the object was stored, storeObjectTooBig, storeNotAttempted and storeInvalidValidity are explained
+  /// above, while the other values are failures to reach the database (-2 for a curl initialization error, positive for
+  /// curl errors), after which the storage is suspended for the failure delay.
+  int getLastStoreResult() const { return mLastStoreResult; }
+  bool isLastObjectStored() const override { return mLastStoreResult == 0; }
+
  private:
   void init();
 
+  /// \brief Streams the object into a file image compressed with mCompressionSettings and stores it,
+  /// as CcdbApi::storeAsTFile_impl would do with the default compression.
+  int storeCompressed(const void* obj, const TClass* cl, const std::string& path, const std::map<std::string, std::string>& metadata, long from, long to);
+
+  /// \brief Returns the validity and the unique ID of the latest version of the object.
+  std::pair<core::ValidityInterval, std::string> getLatestObjectVersion(const std::string& path, const std::map<std::string, std::string>& metadata);
+
+  /// \brief Creates the key of an object version in the ObjectCache
+  static std::string createCacheKey(const std::string& path, const core::ValidityInterval& validity, std::string id);
+
   /**
    * Return the listing of folder and/or objects in the subpath.
    * @param subpath The folder we want to list the children of.
@@ -167,7 +210,16 @@ class CcdbDatabase : public DatabaseInterface
   size_t mMaxObjectSize = 2097152; // 2MB by default
   int mFailureDelay = 60;          // 60 seconds delay between attempts to store things in the database
   bool mDatabaseFailure = false;
+  int mLastStoreResult = 0;
   AliceO2::Common::Timer mFailureTimer;
+  std::shared_ptr<ObjectCache> mObjectCache; // only if enabled in the configuration
+  int mCompressionSettings = -1;              // -1 means the default of CcdbApi
+
+  // read by getCompressionStatistics(), possibly from another thread
+  std::atomic<uint64_t> mCompressedObjects{ 0 };
+  std::atomic<uint64_t> mRawBytes{ 0 };
+  std::atomic<uint64_t> mCompressedBytes{ 0 };
+  std::atomic<uint64_t> mCompressionNanoseconds{ 0 };
 };
 
 } // namespace o2::quality_control::repository
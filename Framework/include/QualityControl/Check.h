@@ -70,6 +70,25 @@ class Check
 
   core::QualityObjectsType check(std::map<std::string, std::shared_ptr<o2::quality_control::core::MonitorObject>>& moMap);
 
+  /**
+   * \brief Select the MOs needed by this Check and group them in maps which should be checked separately.
+   *
+   * check() is equivalent to calling checkSingle() on each of the returned maps.
+   * With the OnEachSeparately policy there is one map per MO, otherwise there is only one map.
+   */
+  std::vector<std::map<std::string, std::shared_ptr<core::MonitorObject>>> prepareMapsToCheck(std::map<std::string, std::shared_ptr<core::MonitorObject>>& moMap) const;
+  /**
+   * \brief Run the user check and, unless disabled, beautify on one map returned by prepareMapsToCheck().
+   * @return The resulting QualityObject or nullptr if the check could not be performed.
+   */
+  std::shared_ptr<core::QualityObject> checkSingle(std::map<std::string, std::shared_ptr<core::MonitorObject>>& moMapToCheck, bool withBeautify = true);
+  /// \brief Tells whether checkSingle() without beautify may be called concurrently for different maps of this Check.
+  bool isParallelEvaluationAllowed() const;
+  /// \brief Run the user beautify on the MOs of the map, if allowed in the configuration.
+  ///
+  /// Beautify modifies the MOs which other Checks might be reading, so it should not be run concurrently with other Checks.
+  void beautify(std::map<std::string, std::shared_ptr<core::MonitorObject>>& moMap, const core::Quality& quality);
+
   const std::string& getName() const { return mCheckConfig.name; };
   o2::framework::OutputSpec getOutputSpec() const { return mCheckConfig.qoSpec; };
   o2::framework::Inputs getInputs() const { return mCheckConfig.inputSpecs; };
@@ -100,8 +119,6 @@ class Check
   }
 
  private:
-  void beautify(std::map<std::string, std::shared_ptr<core::MonitorObject>>& moMap, const core::Quality& quality);
-
   CheckConfig mCheckConfig;
   CheckInterface* mCheckInterface = nullptr;
 };
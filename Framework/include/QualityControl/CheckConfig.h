@@ -41,6 +41,7 @@ struct CheckConfig {
   framework::Inputs inputSpecs{};
   framework::OutputSpec qoSpec{ "XXX", "INVALID" };
   std::string conditionUrl{};
+  bool parallelEvaluation = false; // OnEachSeparately: the MOs can be checked concurrently with the same CheckInterface
 };
 
 } // namespace o2::quality_control::checker
@@ -23,6 +23,7 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
 #include <unordered_set>
 // O2
@@ -40,11 +41,13 @@
 namespace o2::quality_control::core
 {
 class ServiceDiscovery;
+class ThreadPool;
 }
 
 namespace o2::quality_control::repository
 {
 class DatabaseInterface;
+class AsyncDatabase;
 }
 
 namespace o2::framework
@@ -145,6 +148,14 @@ class CheckRunner : public framework::Task
    */
   QualityObjectsType check();
 
+  /**
+   * \brief Evaluate the Checks in the thread pool.
+   *
+   * Independent Checks are evaluated concurrently, as well as the MOs of the OnEachSeparately Checks which allow it.
+   * The QualityObjects are returned in the same order as in the sequential mode.
+   */
+  QualityObjectsType checkInParallel();
+
   /**
    * \brief Store the QualityObjects in the database.
    *
@@ -159,6 +170,16 @@ class CheckRunner : public framework::Task
    */
   void store(std::vector<std::shared_ptr<MonitorObject>>& monitorObjects, long validFrom);
 
+  /**
+   * \brief Store a publication marker for each task, after its MonitorObjects.
+   *
+   * Post-processing can check that a marker newer than an MO exists to know that the other MOs of its task are stored too.
+   * Thus, no marker is stored for the tasks in incompleteTasks, i.e. those with MOs which could not be stored.
+   */
+  void storePublicationMarkers(const std::vector<std::shared_ptr<MonitorObject>>& monitorObjects, const std::set<std::string>& incompleteTasks);
+  /// \brief The QCDB directory of the task which produced the MO, identifying a publication.
+  static std::string publicationDirectory(const MonitorObject& mo);
+
   /**
    * \brief Send the QualityObjects on the DataProcessor output channel.
    */
@@ -218,9 +239,11 @@ class CheckRunner : public framework::Task
   std::shared_ptr<Activity> mActivity; // shareable with the Checks
   CheckRunnerConfig mConfig;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
+  std::shared_ptr<o2::quality_control::repository::AsyncDatabase> mAsyncDatabase; // same as mDatabase if asynchronous storage is enabled
   std::unordered_set<std::string> mInputStoreSet;
   std::vector<std::shared_ptr<MonitorObject>> mMonitorObjectStoreVector;
   UpdatePolicyManager updatePolicyManager;
+  std::unique_ptr<core::ThreadPool> mThreadPool; // only if checks should be evaluated in parallel
   bool mReceivedEOS = false;
 
   // DPL
@@ -33,6 +33,8 @@ struct CheckRunnerConfig {
   core::LogDiscardParameters infologgerDiscardParameters;
   core::Activity fallbackActivity;
   framework::Options options{};
+  size_t threads = 1;              // the checks are evaluated in a thread pool if larger than 1
+  bool publicationMarkers = false; // a marker is stored after the MOs of each task, see RepoPathUtils::publicationMarkerName
 };
 
 } // namespace o2::quality_control::checker
@@ -53,6 +53,7 @@ struct CheckSpec {
   // advanced
   bool active = true;
   bool exportToBookkeeping = false;
+  bool parallelEvaluation = false;
   core::CustomParameters customParameters;
 };
 
@@ -44,6 +44,8 @@ struct CommonSpec {
   LogDiscardParameters infologgerDiscardParameters;
   double postprocessingPeriod = 30.0;
   std::string bookkeepingUrl;
+  size_t checkRunnerThreads = 1;
+  bool checkRunnerPublicationMarkers = false;
 };
 
 } // namespace o2::quality_control::core
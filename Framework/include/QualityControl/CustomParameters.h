@@ -127,6 +127,16 @@ class CustomParameters
 
   std::string atOrDefaultValue(const std::string& key, std::string defaultValue, const Activity& activity) const;
 
+  /**
+   * Return all the parameters (key-value pairs) which apply to the given runType and beamType, after the substitutions
+   * with "default" done by atOptional: a value for the runType and beamType overrides the one for the runType, which
+   * overrides the one for the beamType, which overrides the default one.
+   * @param runType
+   * @param beamType
+   * @return a map of the key-value pairs, empty if there is none
+   */
+  std::unordered_map<std::string, std::string> getAllResolved(const std::string& runType, const std::string& beamType) const;
+
   /**
    * Returns the number of items found for the provided key, beamType and runType. It can only be either 0 or 1.
    * @param key
@@ -182,6 +192,7 @@ class CustomParameters
   void populateCustomParameters(const boost::property_tree::ptree& paramsTree);
 
  private:
+  static const std::string sDefault;
   CustomParametersType mCustomParameters;
 };
 
@@ -17,6 +17,7 @@
 #ifndef QC_REPOSITORY_DATABASEINTERFACE_H
 #define QC_REPOSITORY_DATABASEINTERFACE_H
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -45,6 +46,14 @@ class DatabaseInterface
     Latest = 0
   };
 
+  /// \brief Sizes of the stored objects before and after compression, with the time spent to stream and compress them.
+  struct CompressionStatistics {
+    uint64_t objects = 0;         ///< objects stored with explicit compression settings
+    uint64_t rawBytes = 0;        ///< size of the streamed objects before compression
+    uint64_t compressedBytes = 0; ///< size of the files sent to the repository
+    double seconds = 0;           ///< time spent streaming and compressing the objects
+  };
+
   /// Default constructor
   DatabaseInterface() = default;
   /// Destructor
@@ -214,6 +223,14 @@ class DatabaseInterface
    * @return validity of the latest matching object
    */
   virtual core::ValidityInterval getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata = {}) = 0;
+
+  /// \brief Returns the totals since the creation of the object. Empty if the backend does not compress the objects itself.
+  /// Can be called from another thread than the one storing the objects.
+  virtual CompressionStatistics getCompressionStatistics() const { return {}; }
+
+  /// \brief Tells whether the object given to the last storeMO(), storeQO() or storeAny() call which did not throw was stored.
+  /// The backends which can skip an object without throwing, e.g. because of its size, should override it.
+  virtual bool isLastObjectStored() const { return true; }
 };
 
 } // namespace o2::quality_control::repository
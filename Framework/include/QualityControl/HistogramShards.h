@@ -0,0 +1,94 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    HistogramShards.h
+///
+
+#ifndef QUALITYCONTROL_HISTOGRAMSHARDS_H
+#define QUALITYCONTROL_HISTOGRAMSHARDS_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class TH1;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Per-thread copies of published histograms, which allow to fill them in parallel without locking.
+///
+/// A task registers the histograms it wants to fill from several threads (e.g. in an OpenMP loop or a pool of
+/// tasks), each thread fills the copies belonging to its shard and the copies are added to the published histograms
+/// when merge() is called, e.g. after the parallel section or in endOfCycle(). The published histograms should not
+/// be filled directly in between.
+///
+/// With one shard, no copies are created and get() returns the published histogram, so the serial case has no
+/// overhead. The histograms should be created with a fixed binning, the automatic rebinning is not supported.
+///
+/// Example:
+/// \code
+/// mShards.setNumberOfShards(mNThreads);
+/// mShards.add(mHistogram);
+/// ...
+/// #pragma omp parallel for
+/// for (int i = 0; i < n; i++) {
+///   mShards.get(mHistogram, omp_get_thread_num())->Fill(values[i]);
+/// }
+/// mShards.merge();
+/// \endcode
+class HistogramShards
+{
+ public:
+  explicit HistogramShards(size_t shards = 1);
+  ~HistogramShards();
+
+  /// \brief Sets the number of shards, i.e. the maximum number of threads filling the histograms concurrently.
+  /// The copies which were not merged are lost. Not thread-safe.
+  void setNumberOfShards(size_t shards);
+  size_t getNumberOfShards() const { return mShards.size(); }
+
+  /// \brief Registers a histogram, which creates an empty copy of it in each shard. Not thread-safe.
+  void add(TH1* histogram);
+  /// \brief Returns the copy of the histogram which belongs to the shard, or the histogram itself if there is one shard.
+  ///
+  /// It can be called concurrently, as long as each shard is used by one thread at a time.
+  /// Throws if the histogram was not registered or the shard does not exist.
+  template <typename T>
+  T* get(T* histogram, size_t shard)
+  {
+    return static_cast<T*>(getImpl(histogram, shard));
+  }
+  /// \brief Adds the contents of the copies to the published histograms and resets the copies. Not thread-safe.
+  void merge();
+  /// \brief Resets the copies without merging them, e.g. when the published histograms are reset. Not thread-safe.
+  void reset();
+  /// \brief Forgets all the registered histograms. Not thread-safe.
+  void clear();
+
+ private:
+  struct Copy {
+    std::unique_ptr<TH1> histogram;
+    bool filled = false; // set by get(), so we merge only the copies which could have changed
+  };
+
+  TH1* getImpl(TH1* histogram, size_t shard);
+  std::unique_ptr<TH1> createCopy(const TH1* histogram) const;
+
+  std::vector<TH1*> mHistograms;
+  std::unordered_map<const TH1*, size_t> mIndices;
+  std::vector<std::vector<Copy>> mShards; // [shard][histogram index]
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QUALITYCONTROL_HISTOGRAMSHARDS_H
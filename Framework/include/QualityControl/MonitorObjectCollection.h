@@ -18,6 +18,7 @@
 #define QUALITYCONTROL_MONITOROBJECTCOLLECTION_H
 
 #include <string>
+#include <unordered_map>
 #include <TObjArray.h>
 #include <Mergers/MergeInterface.h>
 
@@ -42,10 +43,28 @@ class MonitorObjectCollection : public TObjArray, public mergers::MergeInterface
 
   MergeInterface* cloneMovingWindow() const override;
 
+  /// \brief Finds an object by name in constant time.
+  ///
+  /// The objects are looked up in a name->index map, which is kept up to date when objects are added with Add()/AddLast()
+  /// and rebuilt lazily after any other kind of modification of the collection. A name which is not found in the index
+  /// triggers a rebuild as well, since the objects could have been renamed after they were added.
+  TObject* FindObject(const char* name) const override;
+  using TObjArray::FindObject;
+
+  void AddLast(TObject* obj) override;
+  void AddFirst(TObject* obj) override;
+  void AddAt(TObject* obj, Int_t idx) override;
+  void AddAtAndExpand(TObject* obj, Int_t idx) override;
+
  private:
+  void rebuildIndex() const;
+
   std::string mDetector = "TST";
   std::string mTaskName = "Test";
 
+  mutable std::unordered_map<std::string, Int_t> mIndex; //! the first occurrence of each name
+  mutable Int_t mIndexedEntries = 0;                      //! value of GetEntriesFast() when the index was last valid, -1 if it is invalid
+
   ClassDefOverride(MonitorObjectCollection, 2);
 };
 
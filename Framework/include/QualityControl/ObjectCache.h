@@ -0,0 +1,112 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ObjectCache.h
+///
+
+#ifndef QC_REPOSITORY_OBJECTCACHE_H
+#define QC_REPOSITORY_OBJECTCACHE_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+class TObject;
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Two-tier cache of immutable object versions retrieved from the QCDB.
+///
+/// The entries are identified by a key which must designate one version of an object, e.g. its path and its unique ID
+/// in the database. The first tier keeps a number of deserialized objects in memory, the second tier keeps serialized
+/// objects in a local directory, up to a given total size. Both tiers evict the least recently used entries first.
+/// The same directory can be used by several processes, as the files are written atomically.
+/// Cached objects are returned as copies, the caller takes their ownership.
+class ObjectCache
+{
+ public:
+  struct Config {
+    size_t memoryEntries = 100;              ///< 0 disables the memory tier
+    std::string directory;                   ///< empty disables the disk tier
+    uint64_t maxDiskBytes = 1024ull << 20;   ///< the least recently used files are removed above this size
+
+    /// \brief Reads the "objectCache*" keys of the "database" configuration structure.
+    static Config fromDatabaseConfig(const std::unordered_map<std::string, std::string>& databaseConfig);
+  };
+
+  struct Statistics {
+    uint64_t memoryHits = 0;
+    uint64_t diskHits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0; ///< files removed from the disk tier
+    uint64_t diskBytes = 0; ///< current size of the disk tier
+  };
+
+  struct Entry {
+    std::unique_ptr<TObject> object;
+    std::map<std::string, std::string> headers;
+  };
+
+  explicit ObjectCache(Config config);
+  ~ObjectCache();
+
+  /// \brief Returns true if the database configuration asks for an object cache ("objectCache": "true")
+  static bool isEnabled(const std::unordered_map<std::string, std::string>& databaseConfig);
+
+  /// \brief Returns a cache shared by all the users in this process which use the same directory.
+  ///
+  /// The first caller decides about the sizes of the cache.
+  static std::shared_ptr<ObjectCache> getShared(const Config& config);
+
+  /// \brief Returns a copy of the cached object and its headers, or nullopt if the key is not in the cache.
+  std::optional<Entry> get(const std::string& key);
+  /// \brief Stores a copy of the object and its headers under the key
+  void put(const std::string& key, const TObject& object, const std::map<std::string, std::string>& headers);
+
+  Statistics getStatistics() const;
+
+ private:
+  struct MemoryEntry {
+    std::string key;
+    std::shared_ptr<const TObject> object;
+    std::map<std::string, std::string> headers;
+  };
+  struct DiskEntry {
+    std::string fileName;
+    uint64_t size;
+  };
+
+  void putInMemory(const std::string& key, std::shared_ptr<const TObject> object, const std::map<std::string, std::string>& headers);
+  std::optional<Entry> readFromDisk(const std::string& key);
+  void writeToDisk(const std::string& key, const TObject& object, const std::map<std::string, std::string>& headers);
+  void scanDirectory();
+  void evictFromDisk();
+  static std::string fileNameForKey(const std::string& key);
+
+  Config mConfig;
+  mutable std::mutex mMutex;
+  std::list<MemoryEntry> mMemoryEntries; // the most recently used first
+  std::unordered_map<std::string, std::list<MemoryEntry>::iterator> mMemoryIndex;
+  std::list<DiskEntry> mDiskEntries; // the most recently used first
+  std::unordered_map<std::string, std::list<DiskEntry>::iterator> mDiskIndex;
+  Statistics mStatistics;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_OBJECTCACHE_H
@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    ObjectListingPoller.h
+///
+
+#ifndef QUALITYCONTROL_OBJECTLISTINGPOLLER_H
+#define QUALITYCONTROL_OBJECTLISTINGPOLLER_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <boost/property_tree/ptree.hpp>
+
+namespace o2::quality_control::postprocessing
+{
+
+/// \brief Shares the listings of the latest object versions between the triggers which watch a database.
+///
+/// The objects are grouped by their parent directory and the metadata filter, so that one listing of the latest
+/// versions of the objects watched in a directory serves all of them. Only the watched objects are listed, not the
+/// whole directory. A listing is reused as long as it is not older than the maximum age requested by the caller.
+/// The directory is listed again when an object is requested for the first time.
+class ObjectListingPoller
+{
+ public:
+  /// Returns the listing ("objects" array of the CCDB JSON listing) of the latest objects matching the path pattern
+  /// and the metadata. It should throw if the listing could not be obtained.
+  using ListingFcn = std::function<boost::property_tree::ptree(const std::string& pathPattern, const std::map<std::string, std::string>& metadata)>;
+
+  struct Statistics {
+    uint64_t listings = 0;
+    uint64_t failedListings = 0;
+    uint64_t requests = 0; ///< the number of getLatest() calls
+    double totalListingSeconds = 0;
+    double maxListingSeconds = 0;
+  };
+
+  explicit ObjectListingPoller(ListingFcn listingFcn, std::string databaseUrl = "");
+  ~ObjectListingPoller();
+
+  /// \brief Returns a poller shared by all the triggers in this process which use the CCDB at this URL.
+  static std::shared_ptr<ObjectListingPoller> getShared(const std::string& databaseUrl);
+
+  /// \brief Returns the listing entry of the latest version of the object.
+  ///
+  /// The directory of the object is listed again if the previous listing is older than maxAge.
+  /// \return the listing entry of the object, an empty ptree if there is no such object yet,
+  ///         nullopt if the listing failed.
+  std::optional<boost::property_tree::ptree> getLatest(const std::string& objectPath, const std::map<std::string, std::string>& metadata,
+                                                       std::chrono::steady_clock::duration maxAge);
+
+  Statistics getStatistics() const;
+
+ private:
+  struct Group {
+    std::string pathPattern;
+    std::set<std::string> objectNames; // the names of the requested objects in the directory
+    std::map<std::string, std::string> metadata;
+    std::optional<std::chrono::steady_clock::time_point> lastListing;
+    bool listingValid = false;
+    std::unordered_map<std::string, boost::property_tree::ptree> latestObjects; // path -> listing entry
+  };
+
+  void list(Group& group);
+
+  ListingFcn mListingFcn;
+  std::string mDatabaseUrl;
+  mutable std::mutex mMutex;
+  std::map<std::pair<std::string, std::map<std::string, std::string>>, Group> mGroups;
+  Statistics mStatistics;
+};
+
+} // namespace o2::quality_control::postprocessing
+
+#endif // QUALITYCONTROL_OBJECTLISTINGPOLLER_H
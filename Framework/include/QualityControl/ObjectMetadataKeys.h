@@ -28,6 +28,8 @@ constexpr auto created = "Created";
 constexpr auto md5sum = "Content-MD5";
 constexpr auto objectType = "ObjectType";
 constexpr auto lastModified = "lastModified";
+constexpr auto id = "id";     // in listings
+constexpr auto etag = "ETag"; // in headers, the same ID but quoted
 // General QC framework
 constexpr auto qcVersion = "qc_version";
 constexpr auto qcDetectorCode = "qc_detector_name";
@@ -37,6 +39,7 @@ constexpr auto qcQuality = "qc_quality";
 constexpr auto qcCheckName = "qc_check_name";
 constexpr auto qcQCFCName = "qc_qcfc_name";
 constexpr auto qcAdjustableEOV = "adjustableEOV"; // this is a keyword for the CCDB
+constexpr auto qcPublishedObjects = "qc_published_objects"; // number of MOs covered by a publication marker
 // QC Activity
 constexpr auto runType = "RunType";
 constexpr auto runNumber = "RunNumber";
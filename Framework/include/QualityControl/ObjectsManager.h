@@ -27,6 +27,7 @@
 #include <string>
 #include <memory>
 #include <type_traits>
+#include <unordered_map>
 
 class TObject;
 
@@ -128,6 +129,7 @@ class ObjectsManager
 
   /**
    * Returns the published MonitorObject specified by its name
+   * The objects are indexed by the name they had when they started to be published.
    * @param objectName The name of the object to find.
    * @return A pointer to the MonitorObject.
    * @throw ObjectNotFoundError if the object is not found.
@@ -136,6 +138,17 @@ class ObjectsManager
 
   MonitorObjectCollection* getNonOwningArray() const;
 
+  /**
+   * \brief Returns the MonitorObjects which were modified since they were last reset.
+   * It is meant for tasks which are reset after each cycle, so that each publication is a delta. Histograms are
+   * considered as modified if they have any entries, i.e. empty histograms are left out, while the objects which are
+   * not histograms are always returned. Comparing the histograms with their previous publication instead would drop
+   * the deltas which happen to be identical to the previous ones.
+   * The collection is created by new and must be cleaned up by the caller. It does not own the objects.
+   * @param includeAll if true, all the objects are returned.
+   */
+  MonitorObjectCollection* getNonOwningArrayOfUpdatedObjects(bool includeAll = false);
+
   /**
    * \brief Add metadata to a MonitorObject.
    * Add a metadata pair to a MonitorObject. This is propagated to the database.
@@ -215,6 +228,11 @@ class ObjectsManager
    */
   void removeAllFromServiceDiscovery();
 
+  /**
+   * \brief Returns the ServiceDiscovery, nullptr if it is disabled.
+   */
+  const ServiceDiscovery* getServiceDiscovery() const;
+
   /**
    * \brief Sets the validity interval of all registered objects.
    */
@@ -232,7 +250,23 @@ class ObjectsManager
   const std::vector<std::string>& getMovingWindowsList() const;
 
  private:
+  struct RegisteredObject {
+    MonitorObject* mo = nullptr;
+    std::string name; // the name of the object when it was registered
+    int slot = 0;     // the position of the MO in mMonitorObjects
+  };
+  using Registry = std::unordered_map<const TObject*, RegisteredObject>;
+
+  /// \brief Removes the MO from the registry and deletes it. Its slot in mMonitorObjects is left empty until compact().
+  void unregister(Registry::iterator entry);
+  /// \brief Removes the empty slots left by the unregistered objects.
+  void compact();
+
+  // May contain empty slots, which are skipped when iterating. They are removed once they outnumber the objects,
+  // before accessing the objects by index and in the published copies, so removing an object is done in constant time.
   std::unique_ptr<MonitorObjectCollection> mMonitorObjects;
+  Registry mObjectsByAddress;                                     // the published objects by the address of the observed object
+  std::unordered_map<std::string, const TObject*> mObjectsByName; // the addresses of the published objects by name
   std::map<MonitorObject*, PublicationPolicy> mPublicationPoliciesForMOs;
   std::string mTaskName;
   std::string mTaskClass;
@@ -243,6 +277,8 @@ class ObjectsManager
   std::vector<std::string> mMovingWindowsList;
 
   void startPublishingImpl(TObject* obj, PublicationPolicy, bool ignoreMergeableWarning);
+  /// \brief Returns true if the object is a histogram without any entries
+  static bool isEmptyHistogram(const MonitorObject* mo);
 };
 
 } // namespace o2::quality_control::core
@@ -49,6 +49,7 @@ struct PostProcessingConfig {
   std::string kafkaTopic;
   core::Activity activity;
   bool matchAnyRunNumber = false;
+  double newObjectPollingPeriodSeconds = 1.0; // listings for NewObject triggers are reused if they are not older
   bool critical;
   core::CustomParameters customParameters;
 };
@@ -126,6 +126,9 @@ class RepoPathUtils
    */
   static std::string getQcfcPath(const QualityControlFlagCollection* qcfc);
 
+  /// Name of the object which CheckRunners store after all the MOs of a task in a given cycle, see also getMoPath()
+  static constexpr auto publicationMarkerName = "qc_publication_marker";
+
   static constexpr auto allowedProvenancesMessage = R"(Allowed provenances are "qc" (real data processed synchronously), "qc_async" (real data processed asynchronously) and "qc_mc" (simulated data).)";
   static bool isProvenanceAllowed(const std::string& provenance);
 
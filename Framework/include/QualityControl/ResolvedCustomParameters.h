@@ -0,0 +1,166 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ResolvedCustomParameters.h
+///
+
+#ifndef QC_RESOLVED_CUSTOM_PARAMETERS_H
+#define QC_RESOLVED_CUSTOM_PARAMETERS_H
+
+#include "QualityControl/Activity.h"
+#include "QualityControl/CustomParameters.h"
+
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/**
+ * The custom parameters which apply to one run type and beam type, with their values already parsed.
+ *
+ * CustomParameters looks up the run type, the beam type and the key in nested maps with substitutions by "default",
+ * and returns strings which the user code has to convert. This class does it once, typically at the start of an
+ * activity, so that the accessors used in monitorData() or check() are one hash lookup and no conversion.
+ * Numbers, booleans and comma-separated lists are parsed when resolving, a value which cannot be parsed as the
+ * requested type behaves as a missing one.
+ *
+ * Example:
+ *   ResolvedCustomParameters params(mCustomParameters, activity);
+ *   auto threshold = params.get<double>("threshold", 0.5);
+ *   auto channels = params.get<std::vector<int>>("channels").value_or(std::vector<int>{});
+ */
+class ResolvedCustomParameters
+{
+ public:
+  enum class Type {
+    String,
+    Bool,
+    Integer,
+    Double,
+    IntegerList,
+    DoubleList,
+    StringList
+  };
+
+  /// A parameter which the user code expects, used to validate the configuration
+  struct Expected {
+    std::string key;
+    Type type = Type::String;
+  };
+
+  struct ValidationReport {
+    /// keys in the configuration which the user code does not expect, most likely typos
+    std::vector<std::string> unknownKeys;
+    /// "key: reason" for the values which cannot be parsed as the expected type
+    std::vector<std::string> malformedKeys;
+    bool empty() const { return unknownKeys.empty() && malformedKeys.empty(); }
+  };
+
+  ResolvedCustomParameters() = default;
+  ResolvedCustomParameters(const CustomParameters& customParameters, const std::string& runType, const std::string& beamType);
+  ResolvedCustomParameters(const CustomParameters& customParameters, const Activity& activity);
+
+  bool contains(const std::string& key) const { return mValues.count(key) > 0; }
+  size_t size() const { return mValues.size(); }
+  const std::string& getRunType() const { return mRunType; }
+  const std::string& getBeamType() const { return mBeamType; }
+
+  /**
+   * Returns the value of the key converted to T, which can be std::string, bool, an integral or floating point type,
+   * or a std::vector of one of those (other than bool), given as a comma-separated list.
+   * @return the value, or empty if the key is not there or its value cannot be converted to T
+   */
+  template <typename T>
+  std::optional<T> get(const std::string& key) const;
+
+  /// Returns the value of the key converted to T, or defaultValue if the key is not there or cannot be converted
+  template <typename T>
+  T get(const std::string& key, T defaultValue) const
+  {
+    auto value = get<T>(key);
+    return value.has_value() ? std::move(value.value()) : std::move(defaultValue);
+  }
+
+  /**
+   * Checks the parameters against the ones expected by the user code.
+   * @param expected the parameters used by the user code
+   * @return the keys which are not expected and the values which do not match the expected type
+   */
+  ValidationReport validate(const std::vector<Expected>& expected) const;
+
+  static std::string typeToString(Type type);
+
+ private:
+  struct Value {
+    std::string raw;
+    std::optional<bool> boolean;
+    std::optional<long long> integer;
+    std::optional<double> number;
+    std::vector<std::string> elements;
+    std::optional<std::vector<long long>> integers;
+    std::optional<std::vector<double>> numbers;
+  };
+
+  static Value parse(const std::string& raw);
+  const Value* find(const std::string& key) const;
+
+  std::string mRunType;
+  std::string mBeamType;
+  std::unordered_map<std::string, Value> mValues;
+};
+
+template <typename T>
+std::optional<T> ResolvedCustomParameters::get(const std::string& key) const
+{
+  const auto* value = find(key);
+  if (value == nullptr) {
+    return std::nullopt;
+  }
+  if constexpr (std::is_same_v<T, std::string>) {
+    return value->raw;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return value->boolean;
+  } else if constexpr (std::is_integral_v<T>) {
+    if (!value->integer.has_value()) {
+      return std::nullopt;
+    }
+    return static_cast<T>(value->integer.value());
+  } else if constexpr (std::is_floating_point_v<T>) {
+    if (!value->number.has_value()) {
+      return std::nullopt;
+    }
+    return static_cast<T>(value->number.value());
+  } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+    return value->elements;
+  } else if constexpr (std::is_same_v<T, std::vector<typename T::value_type>> && std::is_integral_v<typename T::value_type>) {
+    static_assert(!std::is_same_v<typename T::value_type, bool>, "lists of booleans are not supported");
+    if (!value->integers.has_value()) {
+      return std::nullopt;
+    }
+    return T(value->integers->begin(), value->integers->end());
+  } else if constexpr (std::is_same_v<T, std::vector<typename T::value_type>> && std::is_floating_point_v<typename T::value_type>) {
+    if (!value->numbers.has_value()) {
+      return std::nullopt;
+    }
+    return T(value->numbers->begin(), value->numbers->end());
+  } else {
+    static_assert(!std::is_same_v<T, T>, "type not supported by ResolvedCustomParameters::get");
+  }
+}
+
+} // namespace o2::quality_control::core
+
+#endif // QC_RESOLVED_CUSTOM_PARAMETERS_H
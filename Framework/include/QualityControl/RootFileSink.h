@@ -21,18 +21,38 @@
 #include <Framework/CompletionPolicy.h>
 #include <Framework/DataProcessorLabel.h>
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
 namespace o2::quality_control::core
 {
 
+class MonitorObjectCollection;
+
 /// \brief A Data Processor which stores MonitorObjectCollections in a specified file
+///
+/// The collections are written by a background thread, so the file I/O does not block the processing of the next
+/// inputs. Integrated collections of the same task received before the writer picks them up are merged in memory
+/// and written once. If the queue is full, run() waits until there is space. Everything is written at the end of stream.
 class RootFileSink : public framework::Task
 {
  public:
-  explicit RootFileSink(std::string filePath);
-  ~RootFileSink() override = default;
+  explicit RootFileSink(std::string filePath, size_t queueCapacity = 100);
+  /// Writes what is still queued and stops the writer thread.
+  ~RootFileSink() override;
 
   void init(framework::InitContext& ictx) override;
   void run(framework::ProcessingContext& pctx) override;
+  void endOfStream(framework::EndOfStreamContext& eosContext) override;
+  void stop() override;
+
+  /// \brief Blocks until all the received collections have been written to the file.
+  void flush();
 
   static framework::DataProcessorLabel getLabel()
   {
@@ -42,9 +62,29 @@ class RootFileSink : public framework::Task
   static void customizeInfrastructure(std::vector<framework::CompletionPolicy>& policies);
 
  private:
+  struct Job {
+    std::unique_ptr<MonitorObjectCollection> moc;
+    bool integral = true; ///< false for moving windows
+  };
+
+  void enqueue(std::unique_ptr<MonitorObjectCollection> moc, bool integral);
+  void runWriter();
+  void write(std::deque<Job>& jobs);
+
   std::string mFilePath;
+  size_t mQueueCapacity;
+
+  std::thread mWriter;
+  std::mutex mMutex;
+  std::condition_variable mJobAvailable;
+  std::condition_variable mSpaceAvailable;
+  std::condition_variable mAllDone;
+  std::deque<Job> mQueue;
+  std::unordered_map<std::string, MonitorObjectCollection*> mQueuedIntegrals; ///< integrals in mQueue, by detector/task
+  bool mWriting = false;
+  bool mStopping = false;
 };
 
 } // namespace o2::quality_control::core
 
-#endif //QUALITYCONTROL_ROOTFILESINK_H
\ No newline at end of file
+#endif //QUALITYCONTROL_ROOTFILESINK_H
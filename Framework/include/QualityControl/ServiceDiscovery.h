@@ -17,7 +17,9 @@
 #define QC_SERVICEDISCOVERY_H
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>
 #include <mutex>
@@ -25,6 +27,11 @@
 
 typedef void CURL;
 
+namespace AliceO2::InfoLogger
+{
+class InfoLogger;
+}
+
 namespace o2::quality_control::core
 {
 
@@ -32,9 +39,21 @@ namespace o2::quality_control::core
 ///
 /// Register a endpoint to Consul which then performs health checks it
 /// Allow to publish list of online objects
+///
+/// The lists of objects given to registerAsync() are sent by the health check thread, so the caller is never blocked
+/// by Consul. Only the latest list waiting to be sent is kept and a list is not sent again if it has the same paths
+/// as the one registered last. A list which could not be sent is retried every second until a newer one replaces it.
 class ServiceDiscovery
 {
  public:
+  struct Statistics {
+    uint64_t registrations = 0; ///< registrations sent successfully
+    uint64_t failures = 0;      ///< registrations which failed
+    uint64_t unchanged = 0;     ///< asynchronous registrations skipped, because the list of objects did not change
+    double lastLatency = 0;     ///< duration of the latest registration [s]
+    double maxLatency = 0;      ///< longest registration [s]
+  };
+
   /// Sets up CURL and health check
   /// \param url 		Consul URL
   /// \param name		Service name
@@ -49,9 +68,18 @@ class ServiceDiscovery
   /// \param objects 		List of comma separated objects
   bool _register(const std::string& objects);
 
-  /// Deregisters service
+  /// Registers list of online objects in the background, it returns immediately
+  /// \param objects 		List of comma separated objects
+  void registerAsync(std::string objects);
+
+  /// Deregisters service, the registrations which were not sent yet are dropped
   void deregister();
 
+  Statistics getStatistics() const;
+
+  /// Returns a hash of the comma separated list of objects, which does not depend on their order
+  static size_t hashObjects(const std::string& objects);
+
   static constexpr size_t HealthPortRangeStart = 47800; ///< Health check port range start
   static constexpr size_t HealthPortRangeEnd = 47899;   ///< Health check port range end
 
@@ -73,12 +101,28 @@ class ServiceDiscovery
   std::thread mHealthThread;        ///< Health check thread
   std::atomic<bool> mThreadRunning; ///< Health check thread running flag
 
+  std::mutex mSendMutex;                      ///< Serializes the use of the CURL handle and the registration order
+  mutable std::mutex mMailboxMutex;           ///< Protects the members below
+  std::optional<std::string> mPendingObjects; ///< Latest list of objects waiting to be registered
+  std::optional<size_t> mRegisteredHash;      ///< Hash of the list of objects registered last
+  Statistics mStatistics;
+
   /// Initializes CURL
   CURL* initCurl();
 
+  /// Sends PUT request, without logging
+  /// \param error 		Set to the reason of the failure
+  bool send(const std::string& path, std::string&& request, std::string& error);
+
   /// Sends PUT request
   bool send(const std::string& path, std::string&& request);
 
+  /// Builds the registration request and sends it, updating the statistics. mSendMutex has to be locked.
+  bool sendRegistration(const std::string& objects, std::string& error);
+
+  /// Sends the pending list of objects, if any, called by the health check thread
+  void processPendingRegistration(AliceO2::InfoLogger::InfoLogger& logger);
+
   /// Health check thread loop + port computation
   void runHealthServer();
 };
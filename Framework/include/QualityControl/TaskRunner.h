@@ -18,6 +18,7 @@
 #ifndef QC_CORE_TASKRUNNER_H
 #define QC_CORE_TASKRUNNER_H
 
+#include <memory>
 // O2
 #include <Common/Timer.h>
 #include <Framework/Task.h>
@@ -53,6 +54,7 @@ namespace o2::quality_control::core
 class Timekeeper;
 class TaskInterface;
 class ObjectsManager;
+class MonitorObjectCollection;
 
 /// \brief A class driving the execution of a QC task inside DPL.
 ///
@@ -119,6 +121,15 @@ class TaskRunner : public framework::Task
   /// \brief Callback for CallbackService::Id::EndOfStream
   void endOfStream(framework::EndOfStreamContext& eosContext) override;
 
+  /// \brief Returns the MOs which are sent at the end of the cycle with the given number (starting from 0).
+  ///
+  /// With publishUpdatedObjectsOnly, the objects which were not updated are left out, except in the full publication cycles.
+  /// The returned collection does not own the objects. It does not depend on DPL, so that o2-qc-publication-benchmark
+  /// can measure the same publication path.
+  static std::unique_ptr<MonitorObjectCollection> getObjectsToPublish(ObjectsManager& objectsManager, const TaskRunnerConfig& config, int cycleNumber);
+  /// \brief Tells whether the task is reset once the given number of cycles are finished, according to resetAfterCycles.
+  static bool isResetNeeded(const TaskRunnerConfig& config, int finishedCycles);
+
  private:
   /// \brief Callback for CallbackService::Id::Start (DPL) a.k.a. RUN transition (FairMQ)
   void start(framework::ServiceRegistryRef services);
@@ -157,6 +168,7 @@ class TaskRunner : public framework::Task
   // stats
   int mNumberMessagesReceivedInCycle = 0;
   int mNumberObjectsPublishedInCycle = 0;
+  int mNumberObjectsNotUpdatedInCycle = 0; // not published because they were not modified
   int mTotalNumberObjectsPublished = 0; // over a run
   double mLastPublicationDuration = 0;
   uint64_t mDataReceivedInCycle = 0;
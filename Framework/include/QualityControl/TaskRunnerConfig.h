@@ -66,6 +66,8 @@ struct TaskRunnerConfig {
   std::shared_ptr<o2::globaltracking::DataRequest> globalTrackingDataRequest;
   std::vector<std::string> movingWindows;
   bool disableLastCycle = false;
+  bool publishUpdatedObjectsOnly = false;
+  int fullPublicationCycles = 0; // all objects are published every N cycles, 0 means only in the first cycle
 };
 
 } // namespace o2::quality_control::core
@@ -77,6 +77,8 @@ struct TaskSpec {
   GlobalTrackingDataRequestSpec globalTrackingDataRequest;
   std::vector<std::string> movingWindows;
   bool disableLastCycle = false;
+  bool publishUpdatedObjectsOnly = false;
+  int fullPublicationCycles = 0;
 };
 
 } // namespace o2::quality_control::core
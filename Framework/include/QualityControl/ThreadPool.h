@@ -0,0 +1,75 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ThreadPool.h
+///
+
+#ifndef QUALITYCONTROL_THREADPOOL_H
+#define QUALITYCONTROL_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Fixed-size pool of threads executing the submitted jobs in FIFO order.
+///
+/// Jobs should not wait for other jobs submitted to the same pool, as it could lead to a deadlock
+/// once all the threads are taken.
+class ThreadPool
+{
+ public:
+  explicit ThreadPool(size_t threads);
+  /// Executes the jobs which are still queued and joins the threads.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t size() const { return mThreads.size(); }
+
+  /// \brief Queues a job. Exceptions thrown by the job are propagated through the returned future.
+  template <typename F>
+  auto submit(F&& job) -> std::future<std::invoke_result_t<F>>
+  {
+    using Result = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+    auto future = task->get_future();
+    {
+      std::lock_guard lock(mMutex);
+      mJobs.emplace([task]() { (*task)(); });
+    }
+    mJobAvailable.notify_one();
+    return future;
+  }
+
+ private:
+  void run();
+
+  std::vector<std::thread> mThreads;
+  std::queue<std::function<void()>> mJobs;
+  std::mutex mMutex;
+  std::condition_variable mJobAvailable;
+  bool mStopping = false;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QUALITYCONTROL_THREADPOOL_H
@@ -21,6 +21,7 @@
 #include "QualityControl/Reductor.h"
 #include "QualityControl/TrendingTaskConfig.h"
 
+#include <deque>
 #include <memory>
 #include <unordered_map>
 #include <TTree.h>
@@ -43,6 +44,10 @@ namespace o2::quality_control::postprocessing
 /// class exposes the TTree::Draw interface to the user. The TTree and plots are stored in the QCDB. The class is
 /// configured with configuration files, see Framework/postprocessing.json as an example.
 ///
+/// With "trendChunks", the trend is stored in the QCDB as a series of small TTrees, one per run or per time bucket.
+/// Each update uploads only the current chunk, while the in-memory TTree used for plotting is reassembled only from
+/// the chunks which should be plotted.
+///
 /// \author Piotr Konopka
 class TrendingTask : public PostProcessingInterface
 {
@@ -75,11 +80,21 @@ class TrendingTask : public PostProcessingInterface
   void generatePlots();
   TCanvas* drawPlot(const TrendingTaskConfig::Plot& plotConfig);
   void initializeTrend(repository::DatabaseInterface& qcdb);
+  void initializeTrendChunks(repository::DatabaseInterface& qcdb);
+  void loadTrendChunks(repository::DatabaseInterface& qcdb);
   bool canContinueTrend(TTree* tree);
+  std::unique_ptr<TTree> createTree(const std::string& name);
+  void setBranchAddresses(TTree* tree);
+  std::string getChunkName() const;
+  std::string getChunkKey(const Trigger& t, UInt_t time) const;
+  void switchChunk(const std::string& chunkKey);
 
   TrendingTaskConfig mConfig;
   UInt_t mTime;
   std::unique_ptr<TTree> mTrend;
+  std::unique_ptr<TTree> mChunk;                              // the trend points of the current chunk
+  std::string mChunkKey;                                      // the key of the current chunk
+  std::deque<std::pair<std::string, Long64_t>> mTrendChunks; // the chunks in mTrend and their number of entries
   std::map<std::string, std::unique_ptr<TObject>> mPlots;
   std::unordered_map<std::string, std::unique_ptr<Reductor>> mReductors;
 };
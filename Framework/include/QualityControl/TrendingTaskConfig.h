@@ -63,6 +63,9 @@ struct TrendingTaskConfig : PostProcessingConfig {
   bool resumeTrend{};
   bool trendIfAllInputs{ false };
   std::string trendingTimestamp;
+  std::string trendChunks;           // empty (the whole trend in one TTree), "run" or a duration, e.g. "24hour"
+  double trendChunkPeriodSeconds = 0; // the duration of a chunk if it is not "run"
+  size_t trendChunksInPlots = 0;      // the number of the latest chunks used in plots, 0 means all
   std::vector<Plot> plots;
   std::vector<DataSource> dataSources;
 };
@@ -17,6 +17,7 @@
 #define QUALITYCONTROL_TRIGGERHELPERS_H
 
 #include "QualityControl/Triggers.h"
+#include <optional>
 #include <vector>
 #include <string>
 
@@ -36,6 +37,8 @@ Trigger tryTrigger(std::vector<TriggerFcn>&);
 /// \brief Checks if in a given trigger configuration vector there is a UserOrControl trigger.
 /// This is trigger cannot be checked as all the others, so we just check if it is requested in the right moments.
 bool hasUserOrControlTrigger(const std::vector<std::string>&);
+/// \brief Converts a duration like "10sec", "5min" or "24hour" to seconds. Returns nullopt if there is no known unit.
+std::optional<double> string2Seconds(std::string str);
 
 } // namespace o2::quality_control::postprocessing::trigger_helpers
 
@@ -87,7 +87,10 @@ TriggerFcn EndOfFill(const core::Activity& = {});
 /// \brief Triggers when a period of time passes
 TriggerFcn Periodic(double seconds, const core::Activity& = {}, std::string config = {});
 /// \brief Triggers when it detect a new object in QC repository with given name
-TriggerFcn NewObject(const std::string& databaseUrl, const std::string& databaseType, const std::string& objectPath, const core::Activity& = {}, const std::string& config = {});
+///
+/// The listings of the repository are shared by all NewObject triggers in the process which watch objects in the same
+/// directory. A listing is reused if it is not older than pollingPeriodSeconds, 0 means listing at each call.
+TriggerFcn NewObject(const std::string& databaseUrl, const std::string& databaseType, const std::string& objectPath, const core::Activity& = {}, const std::string& config = {}, double pollingPeriodSeconds = 0);
 /// \brief Triggers for each object version in the path which match the activity. It retrieves the available list only once!
 TriggerFcn ForEachObject(const std::string& databaseUrl, const std::string& databaseType, const std::string& objectPath, const core::Activity& = {}, const std::string& config = {});
 /// \brief Triggers for the latest object version for each distinct activity. It retrieves the available list only once!
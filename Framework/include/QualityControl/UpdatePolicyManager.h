@@ -18,7 +18,7 @@
 #define QC_CHECKER_POLICYMANAGER_H
 
 #include <string>
-#include <map>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 #include <iosfwd>
@@ -43,6 +43,10 @@ struct UpdatePolicy {
   // TODO this line makes me think that lambdas are not enough because we actually need to store a state...
   bool policyHelperFlag; // the purpose might change depending on policy,
   RevisionType revision = 0;
+  // the state below is kept up to date by UpdatePolicyManager, so the policies do not have to look at each input object.
+  std::vector<size_t> inputObjectIds; // unique IDs of the input objects, without duplicates
+  size_t missingInputs = 0;           // number of input objects which were never received
+  size_t newerInputs = 0;             // number of input objects with a revision higher than the one of the actor
 
   friend std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy); // output
 };
@@ -68,6 +72,10 @@ struct UpdatePolicy {
  *   - onEachSeparately: synonym of 'onAny'.
  * If "all" is specified as list of object, or the list is empty, we always trigger.
  *
+ * The objects are given integer IDs and each of them knows which actors depend on it. Updating an object revision
+ * only updates the counters of the dependent actors, so checking whether an actor is ready does not depend
+ * on the number of its input objects.
+ *
  * A typical caller code looks like this:
  * \code{.cpp}
  *  // when initializing
@@ -137,9 +145,22 @@ class UpdatePolicyManager
   bool isReady(const std::string& actorName);
 
  private:
-  std::map<std::string /* Actor name */, UpdatePolicy> mPoliciesByActor;
+  struct ObjectState {
+    RevisionType revision = 0;
+    bool received = false;
+    std::vector<size_t> dependentActors; // IDs of actors which have this object as an input
+  };
+
+  /// \brief Returns the ID of the object, creates one if it is not known yet.
+  size_t getObjectId(const std::string& objectName);
+  /// \brief Recomputes the number of inputs which are newer than the actor.
+  void countNewerInputs(UpdatePolicy& policy);
+
+  std::unordered_map<std::string /* Actor name */, size_t> mActorIds;
+  std::vector<UpdatePolicy> mPolicies; // indexed by actor IDs
   RevisionType mGlobalRevision = 1;
-  std::map<std::string /* Object name */, RevisionType> mObjectsRevision;
+  std::unordered_map<std::string /* Object name */, size_t> mObjectIds;
+  std::vector<ObjectState> mObjects; // indexed by object IDs
 };
 
 } // namespace o2::quality_control::checker
@@ -19,10 +19,12 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <Rtypes.h>
 
 #include "QualityControl/ConditionAccess.h"
 #include "QualityControl/CustomParameters.h"
+#include "QualityControl/ResolvedCustomParameters.h"
 
 namespace o2::quality_control::core
 {
@@ -46,14 +48,31 @@ class UserCodeInterface : public ConditionAccess
   /// It is called each time mCustomParameters is updated, including the first time it is read.
   virtual void configure() = 0;
 
+  /// \brief Resolves the custom parameters for the run type and beam type of the activity.
+  ///
+  /// Called by the framework before startOfActivity, the result is available in mResolvedCustomParameters.
+  /// The first time the parameters are resolved for a run type and beam type, they are validated against
+  /// getExpectedCustomParameters() and the unknown or malformed ones are reported in the logs.
+  void resolveCustomParameters(const Activity& activity);
+  const ResolvedCustomParameters& getResolvedCustomParameters() const;
+
   const std::string& getName() const;
   void setName(const std::string& name);
 
  protected:
+  /// \brief The custom parameters used by the user code, with their types.
+  ///
+  /// Users can override it to have their configuration validated, nothing is validated if it is empty.
+  virtual std::vector<ResolvedCustomParameters::Expected> getExpectedCustomParameters() const;
+
   CustomParameters mCustomParameters;
+  ResolvedCustomParameters mResolvedCustomParameters; //!
   std::string mName;
 
-  ClassDef(UserCodeInterface, 3)
+ private:
+  std::vector<std::string> mValidatedRunBeamTypes; //!
+
+  ClassDef(UserCodeInterface, 4)
 };
 
 } // namespace o2::quality_control::core
@@ -257,6 +257,7 @@ framework::OutputSpec Aggregator::createOutputSpec(const std::string& detector,
 void Aggregator::startOfActivity(const core::Activity& activity)
 {
   if (mAggregatorInterface) {
+    mAggregatorInterface->resolveCustomParameters(activity);
     mAggregatorInterface->startOfActivity(activity);
   } else {
     throw std::runtime_error("Trying to start an Activity on an empty AggregatorInterface '" + mAggregatorConfig.name + "'");
@@ -32,6 +32,7 @@
 
 // QC
 #include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/AsyncDatabase.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/ServiceDiscovery.h"
 #include "QualityControl/Aggregator.h"
@@ -239,7 +240,14 @@ void AggregatorRunner::send(const QualityObjectsWithAggregatorNameVector& qualit
 
 void AggregatorRunner::initDatabase()
 {
-  mDatabase = DatabaseFactory::create(mRunnerConfig.database.at("implementation"));
+  const auto& implementation = mRunnerConfig.database.at("implementation");
+  if (AsyncDatabase::isEnabled(mRunnerConfig.database)) {
+    auto asyncConfig = AsyncDatabase::Config::fromDatabaseConfig(mRunnerConfig.database);
+    mAsyncDatabase = std::make_shared<AsyncDatabase>([implementation]() { return DatabaseFactory::create(implementation); }, asyncConfig);
+    mDatabase = mAsyncDatabase;
+  } else {
+    mDatabase = DatabaseFactory::create(implementation);
+  }
   mDatabase->connect(mRunnerConfig.database);
   ILOG(Info, Devel) << "Database that is going to be used > Implementation : " << mRunnerConfig.database.at("implementation") << " / Host : " << mRunnerConfig.database.at("host") << ENDM;
 }
@@ -380,6 +388,17 @@ void AggregatorRunner::sendPeriodicMonitoring()
     mCollector->send({ mTotalNumberAggregatorExecuted, "qc_aggregator_executed" });
     mCollector->send({ mTotalNumberObjectsProduced, "qc_aggregator_objects_produced" });
     mCollector->send({ mTimerTotalDurationActivity.getTime(), "qc_aggregator_duration" });
+    if (mAsyncDatabase) {
+      auto stats = mAsyncDatabase->getStatistics();
+      mCollector->send(Metric{ "qc_aggregator_async_storage" }
+                         .addValue(stats.queueSize, "queue_size")
+                         .addValue(stats.stored, "stored")
+                         .addValue(stats.coalesced, "coalesced")
+                         .addValue(stats.dropped, "dropped")
+                         .addValue(stats.failed, "failed")
+                         .addValue(stats.skipped, "skipped")
+                         .addValue(stats.blockedSeconds, "blocked_seconds"));
+    }
   }
 }
 
@@ -411,6 +430,9 @@ void AggregatorRunner::stop()
   for (auto& aggregator : mAggregators) {
     aggregator->endOfActivity(*mActivity);
   }
+  if (mAsyncDatabase) {
+    mAsyncDatabase->flush();
+  }
 }
 
 void AggregatorRunner::reset()
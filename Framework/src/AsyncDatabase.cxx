@@ -0,0 +1,336 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   AsyncDatabase.cxx
+///
+
+#include "QualityControl/AsyncDatabase.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Exceptions.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <TROOT.h>
+#include <algorithm>
+#include <chrono>
+
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+AsyncDatabase::Config AsyncDatabase::Config::fromDatabaseConfig(const std::unordered_map<std::string, std::string>& databaseConfig)
+{
+  Config config;
+  if (auto it = databaseConfig.find("asyncStorageWorkers"); it != databaseConfig.end() && !it->second.empty()) {
+    config.workers = std::max(1, std::stoi(it->second));
+  }
+  if (auto it = databaseConfig.find("asyncStorageQueueSize"); it != databaseConfig.end() && !it->second.empty()) {
+    config.queueCapacity = std::max(1, std::stoi(it->second));
+  }
+  if (auto it = databaseConfig.find("asyncStorageDropWhenFull"); it != databaseConfig.end()) {
+    config.dropWhenFull = it->second == "true" || it->second == "1";
+  }
+  return config;
+}
+
+bool AsyncDatabase::isEnabled(const std::unordered_map<std::string, std::string>& databaseConfig)
+{
+  auto it = databaseConfig.find("asyncStorage");
+  return it != databaseConfig.end() && (it->second == "true" || it->second == "1");
+}
+
+AsyncDatabase::AsyncDatabase(BackendFactory backendFactory, Config config)
+  : mConfig(config),
+    mSyncBackend(backendFactory())
+{
+  if (mConfig.workers == 0 || mConfig.queueCapacity == 0) {
+    BOOST_THROW_EXCEPTION(AliceO2::Common::FatalException() << AliceO2::Common::errinfo_details("AsyncDatabase needs at least one worker and a non-zero queue capacity"));
+  }
+  // the workers stream the objects while the calling thread keeps creating and reading other ROOT objects
+  ROOT::EnableThreadSafety();
+  for (size_t i = 0; i < mConfig.workers; i++) {
+    mWorkerBackends.emplace_back(backendFactory());
+  }
+  for (size_t i = 0; i < mConfig.workers; i++) {
+    mWorkers.emplace_back(&AsyncDatabase::runWorker, this, i);
+  }
+}
+
+AsyncDatabase::~AsyncDatabase()
+{
+  {
+    std::lock_guard lock(mMutex);
+    mStopping = true;
+  }
+  mJobAvailable.notify_all();
+  for (auto& worker : mWorkers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void AsyncDatabase::connect(const std::string& host, const std::string& database, const std::string& username, const std::string& password)
+{
+  mSyncBackend->connect(host, database, username, password);
+  for (auto& backend : mWorkerBackends) {
+    backend->connect(host, database, username, password);
+  }
+}
+
+void AsyncDatabase::connect(const std::unordered_map<std::string, std::string>& config)
+{
+  mSyncBackend->connect(config);
+  for (auto& backend : mWorkerBackends) {
+    backend->connect(config);
+  }
+}
+
+void AsyncDatabase::storeMO(std::shared_ptr<const core::MonitorObject> mo)
+{
+  // The caller keeps on using its objects (e.g. Checks beautify them in the next cycles),
+  // thus we store a snapshot of the current state.
+  auto snapshot = std::make_shared<const MonitorObject>(*mo);
+  enqueue(mo->getPath(), Job{ std::move(snapshot), nullptr });
+}
+
+void AsyncDatabase::storeMOAfter(std::shared_ptr<const core::MonitorObject> mo, std::vector<std::string> precedingPaths)
+{
+  auto snapshot = std::make_shared<const MonitorObject>(*mo);
+  enqueue(mo->getPath(), Job{ std::move(snapshot), nullptr, std::move(precedingPaths) });
+}
+
+void AsyncDatabase::storeQO(std::shared_ptr<const core::QualityObject> qo)
+{
+  // QualityObjects are not modified once produced, no need for a copy
+  auto path = qo->getPath();
+  enqueue(path, Job{ nullptr, std::move(qo) });
+}
+
+void AsyncDatabase::enqueue(const std::string& path, Job&& job)
+{
+  std::unique_lock lock(mMutex);
+
+  if (auto pending = mPendingJobs.find(path); pending != mPendingJobs.end()) {
+    // the previous version was not stored yet, it is superseded by the new one
+    pending->second = std::move(job);
+    mStatistics.coalesced++;
+    return;
+  }
+
+  if (mPendingJobs.size() >= mConfig.queueCapacity) {
+    if (mConfig.dropWhenFull) {
+      mStatistics.dropped++;
+      ILOG(Debug, Devel) << "The asynchronous storage queue is full, object " << path << " is dropped" << ENDM;
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    mSpaceAvailable.wait(lock, [this] { return mPendingJobs.size() < mConfig.queueCapacity || mStopping; });
+    mStatistics.blockedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  mPendingJobs.emplace(path, std::move(job));
+  mQueueOrder.push_back(path);
+  mStatistics.enqueued++;
+  lock.unlock();
+  mJobAvailable.notify_one();
+}
+
+void AsyncDatabase::runWorker(size_t workerId)
+{
+  auto& backend = *mWorkerBackends[workerId];
+  std::unique_lock lock(mMutex);
+  while (true) {
+    // we take the oldest path which is not being stored by another worker, so that the versions of an object
+    // are always stored in the order they arrived.
+    auto nextPath = mQueueOrder.end();
+    mJobAvailable.wait(lock, [&] {
+      nextPath = std::find_if(mQueueOrder.begin(), mQueueOrder.end(), [this](const std::string& path) { return isReady(path); });
+      return nextPath != mQueueOrder.end() || (mStopping && mQueueOrder.empty());
+    });
+    if (nextPath == mQueueOrder.end()) {
+      return; // stopping and nothing left to do
+    }
+
+    std::string path = std::move(*nextPath);
+    mQueueOrder.erase(nextPath);
+    auto pending = mPendingJobs.find(path);
+    Job job = std::move(pending->second);
+    mPendingJobs.erase(pending);
+    mPathsInFlight.insert(path);
+    const bool precedingFailed = std::any_of(job.precedingPaths.begin(), job.precedingPaths.end(), [this](const std::string& precedingPath) {
+      return mFailedPaths.count(precedingPath) > 0;
+    });
+    lock.unlock();
+    mSpaceAvailable.notify_one();
+
+    bool success = false;
+    if (precedingFailed) {
+      ILOG(Warning, Support) << "Not storing " << path << ", because some of the objects it should follow could not be stored" << ENDM;
+    } else {
+      try {
+        if (job.mo) {
+          backend.storeMO(job.mo);
+        } else if (job.qo) {
+          backend.storeQO(job.qo);
+        }
+        success = backend.isLastObjectStored(); // the backend has already complained otherwise
+      } catch (boost::exception& e) {
+        ILOG(Warning, Support) << "Unable to store " << path << ": " << boost::diagnostic_information(e) << ENDM;
+      } catch (std::exception& e) {
+        ILOG(Warning, Support) << "Unable to store " << path << ": " << e.what() << ENDM;
+      }
+    }
+
+    lock.lock();
+    mPathsInFlight.erase(path);
+    if (success) {
+      mStatistics.stored++;
+      mFailedPaths.erase(path);
+    } else if (precedingFailed) {
+      mStatistics.skipped++;
+    } else {
+      mStatistics.failed++;
+      mFailedPaths.insert(path);
+    }
+    if (mQueueOrder.empty() && mPathsInFlight.empty()) {
+      mAllDone.notify_all();
+    }
+    // another worker might have been waiting for this path to be released
+    mJobAvailable.notify_all();
+  }
+}
+
+bool AsyncDatabase::isReady(const std::string& path) const
+{
+  if (mPathsInFlight.count(path) > 0) {
+    return false;
+  }
+  const auto& precedingPaths = mPendingJobs.at(path).precedingPaths;
+  return std::none_of(precedingPaths.begin(), precedingPaths.end(), [this](const std::string& precedingPath) {
+    return mPendingJobs.count(precedingPath) > 0 || mPathsInFlight.count(precedingPath) > 0;
+  });
+}
+
+void AsyncDatabase::flush()
+{
+  std::unique_lock lock(mMutex);
+  mAllDone.wait(lock, [this] { return mQueueOrder.empty() && mPathsInFlight.empty(); });
+}
+
+AsyncDatabase::Statistics AsyncDatabase::getStatistics() const
+{
+  std::lock_guard lock(mMutex);
+  Statistics statistics = mStatistics;
+  statistics.queueSize = mPendingJobs.size();
+  return statistics;
+}
+
+DatabaseInterface::CompressionStatistics AsyncDatabase::getCompressionStatistics() const
+{
+  CompressionStatistics total = mSyncBackend->getCompressionStatistics();
+  for (const auto& backend : mWorkerBackends) {
+    auto statistics = backend->getCompressionStatistics();
+    total.objects += statistics.objects;
+    total.rawBytes += statistics.rawBytes;
+    total.compressedBytes += statistics.compressedBytes;
+    total.seconds += statistics.seconds;
+  }
+  return total;
+}
+
+void AsyncDatabase::storeQCFC(std::shared_ptr<const o2::quality_control::QualityControlFlagCollection> qcfc)
+{
+  mSyncBackend->storeQCFC(qcfc);
+}
+
+void AsyncDatabase::storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, std::map<std::string, std::string> const& metadata,
+                             std::string const& detectorName, std::string const& taskName, long from, long to)
+{
+  // we do not own obj, so it has to be stored right away
+  mSyncBackend->storeAny(obj, typeInfo, path, metadata, detectorName, taskName, from, to);
+}
+
+void* AsyncDatabase::retrieveAny(std::type_info const& tinfo, std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp,
+                                 std::map<std::string, std::string>* headers, const std::string& createdNotAfter, const std::string& createdNotBefore)
+{
+  return mSyncBackend->retrieveAny(tinfo, path, metadata, timestamp, headers, createdNotAfter, createdNotBefore);
+}
+
+std::shared_ptr<core::MonitorObject> AsyncDatabase::retrieveMO(std::string objectPath, std::string objectName, long timestamp, const core::Activity& activity)
+{
+  return mSyncBackend->retrieveMO(std::move(objectPath), std::move(objectName), timestamp, activity);
+}
+
+std::shared_ptr<core::QualityObject> AsyncDatabase::retrieveQO(std::string qoPath, long timestamp, const core::Activity& activity)
+{
+  return mSyncBackend->retrieveQO(std::move(qoPath), timestamp, activity);
+}
+
+std::shared_ptr<o2::quality_control::QualityControlFlagCollection> AsyncDatabase::retrieveQCFC(const std::string& name, const std::string& detector, int runNumber,
+                                                                                               const std::string& passName, const std::string& periodName,
+                                                                                               const std::string& provenance, long timestamp)
+{
+  return mSyncBackend->retrieveQCFC(name, detector, runNumber, passName, periodName, provenance, timestamp);
+}
+
+TObject* AsyncDatabase::retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers)
+{
+  return mSyncBackend->retrieveTObject(std::move(path), metadata, timestamp, headers);
+}
+
+std::string AsyncDatabase::retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata)
+{
+  return mSyncBackend->retrieveJson(std::move(path), timestamp, metadata);
+}
+
+void AsyncDatabase::disconnect()
+{
+  flush();
+  mSyncBackend->disconnect();
+  for (auto& backend : mWorkerBackends) {
+    backend->disconnect();
+  }
+}
+
+void AsyncDatabase::prepareTaskDataContainer(std::string taskName)
+{
+  mSyncBackend->prepareTaskDataContainer(std::move(taskName));
+}
+
+std::vector<std::string> AsyncDatabase::getPublishedObjectNames(std::string taskName)
+{
+  return mSyncBackend->getPublishedObjectNames(std::move(taskName));
+}
+
+void AsyncDatabase::truncate(std::string path, std::string objectName)
+{
+  mSyncBackend->truncate(std::move(path), std::move(objectName));
+}
+
+void AsyncDatabase::setMaxObjectSize(size_t maxObjectSize)
+{
+  // workers are idle only after a flush, that's when we may touch their backends
+  flush();
+  std::lock_guard lock(mMutex);
+  mSyncBackend->setMaxObjectSize(maxObjectSize);
+  for (auto& backend : mWorkerBackends) {
+    backend->setMaxObjectSize(maxObjectSize);
+  }
+}
+
+core::ValidityInterval AsyncDatabase::getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  return mSyncBackend->getLatestObjectValidity(path, metadata);
+}
+
+} // namespace o2::quality_control::repository
@@ -21,6 +21,7 @@
 #include "QualityControl/RepoPathUtils.h"
 #include "QualityControl/ActivityHelpers.h"
 #include "QualityControl/ObjectMetadataKeys.h"
+#include "QualityControl/ObjectCache.h"
 
 // O2
 #include <Common/Exceptions.h>
@@ -28,12 +29,16 @@
 #include <CommonUtils/MemFileHelper.h>
 // ROOT
 #include <TBufferJSON.h>
+#include <Compression.h>
+#include <TClass.h>
 #include <TH1F.h>
 #include <TFile.h>
+#include <TMemFile.h>
 #include <TList.h>
 #include <TROOT.h>
 #include <TKey.h>
 // std
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 #include <filesystem>
@@ -75,10 +80,61 @@ void CcdbDatabase::connect(const std::unordered_map<std::string, std::string>& c
   mUrl = config.at("host");
   init();
   if (config.count("maxObjectSize")) {
-    mMaxObjectSize = std::stoi(config.at("maxObjectSize"));
+    mMaxObjectSize = std::stoull(config.at("maxObjectSize"));
+  }
+  if (ObjectCache::isEnabled(config)) {
+    mObjectCache = ObjectCache::getShared(ObjectCache::Config::fromDatabaseConfig(config));
+  }
+  if (config.count("compression")) {
+    mCompressionSettings = parseCompressionSettings(config.at("compression"));
   }
 }
 
+int CcdbDatabase::parseCompressionSettings(const std::string& value)
+{
+  using Algorithm = ROOT::RCompressionSetting::EAlgorithm;
+  using Level = ROOT::RCompressionSetting::ELevel;
+  static const std::map<std::string, std::pair<Algorithm::EValues, int>> algorithms{
+    { "zlib", { Algorithm::kZLIB, Level::kDefaultZLIB } },
+    { "lzma", { Algorithm::kLZMA, Level::kDefaultLZMA } },
+    { "lz4", { Algorithm::kLZ4, Level::kDefaultLZ4 } },
+    { "zstd", { Algorithm::kZSTD, Level::kDefaultZSTD } }
+  };
+
+  if (value.empty() || value == "default") {
+    return -1;
+  }
+  if (value == "none") {
+    return 0;
+  }
+
+  auto separator = value.find(':');
+  auto algorithm = algorithms.find(value.substr(0, separator));
+  if (algorithm == algorithms.end()) {
+    BOOST_THROW_EXCEPTION(DatabaseException()
+                          << errinfo_details("Unknown compression algorithm in '" + value + "', expected one of zlib, lzma, lz4, zstd, none or default"));
+  }
+  int level = algorithm->second.second;
+  if (separator != string::npos) {
+    auto levelString = value.substr(separator + 1);
+    size_t parsed = 0;
+    try {
+      level = std::stoi(levelString, &parsed);
+    } catch (const std::exception&) {
+      parsed = 0;
+    }
+    if (parsed == 0 || parsed != levelString.size()) {
+      BOOST_THROW_EXCEPTION(DatabaseException()
+                            << errinfo_details("Invalid compression level in '" + value + "'"));
+    }
+  }
+  if (level < 1 || level > 9) {
+    BOOST_THROW_EXCEPTION(DatabaseException()
+                          << errinfo_details("The compression level in '" + value + "' should be between 1 and 9"));
+  }
+  return ROOT::CompressionSettings(algorithm->second.first, level);
+}
+
 void CcdbDatabase::init()
 {
   ccdbApi->init(mUrl);
@@ -87,6 +143,7 @@ void CcdbDatabase::init()
 
 void CcdbDatabase::handleStorageError(const string& path, int result)
 {
+  mLastStoreResult = result;
   if (result == -1 /* object bigger than maxObjectSize */) {
     static AliceO2::InfoLogger::InfoLogger::AutoMuteToken msgLimit(LogWarningSupport, 1, 600); // send it once every 10 minutes
     string msg = "object " + path + " is bigger than the maximum allowed size (" + to_string(mMaxObjectSize) + "B) - skipped";
@@ -108,6 +165,7 @@ bool CcdbDatabase::isDbInFailure()
       mDatabaseFailure = false;
     } else {
       ILOG(Debug, Devel) << "Storage is disabled following a failure, this object won't be stored. New attempt in " << (int)mFailureTimer.getRemainingTime() << " seconds" << ENDM;
+      mLastStoreResult = storeNotAttempted;
       return true;
     }
   }
@@ -157,7 +215,12 @@ void CcdbDatabase::storeAny(const void* obj, std::type_info const& typeInfo, std
   }
 
   ILOG(Debug, Support) << "Storing object " << path << " of type " << fullMetadata[metadata_keys::objectType] << ENDM;
-  int result = ccdbApi->storeAsTFile_impl(obj, typeInfo, path, fullMetadata, from, to, mMaxObjectSize);
+  int result = 0;
+  if (mCompressionSettings < 0) {
+    result = ccdbApi->storeAsTFile_impl(obj, typeInfo, path, fullMetadata, from, to, mMaxObjectSize);
+  } else {
+    result = storeCompressed(obj, TClass::GetClass(typeInfo), path, fullMetadata, from, to);
+  }
 
   handleStorageError(path, result);
 }
@@ -214,15 +277,57 @@ void CcdbDatabase::storeMO(std::shared_ptr<const o2::quality_control::core::Moni
 
   if (from > to) {
     ILOG(Error, Support) << "The validity start of '" << mo->GetName() << "' later than the end (" << from << ", " << to << "). The object will not be stored" << ENDM;
+    mLastStoreResult = storeInvalidValidity;
     return;
   }
 
   ILOG(Debug, Support) << "Storing MonitorObject " << path << ENDM;
-  int result = ccdbApi->storeAsTFileAny<TObject>(obj, path, metadata, from, to, mMaxObjectSize);
+  int result = 0;
+  if (mCompressionSettings < 0) {
+    result = ccdbApi->storeAsTFileAny<TObject>(obj, path, metadata, from, to, mMaxObjectSize);
+  } else {
+    // TObject as the declared type, as storeAsTFileAny<TObject> does, the actual class is streamed anyway
+    result = storeCompressed(obj, TObject::Class(), path, metadata, from, to);
+  }
 
   handleStorageError(path, result);
 }
 
+int CcdbDatabase::storeCompressed(const void* obj, const TClass* cl, const std::string& path, const std::map<std::string, std::string>& metadata, long from, long to)
+{
+  if (cl == nullptr) {
+    BOOST_THROW_EXCEPTION(DatabaseException()
+                          << errinfo_details("Cannot store " + path + ", its class has no dictionary."));
+  }
+
+  auto start = steady_clock::now();
+  auto fileName = o2::ccdb::CcdbApi::generateFileName(cl->GetName());
+  TMemFile memFile(fileName.c_str(), "RECREATE", "", mCompressionSettings);
+  memFile.WriteObjectAny(obj, cl, o2::ccdb::CcdbApi::CCDBOBJECT_ENTRY);
+  auto* key = memFile.GetKey(o2::ccdb::CcdbApi::CCDBOBJECT_ENTRY);
+  uint64_t rawBytes = key != nullptr ? key->GetObjlen() : 0;
+  memFile.Close();
+  std::vector<char> image(memFile.GetSize());
+  memFile.CopyTo(image.data(), memFile.GetSize());
+
+  mCompressionNanoseconds += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+  mCompressedObjects++;
+  mRawBytes += rawBytes;
+  mCompressedBytes += image.size();
+
+  return ccdbApi->storeAsBinaryFile(image.data(), image.size(), fileName, cl->GetName(), path, metadata, from, to, mMaxObjectSize);
+}
+
+DatabaseInterface::CompressionStatistics CcdbDatabase::getCompressionStatistics() const
+{
+  CompressionStatistics statistics;
+  statistics.objects = mCompressedObjects;
+  statistics.rawBytes = mRawBytes;
+  statistics.compressedBytes = mCompressedBytes;
+  statistics.seconds = mCompressionNanoseconds * 1e-9;
+  return statistics;
+}
+
 void CcdbDatabase::storeQO(std::shared_ptr<const o2::quality_control::core::QualityObject> qo)
 {
   if (isDbInFailure()) {
@@ -261,6 +366,7 @@ void CcdbDatabase::storeQO(std::shared_ptr<const o2::quality_control::core::Qual
 
   if (from > to) {
     ILOG(Error, Support) << "The validity start of '" << qo->GetName() << "' later than the end (" << from << ", " << to << "). The object will not be stored" << ENDM;
+    mLastStoreResult = storeInvalidValidity;
     return;
   }
 
@@ -299,23 +405,57 @@ void CcdbDatabase::storeQCFC(std::shared_ptr<const o2::quality_control::QualityC
 
 TObject* CcdbDatabase::retrieveTObject(std::string path, std::map<std::string, std::string> const& metadata, long timestamp, std::map<std::string, std::string>* headers)
 {
+  std::string cacheKey;
   if (timestamp == Timestamp::Latest) {
-    auto latestValidity = getLatestObjectValidity(path, metadata);
+    auto [latestValidity, latestId] = getLatestObjectVersion(path, metadata);
     if (latestValidity.isInvalid()) {
       return nullptr;
     }
     timestamp = latestValidity.getMin();
+    if (mObjectCache && !latestId.empty()) {
+      cacheKey = createCacheKey(path, latestValidity, latestId);
+    }
+  } else if (mObjectCache) {
+    // the headers are much cheaper to get than the object, and they identify its version
+    auto versionHeaders = ccdbApi->retrieveHeaders(path, metadata, timestamp);
+    if (auto etag = versionHeaders.find(metadata_keys::etag); etag != versionHeaders.end() && versionHeaders.count(metadata_keys::validFrom) && versionHeaders.count(metadata_keys::validUntil)) {
+      ValidityInterval validity{ std::stoull(versionHeaders.at(metadata_keys::validFrom)), std::stoull(versionHeaders.at(metadata_keys::validUntil)) };
+      cacheKey = createCacheKey(path, validity, etag->second);
+    }
   }
+
+  if (!cacheKey.empty()) {
+    if (auto cached = mObjectCache->get(cacheKey); cached.has_value()) {
+      ILOG(Debug, Support) << "Retrieved object " << path << " with timestamp " << timestamp << " from the local cache" << ENDM;
+      if (headers != nullptr) {
+        *headers = std::move(cached->headers);
+      }
+      return cached->object.release();
+    }
+  }
+
+  std::map<std::string, std::string> localHeaders;
+  auto* retrievedHeaders = headers != nullptr ? headers : &localHeaders;
   // we try first to load a TFile
-  auto* object = ccdbApi->retrieveFromTFileAny<TObject>(path, metadata, timestamp, headers);
+  auto* object = ccdbApi->retrieveFromTFileAny<TObject>(path, metadata, timestamp, retrievedHeaders);
   if (object == nullptr) {
     ILOG(Warning, Support) << "We could NOT retrieve the object " << path << " with timestamp " << timestamp << "." << ENDM;
     return nullptr;
   }
   ILOG(Debug, Support) << "Retrieved object " << path << " with timestamp " << timestamp << ENDM;
+  if (!cacheKey.empty()) {
+    mObjectCache->put(cacheKey, *object, *retrievedHeaders);
+  }
   return object;
 }
 
+std::string CcdbDatabase::createCacheKey(const std::string& path, const ValidityInterval& validity, std::string id)
+{
+  // ETags are quoted, while the IDs in listings are not
+  id.erase(std::remove(id.begin(), id.end(), '"'), id.end());
+  return path + "@" + std::to_string(validity.getMin()) + "-" + std::to_string(validity.getMax()) + "#" + id;
+}
+
 void* CcdbDatabase::retrieveAny(const type_info& tinfo, const string& path, const map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers, const string& createdNotAfter, const string& createdNotBefore)
 {
   if (timestamp == Timestamp::Latest) {
@@ -508,7 +648,12 @@ std::string CcdbDatabase::retrieveJson(std::string path, long timestamp, const s
 
 void CcdbDatabase::disconnect()
 {
-  // NOOP for CCDB
+  if (mObjectCache) {
+    auto statistics = mObjectCache->getStatistics();
+    ILOG(Info, Devel) << "Object cache statistics: " << statistics.memoryHits << " memory hits, " << statistics.diskHits << " disk hits, "
+                      << statistics.misses << " misses, " << statistics.evictions << " evictions, " << statistics.diskBytes << " bytes on disk" << ENDM;
+    mObjectCache.reset();
+  }
 }
 
 void CcdbDatabase::prepareTaskDataContainer(std::string /*taskName*/)
@@ -574,21 +719,27 @@ boost::property_tree::ptree CcdbDatabase::getListingAsPtree(const std::string& p
 }
 
 core::ValidityInterval CcdbDatabase::getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  return getLatestObjectVersion(path, metadata).first;
+}
+
+std::pair<core::ValidityInterval, std::string> CcdbDatabase::getLatestObjectVersion(const std::string& path, const std::map<std::string, std::string>& metadata)
 {
   auto listing = getListingAsPtree(path, metadata, true);
   if (listing.count("objects") == 0) {
     ILOG(Warning, Support) << "Could not get a valid listing from db '" << mUrl << "' for latestObjectMetadata '" << path << "'" << ENDM;
-    return gInvalidValidityInterval;
+    return { gInvalidValidityInterval, "" };
   }
   const auto& objects = listing.get_child("objects");
   if (objects.empty()) {
-    return gInvalidValidityInterval;
+    return { gInvalidValidityInterval, "" };
   } else if (objects.size() > 1) {
     ILOG(Warning, Support) << "Expected just one metadata entry for object '" << path << "'. Trying to continue by using the first." << ENDM;
   }
   const auto& latestObjectMetadata = objects.front().second;
 
-  return { latestObjectMetadata.get<uint64_t>(metadata_keys::validFrom), latestObjectMetadata.get<uint64_t>(metadata_keys::validUntil) };
+  return { { latestObjectMetadata.get<uint64_t>(metadata_keys::validFrom), latestObjectMetadata.get<uint64_t>(metadata_keys::validUntil) },
+           latestObjectMetadata.get<std::string>(metadata_keys::id, "") };
 }
 
 std::vector<uint64_t> CcdbDatabase::getTimestampsForObject(const std::string& path)
@@ -99,6 +99,17 @@ void Check::reset()
 }
 
 QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap)
+{
+  QualityObjectsType qualityObjects;
+  for (auto& moMapToCheck : prepareMapsToCheck(moMap)) {
+    if (auto qo = checkSingle(moMapToCheck)) {
+      qualityObjects.emplace_back(std::move(qo));
+    }
+  }
+  return qualityObjects;
+}
+
+std::vector<std::map<std::string, std::shared_ptr<MonitorObject>>> Check::prepareMapsToCheck(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap) const
 {
   if (mCheckInterface == nullptr) {
     BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Attempting to check, but no CheckInterface is loaded"));
@@ -136,45 +147,48 @@ QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObj
   } else {
     moMapsToCheck.emplace_back(shadowMap);
   }
+  return moMapsToCheck;
+}
 
-  QualityObjectsType qualityObjects;
-  for (auto& moMapToCheck : moMapsToCheck) {
-    if (std::ranges::any_of(moMapToCheck, [](const std::pair<std::string, std::shared_ptr<MonitorObject>>& item) {
-          return item.second == nullptr || item.second->getObject() == nullptr;
-        })) {
-      ILOG(Warning, Devel) << "Some MOs in the map to check are nullptr, skipping check '" << mCheckInterface->getName() << "'" << ENDM;
-      continue;
-    }
+std::shared_ptr<QualityObject> Check::checkSingle(std::map<std::string, std::shared_ptr<MonitorObject>>& moMapToCheck, bool withBeautify)
+{
+  if (std::ranges::any_of(moMapToCheck, [](const std::pair<std::string, std::shared_ptr<MonitorObject>>& item) {
+        return item.second == nullptr || item.second->getObject() == nullptr;
+      })) {
+    ILOG(Warning, Devel) << "Some MOs in the map to check are nullptr, skipping check '" << mCheckInterface->getName() << "'" << ENDM;
+    return nullptr;
+  }
 
-    Quality quality;
-    try {
-      quality = mCheckInterface->check(&moMapToCheck);
-    } catch (...) {
-      std::string diagnostic = boost::current_exception_diagnostic_information();
-      ILOG(Error, Ops) << "Unexpected exception in user code (check):"
-                       << diagnostic << ENDM;
-      continue;
-    }
-    auto commonActivity = activity_helpers::strictestMatchingActivity(
-      moMapToCheck | std::views::transform([](const std::pair<std::string, std::shared_ptr<MonitorObject>>& item) {
-        return item.second->getActivity();
-      }));
-    ILOG(Debug, Devel) << "Check '" << mCheckConfig.name << "', quality '" << quality << "'" << ENDM;
-    std::vector<std::string> monitorObjectsNames;
-    std::ranges::copy(moMapToCheck | std::views::keys, std::back_inserter(monitorObjectsNames));
-    // todo: take metadata from somewhere
-    qualityObjects.emplace_back(std::make_shared<QualityObject>(
-      quality,
-      mCheckConfig.name,
-      mCheckConfig.detectorName,
-      UpdatePolicyTypeUtils::ToString(mCheckConfig.policyType),
-      stringifyInput(mCheckConfig.inputSpecs),
-      monitorObjectsNames));
-    qualityObjects.back()->setActivity(commonActivity);
+  Quality quality;
+  try {
+    quality = mCheckInterface->check(&moMapToCheck);
+  } catch (...) {
+    std::string diagnostic = boost::current_exception_diagnostic_information();
+    ILOG(Error, Ops) << "Unexpected exception in user code (check):"
+                     << diagnostic << ENDM;
+    return nullptr;
+  }
+  auto commonActivity = activity_helpers::strictestMatchingActivity(
+    moMapToCheck | std::views::transform([](const std::pair<std::string, std::shared_ptr<MonitorObject>>& item) {
+      return item.second->getActivity();
+    }));
+  ILOG(Debug, Devel) << "Check '" << mCheckConfig.name << "', quality '" << quality << "'" << ENDM;
+  std::vector<std::string> monitorObjectsNames;
+  std::ranges::copy(moMapToCheck | std::views::keys, std::back_inserter(monitorObjectsNames));
+  // todo: take metadata from somewhere
+  auto qualityObject = std::make_shared<QualityObject>(
+    quality,
+    mCheckConfig.name,
+    mCheckConfig.detectorName,
+    UpdatePolicyTypeUtils::ToString(mCheckConfig.policyType),
+    stringifyInput(mCheckConfig.inputSpecs),
+    monitorObjectsNames);
+  qualityObject->setActivity(commonActivity);
+  if (withBeautify) {
     beautify(moMapToCheck, quality);
   }
 
-  return qualityObjects;
+  return qualityObject;
 }
 
 void Check::beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, const Quality& quality)
@@ -195,6 +209,11 @@ void Check::beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMa
   }
 }
 
+bool Check::isParallelEvaluationAllowed() const
+{
+  return mCheckConfig.parallelEvaluation;
+}
+
 UpdatePolicyType Check::getUpdatePolicyType() const
 {
   return mCheckConfig.policyType;
@@ -261,7 +280,8 @@ CheckConfig Check::extractConfig(const CommonSpec& commonSpec, const CheckSpec&
     allowBeautify,
     std::move(inputs),
     createOutputSpec(checkSpec.detectorName, checkSpec.checkName),
-    commonSpec.conditionDBUrl
+    commonSpec.conditionDBUrl,
+    checkSpec.parallelEvaluation
   };
 }
 
@@ -273,6 +293,7 @@ framework::OutputSpec Check::createOutputSpec(const std::string& detector, const
 void Check::startOfActivity(const core::Activity& activity)
 {
   if (mCheckInterface) {
+    mCheckInterface->resolveCustomParameters(activity);
     mCheckInterface->startOfActivity(activity);
   } else {
     throw std::runtime_error("Trying to start an Activity on an empty CheckInterface '" + mCheckConfig.name + "'");
@@ -26,9 +26,11 @@
 #include <Monitoring/Monitoring.h>
 #include <CommonUtils/ConfigurableParam.h>
 
+#include <algorithm>
 #include <utility>
 // QC
 #include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/AsyncDatabase.h"
 #include "QualityControl/ServiceDiscovery.h"
 #include "QualityControl/runnerUtils.h"
 #include "QualityControl/InfrastructureSpecReader.h"
@@ -37,8 +39,13 @@
 #include "QualityControl/ConfigParamGlo.h"
 #include "QualityControl/Bookkeeping.h"
 #include "QualityControl/WorkflowType.h"
+#include "QualityControl/ThreadPool.h"
+#include "QualityControl/RepoPathUtils.h"
+#include "QualityControl/ObjectMetadataKeys.h"
 
+#include <TObjString.h>
 #include <TSystem.h>
+#include <TROOT.h>
 
 using namespace std::chrono;
 using namespace AliceO2::Common;
@@ -187,6 +194,13 @@ void CheckRunner::init(framework::InitContext& iCtx)
     iCtx.services().get<CallbackService>().set<CallbackService::Id::Reset>([this]() { reset(); });
     iCtx.services().get<CallbackService>().set<CallbackService::Id::Stop>([this]() { stop(); });
 
+    if (mConfig.threads > 1) {
+      // the MOs are read by user code in the threads of the pool
+      ROOT::EnableThreadSafety();
+      mThreadPool = std::make_unique<ThreadPool>(mConfig.threads);
+      ILOG(Info, Devel) << "Checks will be evaluated in parallel with " << mConfig.threads << " threads" << ENDM;
+    }
+
     updatePolicyManager.reset();
     for (auto& [checkName, check] : mChecks) {
       check.init();
@@ -304,6 +318,34 @@ void CheckRunner::sendPeriodicMonitoring()
                        .addValue(rateQOs, "qos_per_second"));
     mCollector->send({ mTotalQOSent, "qc_checkrunner_qo_sent" });
     mCollector->send({ mTimerTotalDurationActivity.getTime(), "qc_checkrunner_duration" });
+    if (mAsyncDatabase) {
+      auto stats = mAsyncDatabase->getStatistics();
+      mCollector->send(Metric{ "qc_checkrunner_async_storage" }
+                         .addValue(stats.queueSize, "queue_size")
+                         .addValue(stats.stored, "stored")
+                         .addValue(stats.coalesced, "coalesced")
+                         .addValue(stats.dropped, "dropped")
+                         .addValue(stats.failed, "failed")
+                         .addValue(stats.skipped, "skipped")
+                         .addValue(stats.blockedSeconds, "blocked_seconds"));
+    }
+    if (auto compression = mDatabase->getCompressionStatistics(); compression.objects > 0) {
+      mCollector->send(Metric{ "qc_checkrunner_storage_compression" }
+                         .addValue(compression.objects, "objects")
+                         .addValue(compression.rawBytes, "raw_bytes")
+                         .addValue(compression.compressedBytes, "compressed_bytes")
+                         .addValue(static_cast<double>(compression.rawBytes) / std::max<uint64_t>(1, compression.compressedBytes), "ratio")
+                         .addValue(compression.seconds, "seconds"));
+    }
+    if (mServiceDiscovery) {
+      auto discovery = mServiceDiscovery->getStatistics();
+      mCollector->send(Metric{ "qc_checkrunner_service_discovery" }
+                         .addValue(discovery.registrations, "registrations")
+                         .addValue(discovery.failures, "failures")
+                         .addValue(discovery.unchanged, "unchanged")
+                         .addValue(discovery.lastLatency, "last_latency")
+                         .addValue(discovery.maxLatency, "max_latency"));
+    }
     mNumberQOStored = 0;
     mNumberMOStored = 0;
   }
@@ -314,6 +356,10 @@ QualityObjectsType CheckRunner::check()
   ILOG(Debug, Devel) << "Trying " << mChecks.size() << " checks for " << mMonitorObjects.size() << " monitor objects"
                      << ENDM;
 
+  if (mThreadPool) {
+    return checkInParallel();
+  }
+
   QualityObjectsType allQOs;
   for (auto& [checkName, check] : mChecks) {
     if (updatePolicyManager.isReady(check.getName())) {
@@ -333,6 +379,70 @@ QualityObjectsType CheckRunner::check()
   return allQOs;
 }
 
+QualityObjectsType CheckRunner::checkInParallel()
+{
+  // Each job evaluates one or more maps of MOs (one map per MO with OnEachSeparately), the results are put in
+  // dedicated slots, so that the order of the QOs is the same as in the sequential mode.
+  // Only the checks are run in parallel. They only read the MOs, while beautify() modifies them,
+  // so all the beautify() calls are done afterwards, sequentially, in the same order as in the sequential mode.
+  using MOMaps = std::vector<std::map<std::string, std::shared_ptr<MonitorObject>>>;
+  struct Job {
+    Check* check;
+    MOMaps moMaps;
+    std::vector<std::shared_ptr<QualityObject>> results;
+  };
+  std::vector<Job> jobs;
+
+  for (auto& [checkName, check] : mChecks) {
+    if (!updatePolicyManager.isReady(check.getName())) {
+      ILOG(Debug, Support) << "Monitor Objects for the check '" << checkName << "' are not ready, ignoring" << ENDM;
+      continue;
+    }
+    ILOG(Debug, Support) << "Monitor Objects for the check '" << checkName << "' are ready --> check()" << ENDM;
+    auto moMaps = check.prepareMapsToCheck(mMonitorObjects);
+    if (check.isParallelEvaluationAllowed()) {
+      for (auto& moMap : moMaps) {
+        jobs.push_back({ &check, { std::move(moMap) }, {} });
+      }
+    } else {
+      // the same CheckInterface must not be called concurrently, thus we evaluate all its maps in one job
+      jobs.push_back({ &check, std::move(moMaps), {} });
+    }
+    // Was checked, update latest revision
+    updatePolicyManager.updateActorRevision(checkName);
+  }
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(jobs.size());
+  for (auto& job : jobs) {
+    futures.emplace_back(mThreadPool->submit([&job]() {
+      for (auto& moMap : job.moMaps) {
+        job.results.emplace_back(job.check->checkSingle(moMap, false));
+      }
+    }));
+  }
+  // all the jobs have to be finished before anything is rethrown, since they refer to local variables
+  for (auto& future : futures) {
+    future.wait();
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  QualityObjectsType allQOs;
+  for (auto& job : jobs) {
+    for (size_t i = 0; i < job.results.size(); i++) {
+      auto& qo = job.results[i];
+      if (qo != nullptr) {
+        job.check->beautify(job.moMaps[i], qo->getQuality());
+        allQOs.emplace_back(std::move(qo));
+        mTotalNumberCheckExecuted++;
+      }
+    }
+  }
+  return allQOs;
+}
+
 void CheckRunner::store(QualityObjectsType& qualityObjects, long validFrom)
 {
   ILOG(Debug, Devel) << "Storing " << qualityObjects.size() << " QualityObjects" << ENDM;
@@ -355,12 +465,20 @@ void CheckRunner::store(std::vector<std::shared_ptr<MonitorObject>>& monitorObje
 {
   ILOG(Debug, Devel) << "Storing " << monitorObjects.size() << " MonitorObjects" << ENDM;
   try {
+    std::set<std::string> incompleteTasks; // a marker must not claim that all the MOs of these tasks are stored
     for (auto& mo : monitorObjects) {
       mDatabase->storeMO(mo);
+      if (!mDatabase->isLastObjectStored()) {
+        incompleteTasks.insert(publicationDirectory(*mo));
+        continue;
+      }
 
       mTotalNumberMOStored++;
       mNumberMOStored++;
     }
+    if (mConfig.publicationMarkers) {
+      storePublicationMarkers(monitorObjects, incompleteTasks);
+    }
     if (!monitorObjects.empty()) {
       auto& mo = monitorObjects.at(0);
       ILOG(Info, Devel) << "Validity of MO '" << mo->GetName() << "' is (" << mo->getValidity().getMin() << ", " << mo->getValidity().getMax() << ")" << ENDM;
@@ -370,6 +488,46 @@ void CheckRunner::store(std::vector<std::shared_ptr<MonitorObject>>& monitorObje
   }
 }
 
+std::string CheckRunner::publicationDirectory(const MonitorObject& mo)
+{
+  return RepoPathUtils::getMoPath(mo.getDetectorName(), mo.getTaskName(), "", mo.getActivity().mProvenance);
+}
+
+void CheckRunner::storePublicationMarkers(const std::vector<std::shared_ptr<MonitorObject>>& monitorObjects, const std::set<std::string>& incompleteTasks)
+{
+  struct TaskPublication {
+    std::shared_ptr<MonitorObject> firstObject;
+    std::vector<std::string> paths;
+  };
+  std::map<std::string, TaskPublication> publications; // per task directory
+  for (const auto& mo : monitorObjects) {
+    auto taskDirectory = publicationDirectory(*mo);
+    if (incompleteTasks.count(taskDirectory) > 0) {
+      continue;
+    }
+    auto& publication = publications[taskDirectory];
+    if (publication.firstObject == nullptr) {
+      publication.firstObject = mo;
+    }
+    publication.paths.push_back(mo->getPath());
+  }
+
+  for (auto& [taskPath, publication] : publications) {
+    const auto& mo = publication.firstObject;
+    auto marker = std::make_shared<MonitorObject>(new TObjString(RepoPathUtils::publicationMarkerName), mo->getTaskName(), mo->getTaskClass(), mo->getDetectorName());
+    marker->setIsOwner(true);
+    // the same activity as the MOs, so that the marker is found with the same metadata filters
+    marker->setActivity(mo->getActivity());
+    marker->setValidity(mo->getValidity());
+    marker->addMetadata(repository::metadata_keys::qcPublishedObjects, std::to_string(publication.paths.size()));
+    if (mAsyncDatabase) {
+      mAsyncDatabase->storeMOAfter(marker, std::move(publication.paths));
+    } else {
+      mDatabase->storeMO(marker);
+    }
+  }
+}
+
 void CheckRunner::send(QualityObjectsType& qualityObjects, framework::DataAllocator& allocator)
 {
   // Note that we might send multiple QOs in one output, as separate parts.
@@ -414,12 +572,20 @@ void CheckRunner::updateServiceDiscovery(const QualityObjectsType& qualityObject
     objects += path + ",";
   }
   objects.pop_back(); // remove last comma
-  mServiceDiscovery->_register(objects);
+  mServiceDiscovery->registerAsync(std::move(objects));
 }
 
 void CheckRunner::initDatabase()
 {
-  mDatabase = DatabaseFactory::create(mConfig.database.at("implementation"));
+  const auto& implementation = mConfig.database.at("implementation");
+  if (AsyncDatabase::isEnabled(mConfig.database)) {
+    auto asyncConfig = AsyncDatabase::Config::fromDatabaseConfig(mConfig.database);
+    mAsyncDatabase = std::make_shared<AsyncDatabase>([implementation]() { return DatabaseFactory::create(implementation); }, asyncConfig);
+    mDatabase = mAsyncDatabase;
+    ILOG(Info, Devel) << "Objects will be stored asynchronously with " << asyncConfig.workers << " worker(s) and a queue of " << asyncConfig.queueCapacity << " objects" << ENDM;
+  } else {
+    mDatabase = DatabaseFactory::create(implementation);
+  }
   mDatabase->connect(mConfig.database);
   ILOG(Info, Devel) << "Database that is going to be used > Implementation : " << mConfig.database.at("implementation") << " / Host : " << mConfig.database.at("host") << ENDM;
 }
@@ -458,6 +624,9 @@ void CheckRunner::initLibraries()
 void CheckRunner::endOfStream(framework::EndOfStreamContext& eosContext)
 {
   mReceivedEOS = true;
+  if (mAsyncDatabase) {
+    mAsyncDatabase->flush();
+  }
 }
 
 void CheckRunner::start(ServiceRegistryRef services)
@@ -490,6 +659,9 @@ void CheckRunner::stop()
   if (!mReceivedEOS) {
     ILOG(Warning, Devel) << "The STOP transition happened before an EndOfStream was received. The very last QC objects in this run might not have been stored." << ENDM;
   }
+  if (mAsyncDatabase) {
+    mAsyncDatabase->flush();
+  }
   for (auto& [checkName, check] : mChecks) {
     check.endOfActivity(*mActivity);
   }
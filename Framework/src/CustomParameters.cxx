@@ -14,11 +14,13 @@
 #include <iostream>
 #include <boost/property_tree/ptree.hpp>
 #include <string_view>
-#include <vector>
+#include <utility>
 
 namespace o2::quality_control::core
 {
 
+const std::string CustomParameters::sDefault = "default";
+
 std::ostream& operator<<(std::ostream& out, const CustomParameters& customParameters)
 {
   // todo: should we swallow the exceptions here ?
@@ -76,19 +78,15 @@ std::string CustomParameters::at(const std::string& key, const Activity& activit
 
 std::optional<std::string> CustomParameters::atOptional(const std::string& key, const std::string& runType, const std::string& beamType) const
 {
-  std::optional<std::string> result = std::nullopt;
-  const std::vector<std::string> runTypes = { runType, std::string("default") };
-  const std::vector<std::string> beamTypes = { beamType, std::string("default") };
-  for (const auto& rt : runTypes) {
-    for (const auto& bt : beamTypes) {
-      try {
-        result = mCustomParameters.at(rt).at(bt).at(key);
-        return result;
-      } catch (const std::out_of_range& exc) { // ignored on purpose
+  // same order of substitution with "default" as in getAllResolved
+  for (const auto* rt : { &runType, &sDefault }) {
+    for (const auto* bt : { &beamType, &sDefault }) {
+      if (auto it = find(key, *rt, *bt); it != end()) {
+        return it->second;
       }
     }
   }
-  return result;
+  return std::nullopt;
 }
 
 std::optional<std::string> CustomParameters::atOptional(const std::string& key, const Activity& activity) const
@@ -98,30 +96,20 @@ std::optional<std::string> CustomParameters::atOptional(const std::string& key,
 
 std::string CustomParameters::atOrDefaultValue(const std::string& key, std::string defaultValue, const std::string& runType, const std::string& beamType) const
 {
-  try {
-    return mCustomParameters.at(runType).at(beamType).at(key);
-  } catch (const std::out_of_range& exc) {
-    return defaultValue;
+  if (auto it = find(key, runType, beamType); it != end()) {
+    return it->second;
   }
+  return defaultValue;
 }
 
 std::string CustomParameters::atOrDefaultValue(const std::string& key, std::string defaultValue, const Activity& activity) const
 {
-  try {
-    return mCustomParameters.at(activity.mType).at(activity.mBeamType).at(key);
-  } catch (const std::out_of_range& exc) {
-    return defaultValue;
-  }
+  return atOrDefaultValue(key, std::move(defaultValue), activity.mType, activity.mBeamType);
 }
 
 int CustomParameters::count(const std::string& key, const std::string& runType, const std::string& beamType) const
 {
-  try {
-    at(key, runType, beamType);
-  } catch (const std::out_of_range& oor) {
-    return 0;
-  }
-  return 1;
+  return atOptional(key, runType, beamType).has_value() ? 1 : 0;
 }
 
 std::unordered_map<std::string, std::string>::const_iterator CustomParameters::find(const std::string& key, const std::string& runType, const std::string& beamType) const
@@ -141,6 +129,28 @@ std::unordered_map<std::string, std::string>::const_iterator CustomParameters::f
   return foundValue;
 }
 
+std::unordered_map<std::string, std::string> CustomParameters::getAllResolved(const std::string& runType, const std::string& beamType) const
+{
+  std::unordered_map<std::string, std::string> result;
+  // from the lowest to the highest precedence, the more specific values overwrite the defaults
+  for (const auto* rt : { &sDefault, &runType }) {
+    for (const auto* bt : { &sDefault, &beamType }) {
+      auto subTreeRunType = mCustomParameters.find(*rt);
+      if (subTreeRunType == mCustomParameters.end()) {
+        continue;
+      }
+      auto subTreeBeamType = subTreeRunType->second.find(*bt);
+      if (subTreeBeamType == subTreeRunType->second.end()) {
+        continue;
+      }
+      for (const auto& [key, value] : subTreeBeamType->second) {
+        result[key] = value;
+      }
+    }
+  }
+  return result;
+}
+
 std::unordered_map<std::string, std::string>::const_iterator CustomParameters::end() const
 {
   return mCustomParameters.at("null").at("null").end();
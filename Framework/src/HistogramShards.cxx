@@ -0,0 +1,128 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    HistogramShards.cxx
+///
+
+#include "QualityControl/HistogramShards.h"
+
+#include <TH1.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace o2::quality_control::core
+{
+
+HistogramShards::HistogramShards(size_t shards)
+{
+  setNumberOfShards(shards);
+}
+
+HistogramShards::~HistogramShards() = default;
+
+void HistogramShards::setNumberOfShards(size_t shards)
+{
+  mShards.clear();
+  mShards.resize(std::max<size_t>(1, shards));
+  if (mShards.size() == 1) {
+    return;
+  }
+  for (auto& shard : mShards) {
+    shard.reserve(mHistograms.size());
+    for (const auto* histogram : mHistograms) {
+      shard.push_back({ createCopy(histogram), false });
+    }
+  }
+}
+
+void HistogramShards::add(TH1* histogram)
+{
+  if (histogram == nullptr) {
+    throw std::invalid_argument("HistogramShards: a null histogram cannot be added");
+  }
+  if (mIndices.count(histogram) > 0) {
+    return;
+  }
+  mIndices.emplace(histogram, mHistograms.size());
+  mHistograms.push_back(histogram);
+  if (mShards.size() == 1) {
+    return;
+  }
+  for (auto& shard : mShards) {
+    shard.push_back({ createCopy(histogram), false });
+  }
+}
+
+TH1* HistogramShards::getImpl(TH1* histogram, size_t shard)
+{
+  if (mShards.size() == 1 && shard == 0) {
+    return histogram;
+  }
+  auto index = mIndices.find(histogram);
+  if (index == mIndices.end() || shard >= mShards.size()) {
+    throw std::out_of_range(std::string("HistogramShards: the histogram '") + (histogram ? histogram->GetName() : "null") +
+                            "' is not registered or the shard " + std::to_string(shard) + " does not exist");
+  }
+  auto& copy = mShards[shard][index->second];
+  copy.filled = true;
+  return copy.histogram.get();
+}
+
+void HistogramShards::merge()
+{
+  if (mShards.size() == 1) {
+    return;
+  }
+  for (auto& shard : mShards) {
+    for (size_t i = 0; i < shard.size(); i++) {
+      auto& copy = shard[i];
+      if (!copy.filled) {
+        continue;
+      }
+      mHistograms[i]->Add(copy.histogram.get());
+      copy.histogram->Reset();
+      copy.filled = false;
+    }
+  }
+}
+
+void HistogramShards::reset()
+{
+  for (auto& shard : mShards) {
+    for (auto& copy : shard) {
+      if (copy.filled) {
+        copy.histogram->Reset();
+        copy.filled = false;
+      }
+    }
+  }
+}
+
+void HistogramShards::clear()
+{
+  mHistograms.clear();
+  mIndices.clear();
+  for (auto& shard : mShards) {
+    shard.clear();
+  }
+}
+
+std::unique_ptr<TH1> HistogramShards::createCopy(const TH1* histogram) const
+{
+  std::unique_ptr<TH1> copy(dynamic_cast<TH1*>(histogram->Clone()));
+  copy->SetDirectory(nullptr);
+  copy->Reset();
+  return copy;
+}
+
+} // namespace o2::quality_control::core
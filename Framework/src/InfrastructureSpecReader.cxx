@@ -22,6 +22,7 @@
 
 #include <DataSampling/DataSampling.h>
 #include <Framework/DataDescriptorQueryBuilder.h>
+#include <boost/algorithm/string/predicate.hpp>
 
 using namespace o2::utilities;
 using namespace o2::framework;
@@ -31,6 +32,31 @@ using namespace o2::quality_control::checker;
 namespace o2::quality_control::core
 {
 
+namespace
+{
+// Tells whether any active post-processing task waits for new objects in the QCDB, which rely on publication markers.
+bool hasQcdbNewObjectTriggers(const boost::property_tree::ptree& wholeTree, const std::vector<PostProcessingTaskSpec>& postProcessingTasks)
+{
+  for (const auto& ppTaskSpec : postProcessingTasks) {
+    if (!ppTaskSpec.active) {
+      continue;
+    }
+    for (const auto& triggerKey : { "initTrigger", "updateTrigger", "stopTrigger" }) {
+      const auto triggers = wholeTree.get_child_optional("qc.postprocessing." + ppTaskSpec.id + "." + triggerKey);
+      if (!triggers) {
+        continue;
+      }
+      for (const auto& [_, trigger] : *triggers) {
+        if (boost::algorithm::istarts_with(trigger.get_value<std::string>(), "newobject:qcdb")) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+} // namespace
+
 InfrastructureSpec InfrastructureSpecReader::readInfrastructureSpec(const boost::property_tree::ptree& wholeTree, WorkflowType workflowType)
 {
   InfrastructureSpec spec;
@@ -48,6 +74,11 @@ InfrastructureSpec InfrastructureSpecReader::readInfrastructureSpec(const boost:
   spec.postProcessingTasks = readSectionSpec<PostProcessingTaskSpec>(wholeTree, "postprocessing");
   spec.externalTasks = readSectionSpec<ExternalTaskSpec>(wholeTree, "externalTasks");
 
+  // Unless configured explicitly, the publication markers are stored only if they are needed by a trigger of this setup.
+  if (!qcTree.get_optional<bool>("config.checkRunner.publicationMarkers")) {
+    spec.common.checkRunnerPublicationMarkers = hasQcdbNewObjectTriggers(wholeTree, spec.postProcessingTasks);
+  }
+
   return spec;
 }
 
@@ -81,6 +112,8 @@ CommonSpec InfrastructureSpecReader::readSpecEntry<CommonSpec>(const std::string
   };
   spec.postprocessingPeriod = commonTree.get<double>("postprocessing.periodSeconds", spec.postprocessingPeriod);
   spec.bookkeepingUrl = commonTree.get<std::string>("bookkeeping.url", spec.bookkeepingUrl);
+  spec.checkRunnerThreads = commonTree.get<size_t>("checkRunner.threads", spec.checkRunnerThreads);
+  spec.checkRunnerPublicationMarkers = commonTree.get<bool>("checkRunner.publicationMarkers", spec.checkRunnerPublicationMarkers);
 
   return spec;
 }
@@ -122,6 +155,8 @@ TaskSpec InfrastructureSpecReader::readSpecEntry<TaskSpec>(const std::string& ta
   ts.maxNumberCycles = taskTree.get<int>("maxNumberCycles", ts.maxNumberCycles);
   ts.resetAfterCycles = taskTree.get<size_t>("resetAfterCycles", ts.resetAfterCycles);
   ts.saveObjectsToFile = taskTree.get<std::string>("saveObjectsToFile", ts.saveObjectsToFile);
+  ts.publishUpdatedObjectsOnly = taskTree.get<bool>("publishUpdatedObjectsOnly", ts.publishUpdatedObjectsOnly);
+  ts.fullPublicationCycles = taskTree.get<int>("fullPublicationCycles", ts.fullPublicationCycles);
   if (taskTree.count("extendedTaskParameters") > 0 && taskTree.count("taskParameters") > 0) {
     ILOG(Warning, Devel) << "Both taskParameters and extendedTaskParameters are defined in the QC config file. We will use only extendedTaskParameters. " << ENDM;
   }
@@ -322,6 +357,7 @@ CheckSpec InfrastructureSpecReader::readSpecEntry<CheckSpec>(const std::string&
 
   cs.active = checkTree.get<bool>("active", cs.active);
   cs.exportToBookkeeping = checkTree.get<bool>("exportToBookkeeping", cs.exportToBookkeeping);
+  cs.parallelEvaluation = checkTree.get<bool>("parallelEvaluation", cs.parallelEvaluation);
 
   if (checkTree.count("extendedCheckParameters") > 0) {
     cs.customParameters.populateCustomParameters(checkTree.get_child("extendedCheckParameters"));
@@ -20,6 +20,7 @@
 
 #include <Mergers/MergerAlgorithm.h>
 #include <TNamed.h>
+#include <cstring>
 
 using namespace o2::mergers;
 
@@ -115,6 +116,71 @@ void MonitorObjectCollection::postDeserialization()
   }
   this->SetOwner(true);
   delete it;
+  rebuildIndex();
+}
+
+TObject* MonitorObjectCollection::FindObject(const char* name) const
+{
+  if (name == nullptr) {
+    return nullptr;
+  }
+  if (mIndexedEntries != GetEntriesFast()) {
+    rebuildIndex();
+  }
+  auto it = mIndex.find(name);
+  if (it != mIndex.end()) {
+    auto* object = UncheckedAt(it->second);
+    if (object != nullptr && std::strcmp(object->GetName(), name) == 0) {
+      return object;
+    }
+  }
+  // The objects could have been moved, removed, replaced or renamed by means we do not track,
+  // e.g. Sort(), RemoveAt() or SetName() of an object which is already in the collection.
+  rebuildIndex();
+  it = mIndex.find(name);
+  return it == mIndex.end() ? nullptr : UncheckedAt(it->second);
+}
+
+void MonitorObjectCollection::AddLast(TObject* obj)
+{
+  bool indexValid = mIndexedEntries == GetEntriesFast();
+  TObjArray::AddLast(obj);
+  if (indexValid && obj != nullptr) {
+    mIndex.try_emplace(obj->GetName(), GetLast());
+    mIndexedEntries = GetEntriesFast();
+  } else {
+    mIndexedEntries = -1;
+  }
+}
+
+void MonitorObjectCollection::AddFirst(TObject* obj)
+{
+  TObjArray::AddFirst(obj);
+  mIndexedEntries = -1;
+}
+
+void MonitorObjectCollection::AddAt(TObject* obj, Int_t idx)
+{
+  TObjArray::AddAt(obj, idx);
+  mIndexedEntries = -1;
+}
+
+void MonitorObjectCollection::AddAtAndExpand(TObject* obj, Int_t idx)
+{
+  TObjArray::AddAtAndExpand(obj, idx);
+  mIndexedEntries = -1;
+}
+
+void MonitorObjectCollection::rebuildIndex() const
+{
+  mIndex.clear();
+  mIndex.reserve(GetEntriesFast());
+  for (Int_t i = 0; i < GetEntriesFast(); i++) {
+    if (auto* object = UncheckedAt(i); object != nullptr) {
+      mIndex.try_emplace(object->GetName(), i);
+    }
+  }
+  mIndexedEntries = GetEntriesFast();
 }
 
 void MonitorObjectCollection::setDetector(const std::string& detector)
@@ -0,0 +1,360 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ObjectCache.cxx
+///
+
+#include "QualityControl/ObjectCache.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TBufferFile.h>
+#include <TH1.h>
+#include <TObject.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace o2::quality_control::repository
+{
+
+namespace
+{
+constexpr char fileMagic[] = "QCOBJC01";
+constexpr size_t fileMagicSize = sizeof(fileMagic) - 1;
+constexpr auto fileExtension = ".qcobj";
+
+void writeString(std::ostream& out, const std::string& string)
+{
+  uint64_t size = string.size();
+  out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  out.write(string.data(), string.size());
+}
+
+bool readString(std::istream& in, std::string& string)
+{
+  uint64_t size = 0;
+  if (!in.read(reinterpret_cast<char*>(&size), sizeof(size)) || size > (1ull << 32)) {
+    return false;
+  }
+  string.resize(size);
+  return static_cast<bool>(in.read(string.data(), size));
+}
+
+// histograms should not be attached to whichever directory is current when they are copied or deserialized
+void detachFromDirectory(TObject* object)
+{
+  if (auto* histogram = dynamic_cast<TH1*>(object)) {
+    histogram->SetDirectory(nullptr);
+  }
+}
+
+bool isTrue(const std::string& value)
+{
+  return value == "true" || value == "1";
+}
+} // namespace
+
+ObjectCache::Config ObjectCache::Config::fromDatabaseConfig(const std::unordered_map<std::string, std::string>& databaseConfig)
+{
+  Config config;
+  if (auto it = databaseConfig.find("objectCacheDirectory"); it != databaseConfig.end()) {
+    config.directory = it->second;
+  }
+  if (auto it = databaseConfig.find("objectCacheMaxSizeMB"); it != databaseConfig.end() && !it->second.empty()) {
+    config.maxDiskBytes = std::stoull(it->second) << 20;
+  }
+  if (auto it = databaseConfig.find("objectCacheMemoryEntries"); it != databaseConfig.end() && !it->second.empty()) {
+    config.memoryEntries = std::stoull(it->second);
+  }
+  return config;
+}
+
+bool ObjectCache::isEnabled(const std::unordered_map<std::string, std::string>& databaseConfig)
+{
+  auto it = databaseConfig.find("objectCache");
+  return it != databaseConfig.end() && isTrue(it->second);
+}
+
+std::shared_ptr<ObjectCache> ObjectCache::getShared(const Config& config)
+{
+  static std::mutex registryMutex;
+  static std::unordered_map<std::string, std::weak_ptr<ObjectCache>> registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  auto& entry = registry[config.directory];
+  auto cache = entry.lock();
+  if (cache == nullptr) {
+    cache = std::make_shared<ObjectCache>(config);
+    entry = cache;
+  }
+  return cache;
+}
+
+ObjectCache::ObjectCache(Config config) : mConfig(std::move(config))
+{
+  if (!mConfig.directory.empty()) {
+    std::error_code ec;
+    fs::create_directories(mConfig.directory, ec);
+    if (ec) {
+      ILOG(Warning, Support) << "Could not create the object cache directory '" << mConfig.directory << "' (" << ec.message() << "), the disk cache is disabled" << ENDM;
+      mConfig.directory.clear();
+    } else {
+      scanDirectory();
+    }
+  }
+  ILOG(Info, Devel) << "Object cache created with " << mConfig.memoryEntries << " entries in memory"
+                    << (mConfig.directory.empty() ? std::string() : " and up to " + std::to_string(mConfig.maxDiskBytes >> 20) + "MB in '" + mConfig.directory + "'") << ENDM;
+}
+
+ObjectCache::~ObjectCache() = default;
+
+std::optional<ObjectCache::Entry> ObjectCache::get(const std::string& key)
+{
+  std::shared_ptr<const TObject> cached;
+  std::map<std::string, std::string> headers;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (auto it = mMemoryIndex.find(key); it != mMemoryIndex.end()) {
+      mMemoryEntries.splice(mMemoryEntries.begin(), mMemoryEntries, it->second);
+      cached = it->second->object;
+      headers = it->second->headers;
+      mStatistics.memoryHits++;
+    }
+  }
+  if (cached) {
+    Entry entry{ std::unique_ptr<TObject>(cached->Clone()), std::move(headers) };
+    detachFromDirectory(entry.object.get());
+    return entry;
+  }
+
+  auto entry = readFromDisk(key);
+  if (!entry.has_value()) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStatistics.misses++;
+    return std::nullopt;
+  }
+  std::shared_ptr<const TObject> copy;
+  if (mConfig.memoryEntries > 0) {
+    copy.reset(entry->object->Clone());
+    detachFromDirectory(const_cast<TObject*>(copy.get()));
+  }
+  std::lock_guard<std::mutex> lock(mMutex);
+  mStatistics.diskHits++;
+  if (copy) {
+    putInMemory(key, std::move(copy), entry->headers);
+  }
+  return entry;
+}
+
+void ObjectCache::put(const std::string& key, const TObject& object, const std::map<std::string, std::string>& headers)
+{
+  if (mConfig.memoryEntries > 0) {
+    std::shared_ptr<const TObject> copy(object.Clone());
+    detachFromDirectory(const_cast<TObject*>(copy.get()));
+    std::lock_guard<std::mutex> lock(mMutex);
+    putInMemory(key, std::move(copy), headers);
+  }
+  if (!mConfig.directory.empty()) {
+    writeToDisk(key, object, headers);
+  }
+}
+
+ObjectCache::Statistics ObjectCache::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mStatistics;
+}
+
+void ObjectCache::putInMemory(const std::string& key, std::shared_ptr<const TObject> object, const std::map<std::string, std::string>& headers)
+{
+  if (auto it = mMemoryIndex.find(key); it != mMemoryIndex.end()) {
+    mMemoryEntries.erase(it->second);
+    mMemoryIndex.erase(it);
+  }
+  mMemoryEntries.push_front({ key, std::move(object), headers });
+  mMemoryIndex[key] = mMemoryEntries.begin();
+  while (mMemoryEntries.size() > mConfig.memoryEntries) {
+    mMemoryIndex.erase(mMemoryEntries.back().key);
+    mMemoryEntries.pop_back();
+  }
+}
+
+std::string ObjectCache::fileNameForKey(const std::string& key)
+{
+  // FNV-1a is used instead of std::hash<std::string> to have the same file names in all the processes and builds.
+  // Collisions are harmless, because the full key is stored in the file and compared when reading it.
+  uint64_t hash = 14695981039346656037ull;
+  for (unsigned char c : key) {
+    hash = (hash ^ c) * 1099511628211ull;
+  }
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash << fileExtension;
+  return ss.str();
+}
+
+std::optional<ObjectCache::Entry> ObjectCache::readFromDisk(const std::string& key)
+{
+  if (mConfig.directory.empty()) {
+    return std::nullopt;
+  }
+  const auto fileName = fileNameForKey(key);
+  const auto filePath = fs::path(mConfig.directory) / fileName;
+
+  // the file might have been written by another process sharing the directory, thus we always look at the disk
+  std::ifstream in(filePath, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+  char magic[fileMagicSize];
+  std::string storedKey;
+  uint64_t numberOfHeaders = 0;
+  if (!in.read(magic, fileMagicSize) || std::memcmp(magic, fileMagic, fileMagicSize) != 0 || !readString(in, storedKey) || storedKey != key || !in.read(reinterpret_cast<char*>(&numberOfHeaders), sizeof(numberOfHeaders))) {
+    return std::nullopt;
+  }
+  Entry entry;
+  for (uint64_t i = 0; i < numberOfHeaders; i++) {
+    std::string name, value;
+    if (!readString(in, name) || !readString(in, value)) {
+      return std::nullopt;
+    }
+    entry.headers.emplace(std::move(name), std::move(value));
+  }
+  std::string payload;
+  if (!readString(in, payload)) {
+    return std::nullopt;
+  }
+  in.close();
+
+  TBufferFile buffer(TBuffer::kRead, payload.size(), payload.data(), false);
+  entry.object.reset(buffer.ReadObject(TObject::Class()));
+  if (entry.object == nullptr) {
+    ILOG(Warning, Support) << "Could not deserialize the cached object in '" << filePath.string() << "'" << ENDM;
+    return std::nullopt;
+  }
+  detachFromDirectory(entry.object.get());
+
+  std::error_code ec;
+  fs::last_write_time(filePath, fs::file_time_type::clock::now(), ec);
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (auto it = mDiskIndex.find(fileName); it != mDiskIndex.end()) {
+    mDiskEntries.splice(mDiskEntries.begin(), mDiskEntries, it->second);
+  } else {
+    auto size = fs::file_size(filePath, ec);
+    mDiskEntries.push_front({ fileName, ec ? 0 : size });
+    mDiskIndex[fileName] = mDiskEntries.begin();
+    mStatistics.diskBytes += mDiskEntries.front().size;
+    evictFromDisk();
+  }
+  return entry;
+}
+
+void ObjectCache::writeToDisk(const std::string& key, const TObject& object, const std::map<std::string, std::string>& headers)
+{
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(&object);
+
+  const auto fileName = fileNameForKey(key);
+  const auto filePath = fs::path(mConfig.directory) / fileName;
+  // written to a temporary file first, so that nobody reads an incomplete file
+  std::stringstream tmpName;
+  tmpName << fileName << ".tmp." << std::this_thread::get_id() << "." << this;
+  const auto tmpPath = fs::path(mConfig.directory) / tmpName.str();
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    out.write(fileMagic, fileMagicSize);
+    writeString(out, key);
+    uint64_t numberOfHeaders = headers.size();
+    out.write(reinterpret_cast<const char*>(&numberOfHeaders), sizeof(numberOfHeaders));
+    for (const auto& [name, value] : headers) {
+      writeString(out, name);
+      writeString(out, value);
+    }
+    writeString(out, std::string(buffer.Buffer(), buffer.Length()));
+    if (!out) {
+      ILOG(Warning, Support) << "Could not write the cached object '" << key << "' to '" << tmpPath.string() << "'" << ENDM;
+      out.close();
+      std::error_code ec;
+      fs::remove(tmpPath, ec);
+      return;
+    }
+  }
+  std::error_code ec;
+  fs::rename(tmpPath, filePath, ec);
+  if (ec) {
+    ILOG(Warning, Support) << "Could not move the cached object to '" << filePath.string() << "': " << ec.message() << ENDM;
+    fs::remove(tmpPath, ec);
+    return;
+  }
+  auto size = fs::file_size(filePath, ec);
+  if (ec) {
+    size = 0;
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (auto it = mDiskIndex.find(fileName); it != mDiskIndex.end()) {
+    mStatistics.diskBytes -= it->second->size;
+    mDiskEntries.erase(it->second);
+  }
+  mDiskEntries.push_front({ fileName, size });
+  mDiskIndex[fileName] = mDiskEntries.begin();
+  mStatistics.diskBytes += size;
+  evictFromDisk();
+}
+
+void ObjectCache::scanDirectory()
+{
+  std::vector<std::pair<fs::file_time_type, DiskEntry>> files;
+  std::error_code ec;
+  for (const auto& file : fs::directory_iterator(mConfig.directory, ec)) {
+    if (!file.is_regular_file(ec) || file.path().extension() != fileExtension) {
+      continue;
+    }
+    auto size = file.file_size(ec);
+    auto time = file.last_write_time(ec);
+    if (!ec) {
+      files.push_back({ time, { file.path().filename().string(), size } });
+    }
+  }
+  std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (auto& [time, entry] : files) {
+    mStatistics.diskBytes += entry.size;
+    mDiskEntries.push_back(std::move(entry));
+    mDiskIndex[mDiskEntries.back().fileName] = std::prev(mDiskEntries.end());
+  }
+  evictFromDisk();
+}
+
+void ObjectCache::evictFromDisk()
+{
+  // the most recent entry is kept in any case, even if it is alone bigger than the limit
+  while (mStatistics.diskBytes > mConfig.maxDiskBytes && mDiskEntries.size() > 1) {
+    const auto& oldest = mDiskEntries.back();
+    std::error_code ec;
+    fs::remove(fs::path(mConfig.directory) / oldest.fileName, ec);
+    mStatistics.diskBytes -= oldest.size;
+    mStatistics.evictions++;
+    mDiskIndex.erase(oldest.fileName);
+    mDiskEntries.pop_back();
+  }
+}
+
+} // namespace o2::quality_control::repository
@@ -0,0 +1,173 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    ObjectListingPoller.cxx
+///
+
+#include "QualityControl/ObjectListingPoller.h"
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/ObjectMetadataKeys.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+using namespace std::chrono;
+using namespace o2::quality_control::repository;
+
+namespace o2::quality_control::postprocessing
+{
+
+namespace
+{
+// Objects in the same directory are listed together. Objects at the top level are listed alone,
+// we do not want to list the whole database. Returns the directory and the object name, the latter empty at the top level.
+std::pair<std::string, std::string> splitPath(const std::string& objectPath)
+{
+  auto lastSlash = objectPath.find_last_of('/');
+  if (lastSlash == std::string::npos || lastSlash == 0) {
+    return { objectPath, "" };
+  }
+  return { objectPath.substr(0, lastSlash), objectPath.substr(lastSlash + 1) };
+}
+
+std::string escapeRegex(const std::string& text)
+{
+  std::string escaped;
+  for (char c : text) {
+    if (std::string_view("\\^$.|?*+()[]{}").find(c) != std::string_view::npos) {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+// The CCDB returns the latest version of each object matching the pattern, which is a regular expression.
+// Only the requested objects are listed, so that the cost does not depend on the other objects in the directory.
+// A single object is listed by its path, as a trigger watching it alone would do.
+std::string createPathPattern(const std::string& directory, const std::set<std::string>& objectNames)
+{
+  if (objectNames.size() == 1) {
+    const auto& name = *objectNames.begin();
+    return name.empty() ? directory : directory + "/" + name;
+  }
+  std::string pattern = escapeRegex(directory) + "/(";
+  for (auto it = objectNames.begin(); it != objectNames.end(); ++it) {
+    pattern += (it == objectNames.begin() ? "" : "|") + escapeRegex(*it);
+  }
+  return pattern + ")";
+}
+} // namespace
+
+ObjectListingPoller::ObjectListingPoller(ListingFcn listingFcn, std::string databaseUrl)
+  : mListingFcn(std::move(listingFcn)), mDatabaseUrl(std::move(databaseUrl))
+{
+}
+
+ObjectListingPoller::~ObjectListingPoller()
+{
+  if (mStatistics.listings > 0) {
+    ILOG(Info, Devel) << "Object listing poller for '" << mDatabaseUrl << "' made " << mStatistics.listings << " listings ("
+                      << mStatistics.failedListings << " failed) for " << mStatistics.requests << " requests, average listing time "
+                      << mStatistics.totalListingSeconds / mStatistics.listings << "s, maximum " << mStatistics.maxListingSeconds << "s" << ENDM;
+  }
+}
+
+std::shared_ptr<ObjectListingPoller> ObjectListingPoller::getShared(const std::string& databaseUrl)
+{
+  static std::mutex registryMutex;
+  static std::unordered_map<std::string, std::weak_ptr<ObjectListingPoller>> registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  auto& entry = registry[databaseUrl];
+  auto poller = entry.lock();
+  if (poller == nullptr) {
+    // We support only CCDB here.
+    auto db = std::make_shared<CcdbDatabase>();
+    db->connect(databaseUrl, "", "", "");
+    poller = std::make_shared<ObjectListingPoller>(
+      [db](const std::string& pathPattern, const std::map<std::string, std::string>& metadata) {
+        auto listing = db->getListingAsPtree(pathPattern, metadata, true);
+        if (listing.count("objects") == 0) {
+          throw std::runtime_error("no 'objects' in the listing");
+        }
+        return listing.get_child("objects");
+      },
+      databaseUrl);
+    entry = poller;
+  }
+  return poller;
+}
+
+std::optional<boost::property_tree::ptree> ObjectListingPoller::getLatest(const std::string& objectPath, const std::map<std::string, std::string>& metadata,
+                                                                          steady_clock::duration maxAge)
+{
+  auto [directory, objectName] = splitPath(objectPath);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  mStatistics.requests++;
+  auto& group = mGroups[{ directory, metadata }];
+  // an object requested for the first time is not in the previous listing, so we have to list again
+  bool newObject = group.objectNames.insert(objectName).second;
+  if (newObject || !group.lastListing.has_value() || steady_clock::now() - group.lastListing.value() >= maxAge) {
+    group.pathPattern = createPathPattern(directory, group.objectNames);
+    group.metadata = metadata;
+    list(group);
+  }
+
+  if (!group.listingValid) {
+    return std::nullopt;
+  }
+  if (auto it = group.latestObjects.find(objectPath); it != group.latestObjects.end()) {
+    return it->second;
+  }
+  return boost::property_tree::ptree{};
+}
+
+ObjectListingPoller::Statistics ObjectListingPoller::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mStatistics;
+}
+
+void ObjectListingPoller::list(Group& group)
+{
+  auto start = steady_clock::now();
+  group.lastListing = start;
+  group.latestObjects.clear();
+  try {
+    auto objects = mListingFcn(group.pathPattern, group.metadata);
+    for (auto& [_, object] : objects) {
+      auto path = object.get<std::string>("path", "");
+      auto [it, inserted] = group.latestObjects.try_emplace(path, object);
+      // just in case several versions of the same object are listed
+      if (!inserted && it->second.get<uint64_t>(metadata_keys::lastModified, 0) < object.get<uint64_t>(metadata_keys::lastModified, 0)) {
+        it->second = std::move(object);
+      }
+    }
+    group.listingValid = true;
+  } catch (const std::exception& ex) {
+    ILOG(Warning, Support) << "Could not get a valid listing from db '" << mDatabaseUrl << "' for '" << group.pathPattern << "': " << ex.what() << ENDM;
+    group.listingValid = false;
+    mStatistics.failedListings++;
+  }
+
+  double duration = duration_cast<std::chrono::duration<double>>(steady_clock::now() - start).count();
+  mStatistics.listings++;
+  mStatistics.totalListingSeconds += duration;
+  mStatistics.maxListingSeconds = std::max(mStatistics.maxListingSeconds, duration);
+  ILOG(Debug, Trace) << "Listed " << group.latestObjects.size() << " objects in '" << group.pathPattern << "' in " << duration << "s" << ENDM;
+}
+
+} // namespace o2::quality_control::postprocessing
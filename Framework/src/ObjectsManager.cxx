@@ -21,6 +21,7 @@
 #include "QualityControl/MonitorObjectCollection.h"
 #include <Common/Exceptions.h>
 #include <TObjArray.h>
+#include <TH1.h>
 
 #include <utility>
 #include <algorithm>
@@ -67,9 +68,13 @@ void ObjectsManager::startPublishingImpl(TObject* object, PublicationPolicy publ
     return;
   }
 
-  if (mMonitorObjects->FindObject(object->GetName()) != nullptr) {
+  if (auto entry = mObjectsByAddress.find(object); entry != mObjectsByAddress.end()) {
     ILOG(Warning, Support) << "Object is already being published (" << object->GetName() << "), will remove it and add the new one" << ENDM;
-    stopPublishing(object->GetName());
+    unregister(entry);
+  }
+  if (auto sameName = mObjectsByName.find(object->GetName()); sameName != mObjectsByName.end()) {
+    ILOG(Warning, Support) << "Object is already being published (" << object->GetName() << "), will remove it and add the new one" << ENDM;
+    unregister(mObjectsByAddress.find(sameName->second));
   }
 
   if (!ignoreMergeableWarning && !mergers::isMergeable(object)) {
@@ -81,10 +86,39 @@ void ObjectsManager::startPublishingImpl(TObject* object, PublicationPolicy publ
   newObject->setActivity(mActivity);
   newObject->setCreateMovingWindow(std::find(mMovingWindowsList.begin(), mMovingWindowsList.end(), object->GetName()) != mMovingWindowsList.end());
   mMonitorObjects->Add(newObject);
+  mObjectsByAddress.emplace(object, RegisteredObject{ newObject, object->GetName(), mMonitorObjects->GetLast() });
+  mObjectsByName.emplace(object->GetName(), object);
   mUpdateServiceDiscovery = true;
   mPublicationPoliciesForMOs[newObject] = publicationPolicy;
 }
 
+void ObjectsManager::unregister(Registry::iterator entry)
+{
+  auto* mo = entry->second.mo;
+  mPublicationPoliciesForMOs.erase(mo);
+  mMonitorObjects->RemoveAt(entry->second.slot);
+  mObjectsByName.erase(entry->second.name);
+  mObjectsByAddress.erase(entry);
+  delete mo;
+
+  // compacting only when the empty slots outnumber the objects keeps the cost of removals constant on average
+  if (mMonitorObjects->GetEntriesFast() > 2 * static_cast<int>(mObjectsByAddress.size()) + 16) {
+    compact();
+  }
+}
+
+void ObjectsManager::compact()
+{
+  if (mMonitorObjects->GetEntriesFast() == static_cast<int>(mObjectsByAddress.size())) {
+    return;
+  }
+  mMonitorObjects->Compress();
+  for (int slot = 0; slot < mMonitorObjects->GetEntriesFast(); slot++) {
+    auto* mo = static_cast<MonitorObject*>(mMonitorObjects->UncheckedAt(slot));
+    mObjectsByAddress.at(mo->getObject()).slot = slot;
+  }
+}
+
 void ObjectsManager::updateServiceDiscovery()
 {
   if (!mUpdateServiceDiscovery || mServiceDiscovery == nullptr) {
@@ -101,7 +135,7 @@ void ObjectsManager::updateServiceDiscovery()
     }
   }
   objects.pop_back();
-  mServiceDiscovery->_register(objects);
+  mServiceDiscovery->registerAsync(std::move(objects));
   mUpdateServiceDiscovery = false;
 }
 
@@ -110,39 +144,32 @@ void ObjectsManager::removeAllFromServiceDiscovery()
   if (mServiceDiscovery == nullptr) {
     return;
   }
-  mServiceDiscovery->_register("");
+  mServiceDiscovery->registerAsync("");
   mUpdateServiceDiscovery = true;
 }
 
+const ServiceDiscovery* ObjectsManager::getServiceDiscovery() const
+{
+  return mServiceDiscovery.get();
+}
+
 void ObjectsManager::stopPublishing(TObject* object)
 {
   if (!object) {
     ILOG(Warning, Support) << "A nullptr provided to ObjectManager::stopPublishing" << ENDM;
     return;
   }
-  // We look for the MonitorObject which observes the provided object by comparing its address
+  // We look for the MonitorObject which observes the provided object by its address
   // This way, we avoid invoking any methods of the provided object, thus we can stop publishing it even after it is deleted
-  MonitorObject* moToRemove = nullptr;
-  for (auto moAsTObject : *mMonitorObjects) {
-    auto mo = dynamic_cast<MonitorObject*>(moAsTObject);
-    if (mo && mo->getObject() == object) {
-      moToRemove = mo;
-      continue;
-    }
-  }
-  if (moToRemove) {
-    mPublicationPoliciesForMOs.erase(moToRemove);
-    mMonitorObjects->Remove(moToRemove);
-    mMonitorObjects->Compress();
+  if (auto entry = mObjectsByAddress.find(object); entry != mObjectsByAddress.end()) {
+    unregister(entry);
   }
 }
 
 void ObjectsManager::stopPublishing(const string& objectName)
 {
-  auto* mo = dynamic_cast<MonitorObject*>(getMonitorObject(objectName));
-  mPublicationPoliciesForMOs.erase(mo);
-  mMonitorObjects->Remove(mo);
-  mMonitorObjects->Compress();
+  auto* mo = getMonitorObject(objectName);
+  unregister(mObjectsByAddress.find(mo->getObject()));
 }
 
 void ObjectsManager::stopPublishing(PublicationPolicy policy)
@@ -163,26 +190,29 @@ void ObjectsManager::stopPublishingAll()
 {
   removeAllFromServiceDiscovery();
   mMonitorObjects->Clear();
+  mObjectsByAddress.clear();
+  mObjectsByName.clear();
   mPublicationPoliciesForMOs.clear();
 }
 
 bool ObjectsManager::isBeingPublished(const string& name)
 {
-  return (mMonitorObjects->FindObject(name.c_str()) != nullptr);
+  return mObjectsByName.count(name) > 0;
 }
 
 MonitorObject* ObjectsManager::getMonitorObject(const std::string& objectName)
 {
-  TObject* object = mMonitorObjects->FindObject(objectName.c_str());
-  if (object == nullptr) {
+  auto address = mObjectsByName.find(objectName);
+  if (address == mObjectsByName.end()) {
     ILOG(Error, Support) << "ObjectsManager: Unable to find object \"" << objectName << "\"" << ENDM;
     BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(objectName));
   }
-  return dynamic_cast<MonitorObject*>(object);
+  return mObjectsByAddress.at(address->second).mo;
 }
 
 MonitorObject* ObjectsManager::getMonitorObject(size_t index)
 {
+  compact();
   TObject* object = mMonitorObjects->At(index);
   if (object == nullptr) {
     ILOG(Error, Support) << "ObjectsManager: Unable to find object at index \"" << index << "\"" << ENDM;
@@ -194,7 +224,45 @@ MonitorObject* ObjectsManager::getMonitorObject(size_t index)
 
 MonitorObjectCollection* ObjectsManager::getNonOwningArray() const
 {
-  return new MonitorObjectCollection(*mMonitorObjects);
+  auto* array = new MonitorObjectCollection(*mMonitorObjects);
+  array->Compress();
+  return array;
+}
+
+MonitorObjectCollection* ObjectsManager::getNonOwningArrayOfUpdatedObjects(bool includeAll)
+{
+  auto* updated = new MonitorObjectCollection();
+  updated->SetOwner(false);
+  updated->SetName(mMonitorObjects->GetName());
+  updated->setDetector(mMonitorObjects->getDetector());
+  updated->setTaskName(mMonitorObjects->getTaskName());
+
+  for (auto* tobj : *mMonitorObjects) {
+    auto* mo = dynamic_cast<MonitorObject*>(tobj);
+    if (mo == nullptr) {
+      continue;
+    }
+    if (includeAll || !isEmptyHistogram(mo)) {
+      updated->Add(mo);
+    }
+  }
+  return updated;
+}
+
+bool ObjectsManager::isEmptyHistogram(const MonitorObject* mo)
+{
+  // TH1::GetEntries() and TH1::GetStats() are cheap compared to streaming the histogram.
+  // The sum of weights is checked as well, in case the entries were not counted, e.g. after TH1::SetEntries(0).
+  auto* histogram = dynamic_cast<TH1*>(mo->getObject());
+  if (histogram == nullptr) {
+    return false;
+  }
+  if (histogram->GetEntries() != 0) {
+    return false;
+  }
+  double stats[TH1::kNstat] = { 0 };
+  histogram->GetStats(stats);
+  return stats[0] == 0;
 }
 
 void ObjectsManager::addMetadata(const std::string& objectName, const std::string& key, const std::string& value)
@@ -213,7 +281,7 @@ void ObjectsManager::addOrUpdateMetadata(const std::string& objectName, const st
 
 size_t ObjectsManager::getNumberPublishedObjects()
 {
-  return mMonitorObjects->GetLast() + 1; // GetLast returns the index
+  return mObjectsByAddress.size();
 }
 
 void ObjectsManager::setDefaultDrawOptions(const std::string& objectName, const std::string& options)
@@ -228,7 +296,8 @@ void ObjectsManager::setDefaultDrawOptions(TObject* obj, const std::string& opti
     ILOG(Warning, Support) << "A nullptr provided to ObjectManager::setDefaultDrawOptions" << ENDM;
     return;
   }
-  MonitorObject* mo = getMonitorObject(obj->GetName());
+  auto entry = mObjectsByAddress.find(obj);
+  MonitorObject* mo = entry != mObjectsByAddress.end() ? entry->second.mo : getMonitorObject(obj->GetName());
   mo->addOrUpdateMetadata(gDrawOptionsKey, options);
 }
 
@@ -244,7 +313,8 @@ void ObjectsManager::setDisplayHint(TObject* obj, const std::string& hints)
     ILOG(Warning, Support) << "A nullptr provided to ObjectManager::setDisplayHint" << ENDM;
     return;
   }
-  MonitorObject* mo = getMonitorObject(obj->GetName());
+  auto entry = mObjectsByAddress.find(obj);
+  MonitorObject* mo = entry != mObjectsByAddress.end() ? entry->second.mo : getMonitorObject(obj->GetName());
   mo->addOrUpdateMetadata(gDisplayHintsKey, hints);
 }
 
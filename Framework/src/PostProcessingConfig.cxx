@@ -38,6 +38,7 @@ PostProcessingConfig::PostProcessingConfig(const std::string& id, const boost::p
              { config.get<uint64_t>("qc.config.Activity.start", 0),
                config.get<uint64_t>("qc.config.Activity.end", -1) }),
     matchAnyRunNumber(config.get<bool>("qc.config.postprocessing.matchAnyRunNumber", false)),
+    newObjectPollingPeriodSeconds(config.get<double>("qc.config.postprocessing.newObjectPollingPeriodSeconds", 1.0)),
     critical(true)
 {
   for (const auto& initTrigger : config.get_child("qc.postprocessing." + id + ".initTrigger")) {
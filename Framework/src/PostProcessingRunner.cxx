@@ -281,6 +281,7 @@ void PostProcessingRunner::doInitialize(const Trigger& trigger)
 {
   ILOG(Info, Support) << "Initializing the user task due to trigger '" << trigger << "'" << ENDM;
 
+  mTask->resolveCustomParameters(trigger.activity);
   mTask->initialize(trigger, mServices);
   updateValidity(trigger);
   mTaskState = TaskState::Running;
@@ -0,0 +1,216 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ResolvedCustomParameters.cxx
+///
+
+#include "QualityControl/ResolvedCustomParameters.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <unordered_set>
+
+namespace o2::quality_control::core
+{
+
+namespace
+{
+
+std::string trim(const std::string& s)
+{
+  const auto first = s.find_first_not_of(" \t\n\r");
+  if (first == std::string::npos) {
+    return {};
+  }
+  const auto last = s.find_last_not_of(" \t\n\r");
+  return s.substr(first, last - first + 1);
+}
+
+std::optional<long long> parseInteger(const std::string& s)
+{
+  if (s.empty()) {
+    return std::nullopt;
+  }
+  char* end = nullptr;
+  errno = 0;
+  const long long result = std::strtoll(s.c_str(), &end, 10);
+  if (errno != 0 || end != s.c_str() + s.size()) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+std::optional<double> parseDouble(const std::string& s)
+{
+  if (s.empty()) {
+    return std::nullopt;
+  }
+  char* end = nullptr;
+  errno = 0;
+  const double result = std::strtod(s.c_str(), &end);
+  if (errno != 0 || end != s.c_str() + s.size()) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+// same spellings as decodeBool in stringUtils
+std::optional<bool> parseBool(const std::string& s)
+{
+  if (s == "true" || s == "True" || s == "TRUE" || s == "1") {
+    return true;
+  }
+  if (s == "false" || s == "False" || s == "FALSE" || s == "0") {
+    return false;
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+ResolvedCustomParameters::ResolvedCustomParameters(const CustomParameters& customParameters, const std::string& runType, const std::string& beamType)
+  : mRunType(runType), mBeamType(beamType)
+{
+  for (const auto& [key, raw] : customParameters.getAllResolved(runType, beamType)) {
+    mValues.emplace(key, parse(raw));
+  }
+}
+
+ResolvedCustomParameters::ResolvedCustomParameters(const CustomParameters& customParameters, const Activity& activity)
+  : ResolvedCustomParameters(customParameters, activity.mType, activity.mBeamType)
+{
+}
+
+ResolvedCustomParameters::Value ResolvedCustomParameters::parse(const std::string& raw)
+{
+  Value value;
+  value.raw = raw;
+  const auto trimmed = trim(raw);
+  value.boolean = parseBool(trimmed);
+  value.integer = parseInteger(trimmed);
+  value.number = parseDouble(trimmed);
+
+  if (!trimmed.empty()) {
+    size_t begin = 0;
+    while (true) {
+      const auto comma = trimmed.find(',', begin);
+      value.elements.push_back(trim(trimmed.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin)));
+      if (comma == std::string::npos) {
+        break;
+      }
+      begin = comma + 1;
+    }
+  }
+  std::vector<long long> integers;
+  std::vector<double> numbers;
+  integers.reserve(value.elements.size());
+  numbers.reserve(value.elements.size());
+  bool allIntegers = true;
+  bool allNumbers = true;
+  for (const auto& element : value.elements) {
+    if (allIntegers) {
+      if (auto integer = parseInteger(element)) {
+        integers.push_back(integer.value());
+      } else {
+        allIntegers = false;
+      }
+    }
+    if (allNumbers) {
+      if (auto number = parseDouble(element)) {
+        numbers.push_back(number.value());
+      } else {
+        allNumbers = false;
+      }
+    }
+  }
+  if (allIntegers) {
+    value.integers = std::move(integers);
+  }
+  if (allNumbers) {
+    value.numbers = std::move(numbers);
+  }
+  return value;
+}
+
+const ResolvedCustomParameters::Value* ResolvedCustomParameters::find(const std::string& key) const
+{
+  auto it = mValues.find(key);
+  return it == mValues.end() ? nullptr : &it->second;
+}
+
+ResolvedCustomParameters::ValidationReport ResolvedCustomParameters::validate(const std::vector<Expected>& expected) const
+{
+  ValidationReport report;
+  std::unordered_set<std::string> expectedKeys;
+  for (const auto& [key, type] : expected) {
+    expectedKeys.insert(key);
+    const auto* value = find(key);
+    if (value == nullptr) {
+      continue; // missing parameters are allowed, the user code has defaults
+    }
+    bool valid = true;
+    switch (type) {
+      case Type::String:
+      case Type::StringList:
+        break;
+      case Type::Bool:
+        valid = value->boolean.has_value();
+        break;
+      case Type::Integer:
+        valid = value->integer.has_value();
+        break;
+      case Type::Double:
+        valid = value->number.has_value();
+        break;
+      case Type::IntegerList:
+        valid = value->integers.has_value();
+        break;
+      case Type::DoubleList:
+        valid = value->numbers.has_value();
+        break;
+    }
+    if (!valid) {
+      report.malformedKeys.push_back(key + ": '" + value->raw + "' is not " + typeToString(type));
+    }
+  }
+  for (const auto& [key, value] : mValues) {
+    if (expectedKeys.count(key) == 0) {
+      report.unknownKeys.push_back(key);
+    }
+  }
+  std::sort(report.unknownKeys.begin(), report.unknownKeys.end());
+  return report;
+}
+
+std::string ResolvedCustomParameters::typeToString(Type type)
+{
+  switch (type) {
+    case Type::String:
+      return "a string";
+    case Type::Bool:
+      return "a boolean";
+    case Type::Integer:
+      return "an integer";
+    case Type::Double:
+      return "a number";
+    case Type::IntegerList:
+      return "a comma-separated list of integers";
+    case Type::DoubleList:
+      return "a comma-separated list of numbers";
+    case Type::StringList:
+      return "a comma-separated list";
+  }
+  return "unknown";
+}
+
+} // namespace o2::quality_control::core
@@ -23,6 +23,9 @@
 #include <Framework/CompletionPolicyHelpers.h>
 #include <Framework/CompletionPolicy.h>
 #include <Framework/InputRecordWalker.h>
+#include <TROOT.h>
+
+#include <algorithm>
 
 #if defined(__linux__) && __has_include(<malloc.h>)
 #include <malloc.h>
@@ -33,11 +36,23 @@ using namespace o2::framework;
 namespace o2::quality_control::core
 {
 
-RootFileSink::RootFileSink(std::string filePath)
-  : mFilePath(std::move(filePath))
+RootFileSink::RootFileSink(std::string filePath, size_t queueCapacity)
+  : mFilePath(std::move(filePath)), mQueueCapacity(std::max<size_t>(1, queueCapacity))
 {
 }
 
+RootFileSink::~RootFileSink()
+{
+  {
+    std::lock_guard lock(mMutex);
+    mStopping = true;
+  }
+  mJobAvailable.notify_all();
+  if (mWriter.joinable()) {
+    mWriter.join();
+  }
+}
+
 void RootFileSink::customizeInfrastructure(std::vector<framework::CompletionPolicy>& policies)
 {
   auto matcher = [label = RootFileSink::getLabel()](auto const& device) {
@@ -49,35 +64,117 @@ void RootFileSink::customizeInfrastructure(std::vector<framework::CompletionPoli
 
 void RootFileSink::init(framework::InitContext& ictx)
 {
+  if (!mWriter.joinable()) {
+    // the collections are deserialized on the DPL thread while the previous ones are written
+    ROOT::EnableThreadSafety();
+    mWriter = std::thread([this]() { runWriter(); });
+  }
 }
 
 void RootFileSink::run(framework::ProcessingContext& pctx)
 {
-  try {
-    RootFileStorage mStorage{ mFilePath, RootFileStorage::ReadMode::Update };
-    for (const auto& input : InputRecordWalker(pctx.inputs())) {
-      auto moc = DataRefUtils::as<MonitorObjectCollection>(input);
-      if (moc == nullptr) {
-        ILOG(Error) << "Could not cast the input object to MonitorObjectCollection, skipping." << ENDM;
-        continue;
-      }
-      ILOG(Info, Support) << "Received MonitorObjectCollection '" << moc->GetName() << "'" << ENDM;
-      moc->postDeserialization();
-      auto mwMOC = dynamic_cast<MonitorObjectCollection*>(moc->cloneMovingWindow());
+  for (const auto& input : InputRecordWalker(pctx.inputs())) {
+    auto moc = DataRefUtils::as<MonitorObjectCollection>(input);
+    if (moc == nullptr) {
+      ILOG(Error) << "Could not cast the input object to MonitorObjectCollection, skipping." << ENDM;
+      continue;
+    }
+    ILOG(Info, Support) << "Received MonitorObjectCollection '" << moc->GetName() << "'" << ENDM;
+    moc->postDeserialization();
+    std::unique_ptr<MonitorObjectCollection> mwMOC(dynamic_cast<MonitorObjectCollection*>(moc->cloneMovingWindow()));
 
-      if (moc->GetEntries() > 0) {
-        mStorage.storeIntegralMOC(moc.get());
+    if (moc->GetEntries() > 0) {
+      enqueue(std::move(moc), true);
+    }
+    if (mwMOC != nullptr && mwMOC->GetEntries() > 0) {
+      enqueue(std::move(mwMOC), false);
+    }
+  }
+}
+
+void RootFileSink::endOfStream(framework::EndOfStreamContext&)
+{
+  flush();
+}
+
+void RootFileSink::stop()
+{
+  flush();
+}
+
+void RootFileSink::flush()
+{
+  std::unique_lock lock(mMutex);
+  mAllDone.wait(lock, [this]() { return mQueue.empty() && !mWriting; });
+}
+
+void RootFileSink::enqueue(std::unique_ptr<MonitorObjectCollection> moc, bool integral)
+{
+  std::unique_lock lock(mMutex);
+  if (integral) {
+    // the integrals are merged with the content of the file anyway, so we can merge the queued ones first
+    auto key = moc->getDetector() + "/" + moc->getTaskName();
+    if (auto queued = mQueuedIntegrals.find(key); queued != mQueuedIntegrals.end()) {
+      ILOG(Debug, Support) << "Merging '" << key << "' with the version waiting to be written" << ENDM;
+      queued->second->merge(moc.get());
+      return;
+    }
+    mSpaceAvailable.wait(lock, [this]() { return mQueue.size() < mQueueCapacity; });
+    mQueuedIntegrals.emplace(key, moc.get());
+  } else {
+    mSpaceAvailable.wait(lock, [this]() { return mQueue.size() < mQueueCapacity; });
+  }
+  mQueue.push_back({ std::move(moc), integral });
+  lock.unlock();
+  mJobAvailable.notify_one();
+}
+
+void RootFileSink::runWriter()
+{
+  while (true) {
+    std::deque<Job> jobs;
+    {
+      std::unique_lock lock(mMutex);
+      mJobAvailable.wait(lock, [this]() { return mStopping || !mQueue.empty(); });
+      if (mQueue.empty()) {
+        return;
       }
-      if (mwMOC->GetEntries() > 0) {
-        mStorage.storeMovingWindowMOC(mwMOC);
+      jobs.swap(mQueue);
+      mQueuedIntegrals.clear();
+      mWriting = true;
+    }
+    mSpaceAvailable.notify_all();
+
+    write(jobs);
+
+    {
+      std::lock_guard lock(mMutex);
+      mWriting = false;
+    }
+    mAllDone.notify_all();
+  }
+}
+
+void RootFileSink::write(std::deque<Job>& jobs)
+{
+  try {
+    RootFileStorage storage{ mFilePath, RootFileStorage::ReadMode::Update };
+    for (auto& job : jobs) {
+      if (job.integral) {
+        storage.storeIntegralMOC(job.moc.get());
+      } else {
+        storage.storeMovingWindowMOC(job.moc.get());
       }
+      job.moc.reset();
     }
   } catch (const std::bad_alloc& ex) {
     ILOG(Error, Ops) << "Caught a bad_alloc exception, there is probably a huge file or object present, but I will try to survive" << ENDM;
     ILOG(Error, Support) << "Details: " << ex.what() << ENDM;
-  } catch (...) {
-    throw;
+  } catch (const std::exception& ex) {
+    // there is no caller to rethrow to in the writer thread
+    ILOG(Error, Ops) << "Could not store the objects in the file '" << mFilePath << "': " << ex.what() << ENDM;
   }
+  jobs.clear();
 
 #if defined(__linux__) && __has_include(<malloc.h>)
   // Once we write object to TFile, the OS does not actually release the array memory from the heap,
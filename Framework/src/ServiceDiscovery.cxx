@@ -15,14 +15,18 @@
 
 #include "QualityControl/ServiceDiscovery.h"
 #include "QualityControl/QcInfoLogger.h"
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <random>
+#include <vector>
 #include <curl/curl.h>
 #include <boost/asio/ip/host_name.hpp>
 #include <boost/asio.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/container_hash/hash.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/io_service.hpp>
 #include <iostream>
@@ -81,6 +85,79 @@ CURL* ServiceDiscovery::initCurl()
 }
 
 bool ServiceDiscovery::_register(const std::string& objects)
+{
+  ILOG(Debug, Devel) << "Registration to ServiceDiscovery: " << objects << ENDM;
+  std::lock_guard<std::mutex> sendLock(mSendMutex);
+  std::string error;
+  if (!sendRegistration(objects, error)) {
+    static AliceO2::InfoLogger::InfoLogger::AutoMuteToken msgLimit(LogWarningDevel, 1, 600); // send it only every 10 minutes
+    ILOG_INST.log(msgLimit, "%s", error.c_str());
+    return false;
+  }
+  return true;
+}
+
+void ServiceDiscovery::registerAsync(std::string objects)
+{
+  std::lock_guard<std::mutex> lock(mMailboxMutex);
+  mPendingObjects = std::move(objects);
+}
+
+ServiceDiscovery::Statistics ServiceDiscovery::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mMailboxMutex);
+  return mStatistics;
+}
+
+size_t ServiceDiscovery::hashObjects(const std::string& objects)
+{
+  std::vector<std::string> paths;
+  boost::split(paths, objects, boost::is_any_of(","), boost::token_compress_on);
+  std::sort(paths.begin(), paths.end());
+  size_t seed = 0;
+  for (const auto& path : paths) {
+    boost::hash_combine(seed, path);
+  }
+  return seed;
+}
+
+void ServiceDiscovery::processPendingRegistration(AliceO2::InfoLogger::InfoLogger& logger)
+{
+  // Holding the send lock while taking the pending list guarantees that deregister() cannot be overtaken by it
+  std::lock_guard<std::mutex> sendLock(mSendMutex);
+  std::string objects;
+  size_t hash = 0;
+  {
+    std::lock_guard<std::mutex> lock(mMailboxMutex);
+    if (!mPendingObjects.has_value()) {
+      return;
+    }
+    objects = std::move(mPendingObjects.value());
+    mPendingObjects.reset();
+    hash = hashObjects(objects);
+    if (mRegisteredHash == hash) {
+      mStatistics.unchanged++;
+      return;
+    }
+  }
+
+  std::string error;
+  bool success = sendRegistration(objects, error);
+  std::lock_guard<std::mutex> lock(mMailboxMutex);
+  if (success) {
+    mRegisteredHash = hash;
+    return;
+  }
+  if (!mPendingObjects.has_value()) {
+    mPendingObjects = std::move(objects); // retried in the next iteration, unless a newer list arrives
+  }
+  if (mStatistics.failures == 1 || mStatistics.failures % 100 == 0) {
+    // we cannot use the muting of the shared InfoLogger instance in this thread
+    logger << AliceO2::InfoLogger::InfoLogger::Severity::Warning << error << " (" << mStatistics.failures << " failures so far)" << AliceO2::InfoLogger::InfoLogger::endm;
+  }
+}
+
+bool ServiceDiscovery::sendRegistration(const std::string& objects, std::string& error)
 {
   boost::property_tree::ptree pt;
   if (!objects.empty()) {
@@ -113,12 +190,29 @@ bool ServiceDiscovery::_register(const std::string& objects)
   std::stringstream ss;
   boost::property_tree::json_parser::write_json(ss, pt);
 
-  ILOG(Debug, Devel) << "Registration to ServiceDiscovery: " << objects << ENDM;
-  return send("/v1/agent/service/register", ss.str());
+  auto start = std::chrono::steady_clock::now();
+  bool success = send("/v1/agent/service/register", ss.str(), error);
+  double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::lock_guard<std::mutex> lock(mMailboxMutex);
+  mStatistics.lastLatency = latency;
+  mStatistics.maxLatency = std::max(mStatistics.maxLatency, latency);
+  if (success) {
+    mStatistics.registrations++;
+  } else {
+    mStatistics.failures++;
+  }
+  return success;
 }
 
 void ServiceDiscovery::deregister()
 {
+  std::lock_guard<std::mutex> sendLock(mSendMutex);
+  {
+    std::lock_guard<std::mutex> lock(mMailboxMutex);
+    mPendingObjects.reset();
+    mRegisteredHash.reset();
+  }
   send("/v1/agent/service/deregister/" + mId, "");
   ILOG(Debug, Devel) << "Deregistration from ServiceDiscovery" << ENDM;
 }
@@ -172,6 +266,11 @@ void ServiceDiscovery::runHealthServer()
 
   if (cycle == rangeLength) {
     ILOG(Error, Support) << "Could not find a free port for the ServiceDiscovery, aborting the ServiceDiscovery health check" << ENDM;
+    // the objects are still registered, even though Consul will consider the service as unhealthy
+    while (mThreadRunning) {
+      processPendingRegistration(threadInfoLogger);
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
     return;
   }
 
@@ -179,6 +278,7 @@ void ServiceDiscovery::runHealthServer()
   try {
     boost::asio::deadline_timer timer(io_service);
     while (mThreadRunning) {
+      processPendingRegistration(threadInfoLogger);
       io_service.reset();
       timer.expires_from_now(boost::posix_time::seconds(1));
       acceptor->async_accept([this](boost::system::error_code ec, tcp::socket socket) {
@@ -201,6 +301,17 @@ void ServiceDiscovery::deleteCurl(CURL* curl)
 }
 
 bool ServiceDiscovery::send(const std::string& path, std::string&& post)
+{
+  std::string error;
+  if (!send(path, std::move(post), error)) {
+    static AliceO2::InfoLogger::InfoLogger::AutoMuteToken msgLimit(LogWarningDevel, 1, 600); // send it only every 10 minutes
+    ILOG_INST.log(msgLimit, "%s", error.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool ServiceDiscovery::send(const std::string& path, std::string&& post, std::string& error)
 {
   std::string uri = mConsulUrl + path;
   CURLcode response;
@@ -210,15 +321,12 @@ bool ServiceDiscovery::send(const std::string& path, std::string&& post)
   curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post.c_str());
   response = curl_easy_perform(curl);
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
-  static AliceO2::InfoLogger::InfoLogger::AutoMuteToken msgLimit(LogWarningDevel, 1, 600); // send it only every 10 minutes
   if (response != CURLE_OK) {
-    std::string s = std::string("ServiceDiscovery::send(...) ") + curl_easy_strerror(response) + "\n   URI: " + uri;
-    ILOG_INST.log(msgLimit, "%s", s.c_str());
+    error = std::string("ServiceDiscovery::send(...) ") + curl_easy_strerror(response) + "\n   URI: " + uri;
     return false;
   }
   if (responseCode < 200 || responseCode > 206) {
-    std::string s = std::string("ServiceDiscovery::send(...) Response code: ") + std::to_string(responseCode);
-    ILOG_INST.log(msgLimit, "%s", s.c_str());
+    error = std::string("ServiceDiscovery::send(...) Response code: ") + std::to_string(responseCode);
     return false;
   }
   return true;
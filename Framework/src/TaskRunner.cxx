@@ -44,6 +44,7 @@
 #include "QualityControl/TaskRunnerFactory.h"
 #include "QualityControl/ConfigParamGlo.h"
 #include "QualityControl/ObjectsManager.h"
+#include "QualityControl/ServiceDiscovery.h"
 #include "QualityControl/Bookkeeping.h"
 #include "QualityControl/TimekeeperFactory.h"
 #include "QualityControl/ActivityHelpers.h"
@@ -158,7 +159,7 @@ void TaskRunner::run(ProcessingContext& pCtx)
   if (mTimekeeper->shouldFinishCycle(pCtx.services().get<TimingInfo>())) {
     mTimekeeper->updateByCurrentTimestamp(pCtx.services().get<TimingInfo>().timeslice / 1000);
     finishCycle(pCtx.outputs());
-    if (mTaskConfig.resetAfterCycles > 0 && (mCycleNumber % mTaskConfig.resetAfterCycles == 0)) {
+    if (isResetNeeded(mTaskConfig, mCycleNumber)) {
       mTask->reset();
       mTimekeeper->reset();
     }
@@ -404,6 +405,7 @@ void TaskRunner::startOfActivity()
   mTimekeeper->setEndOfActivity(mActivity.mValidity.getMax(), mTaskConfig.fallbackActivity.mValidity.getMax(), now, activity_helpers::getCcdbEorTimeAccessor(mActivity.mId));
 
   mCollector->setRunNumber(mActivity.mId);
+  mTask->resolveCustomParameters(mActivity);
   mTask->startOfActivity(mActivity);
   mObjectsManager->updateServiceDiscovery();
 }
@@ -430,6 +432,7 @@ void TaskRunner::startCycle()
   mTask->startOfCycle();
   mNumberMessagesReceivedInCycle = 0;
   mNumberObjectsPublishedInCycle = 0;
+  mNumberObjectsNotUpdatedInCycle = 0;
   mDataReceivedInCycle = 0;
   mTimerDurationCycle.reset();
   mCycleOn = true;
@@ -527,6 +530,21 @@ void TaskRunner::publishCycleStats()
                      .addValue(rate, "per_second")
                      .addValue(mTotalNumberObjectsPublished, "whole_run")
                      .addValue(wholeRunRate, "per_second_whole_run"));
+
+  if (mTaskConfig.publishUpdatedObjectsOnly) {
+    mCollector->send(Metric{ "qc_objects_not_updated" }
+                       .addValue(mNumberObjectsNotUpdatedInCycle, "in_cycle"));
+  }
+
+  if (auto serviceDiscovery = mObjectsManager->getServiceDiscovery(); serviceDiscovery != nullptr) {
+    auto discovery = serviceDiscovery->getStatistics();
+    mCollector->send(Metric{ "qc_service_discovery" }
+                       .addValue(discovery.registrations, "registrations")
+                       .addValue(discovery.failures, "failures")
+                       .addValue(discovery.unchanged, "unchanged")
+                       .addValue(discovery.lastLatency, "last_latency")
+                       .addValue(discovery.maxLatency, "max_latency"));
+  }
 }
 
 int TaskRunner::publish(DataAllocator& outputs)
@@ -535,10 +553,9 @@ int TaskRunner::publish(DataAllocator& outputs)
   AliceO2::Common::Timer publicationDurationTimer;
 
   auto concreteOutput = framework::DataSpecUtils::asConcreteDataMatcher(mTaskConfig.moSpec);
-  // getNonOwningArray creates a TObjArray containing the monitoring objects, but not
-  // owning them. The array is created by new and must be cleaned up by the caller
-  std::unique_ptr<MonitorObjectCollection> array(mObjectsManager->getNonOwningArray());
+  auto array = getObjectsToPublish(*mObjectsManager, mTaskConfig, mCycleNumber);
   int objectsPublished = array->GetEntries();
+  mNumberObjectsNotUpdatedInCycle = mObjectsManager->getNumberPublishedObjects() - objectsPublished;
 
   outputs.snapshot(
     Output{ concreteOutput.origin,
@@ -551,6 +568,25 @@ int TaskRunner::publish(DataAllocator& outputs)
   return objectsPublished;
 }
 
+std::unique_ptr<MonitorObjectCollection> TaskRunner::getObjectsToPublish(ObjectsManager& objectsManager, const TaskRunnerConfig& config, int cycleNumber)
+{
+  // getNonOwningArray creates a TObjArray containing the monitoring objects, but not
+  // owning them. The array is created by new and must be cleaned up by the caller
+  if (config.publishUpdatedObjectsOnly) {
+    // Histograms which were not filled since the reset at the end of the previous cycle are not sent, since they are
+    // empty deltas. Mergers in the delta mode and CheckRunners keep their latest version, but all objects are published
+    // from time to time anyway, so the downstream devices can recover from a restart.
+    bool publishAll = cycleNumber == 0 || (config.fullPublicationCycles > 0 && cycleNumber % config.fullPublicationCycles == 0);
+    return std::unique_ptr<MonitorObjectCollection>(objectsManager.getNonOwningArrayOfUpdatedObjects(publishAll));
+  }
+  return std::unique_ptr<MonitorObjectCollection>(objectsManager.getNonOwningArray());
+}
+
+bool TaskRunner::isResetNeeded(const TaskRunnerConfig& config, int finishedCycles)
+{
+  return config.resetAfterCycles > 0 && finishedCycles % config.resetAfterCycles == 0;
+}
+
 void TaskRunner::saveToFile()
 {
   if (!mTaskConfig.saveToFile.empty()) {
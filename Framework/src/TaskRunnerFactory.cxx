@@ -167,6 +167,20 @@ TaskRunnerConfig TaskRunnerFactory::extractConfig(const CommonSpec& globalConfig
 
   o2::globaltracking::RecoContainer rd;
 
+  const int effectiveResetAfterCycles = resetAfterCycles.value_or(taskSpec.resetAfterCycles);
+  // Empty histograms are not published, which is correct only if the task starts from scratch in each cycle.
+  // Otherwise, the content from before a reset would stay in the QCDB until the next full publication.
+  bool publishUpdatedObjectsOnly = taskSpec.publishUpdatedObjectsOnly;
+  if (publishUpdatedObjectsOnly && taskSpec.mergingMode != "delta") {
+    ILOG(Warning, Support) << "publishUpdatedObjectsOnly is incompatible with the merging mode '" << taskSpec.mergingMode
+                           << "' in task '" << taskSpec.taskName << "', all objects will be published in each cycle" << ENDM;
+    publishUpdatedObjectsOnly = false;
+  } else if (publishUpdatedObjectsOnly && effectiveResetAfterCycles != 1) {
+    ILOG(Warning, Support) << "publishUpdatedObjectsOnly requires the objects to be reset after each cycle, but task '" << taskSpec.taskName
+                           << "' resets them every " << effectiveResetAfterCycles << " cycle(s), all objects will be published in each cycle" << ENDM;
+    publishUpdatedObjectsOnly = false;
+  }
+
   return {
     deviceName,
     taskSpec.taskName,
@@ -186,13 +200,15 @@ TaskRunnerConfig TaskRunnerFactory::extractConfig(const CommonSpec& globalConfig
     InfrastructureSpecReader::validateDetectorName(taskSpec.detectorName),
     parallelTaskID,
     taskSpec.saveObjectsToFile,
-    resetAfterCycles.value_or(taskSpec.resetAfterCycles),
+    effectiveResetAfterCycles,
     globalConfig.infologgerDiscardParameters,
     fallbackActivity,
     grpGeomRequest,
     globalTrackingDataRequest,
     taskSpec.movingWindows,
-    taskSpec.disableLastCycle
+    taskSpec.disableLastCycle,
+    publishUpdatedObjectsOnly,
+    taskSpec.fullPublicationCycles
   };
 }
 
@@ -0,0 +1,61 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ThreadPool.cxx
+///
+
+#include "QualityControl/ThreadPool.h"
+
+namespace o2::quality_control::core
+{
+
+ThreadPool::ThreadPool(size_t threads)
+{
+  threads = threads == 0 ? 1 : threads;
+  mThreads.reserve(threads);
+  for (size_t i = 0; i < threads; i++) {
+    mThreads.emplace_back(&ThreadPool::run, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard lock(mMutex);
+    mStopping = true;
+  }
+  mJobAvailable.notify_all();
+  for (auto& thread : mThreads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+void ThreadPool::run()
+{
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock lock(mMutex);
+      mJobAvailable.wait(lock, [this] { return mStopping || !mJobs.empty(); });
+      if (mJobs.empty()) {
+        return; // stopping and nothing left to do
+      }
+      job = std::move(mJobs.front());
+      mJobs.pop();
+    }
+    job();
+  }
+}
+
+} // namespace o2::quality_control::core
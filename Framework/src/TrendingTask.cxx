@@ -22,6 +22,8 @@
 #include "QualityControl/RootClassFactory.h"
 #include "QualityControl/RepoPathUtils.h"
 #include "QualityControl/ActivityHelpers.h"
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/ObjectMetadataKeys.h"
 
 #include <TH1.h>
 #include <TCanvas.h>
@@ -32,18 +34,42 @@
 #include <TLegend.h>
 
 #include <boost/algorithm/string.hpp>
+#include <optional>
+#include <map>
 #include <set>
 
 using namespace o2::quality_control;
 using namespace o2::quality_control::core;
 using namespace o2::quality_control::postprocessing;
 
+namespace
+{
+// the metadata key which identifies the chunk in a stored chunk TTree
+constexpr auto trendChunkKey = "trendChunk";
+
+// the number after the prefix in the chunk key determines the order of chunks
+std::optional<uint64_t> getChunkOrder(const std::string& chunkKey, const std::string& prefix)
+{
+  if (chunkKey.size() <= prefix.size() || chunkKey.compare(0, prefix.size(), prefix) != 0) {
+    return std::nullopt;
+  }
+  try {
+    return std::stoull(chunkKey.substr(prefix.size()));
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+} // namespace
+
 void TrendingTask::configure(const boost::property_tree::ptree& config)
 {
   // we clear any existing objects, which would be there only in case of reconfiguration
   // at the time of writing, this not even supported by ECS
   mReductors.clear();
   mTrend.reset();
+  mChunk.reset();
+  mChunkKey.clear();
+  mTrendChunks.clear();
 
   // configuration
   mConfig = TrendingTaskConfig(getID(), config);
@@ -90,6 +116,11 @@ bool TrendingTask::canContinueTrend(TTree* tree)
 
 void TrendingTask::initializeTrend(o2::quality_control::repository::DatabaseInterface& qcdb)
 {
+  if (!mConfig.trendChunks.empty()) {
+    initializeTrendChunks(qcdb);
+    return;
+  }
+
   // tree exists and we can reuse it
   if (canContinueTrend(mTrend.get())) {
     if (mConfig.resumeTrend == false) {
@@ -116,11 +147,7 @@ void TrendingTask::initializeTrend(o2::quality_control::repository::DatabaseInte
       ILOG(Warning, Support) << "Could not retrieve an existing TTree for this task" << ENDM;
     }
     if (canContinueTrend(mTrend.get())) {
-      mTrend->SetBranchAddress("meta", &mMetaData);
-      mTrend->SetBranchAddress("time", &mTime);
-      for (const auto& [sourceName, reductor] : mReductors) {
-        mTrend->SetBranchAddress(sourceName.c_str(), reductor->getBranchAddress());
-      }
+      setBranchAddresses(mTrend.get());
       ILOG(Info, Support) << "Will use the latest TTree from QCDB for this task to continue the trend." << ENDM;
       return;
     } else {
@@ -130,15 +157,157 @@ void TrendingTask::initializeTrend(o2::quality_control::repository::DatabaseInte
 
   // we could not reuse the tree or never had one => we create a new one
   if (mTrend == nullptr) {
-    mTrend = std::make_unique<TTree>();
-    mTrend->SetName(PostProcessingInterface::getName().c_str());
+    mTrend = createTree(PostProcessingInterface::getName());
+  }
+}
+
+void TrendingTask::initializeTrendChunks(repository::DatabaseInterface& qcdb)
+{
+  // the trees from the previous run in this process are complete, we can reuse them
+  if (mConfig.resumeTrend && mTrend != nullptr && mChunk != nullptr) {
+    ILOG(Info, Support) << "Will continue the trend from the previous run." << ENDM;
+    return;
+  }
+
+  mTrend = createTree(PostProcessingInterface::getName());
+  mChunk = createTree(getChunkName());
+  mChunkKey.clear();
+  mTrendChunks.clear();
+  if (mConfig.resumeTrend) {
+    loadTrendChunks(qcdb);
+  }
+}
+
+void TrendingTask::loadTrendChunks(repository::DatabaseInterface& qcdb)
+{
+  // we need to list the chunks, which is supported only by CCDB
+  auto ccdb = dynamic_cast<repository::CcdbDatabase*>(&qcdb);
+  if (ccdb == nullptr) {
+    ILOG(Warning, Support) << "The stored trend chunks can be listed only in a CCDB database, a new trend will be started." << ENDM;
+    return;
+  }
+
+  struct ChunkVersion {
+    std::string key;
+    long validFrom = 0;
+    uint64_t lastModified = 0;
+  };
+  // chunk order -> the latest version of the chunk, which contains all its points
+  std::map<uint64_t, ChunkVersion> chunks;
+  const auto path = RepoPathUtils::getMoPath(mConfig.detectorName, PostProcessingInterface::getName(), getChunkName());
+  const auto prefix = mConfig.trendChunks == "run" ? "run_" : "time_";
+  try {
+    auto listing = ccdb->getListingAsPtree(path);
+    for (const auto& [_, entry] : listing.get_child("objects")) {
+      auto key = entry.get<std::string>(trendChunkKey, "");
+      auto order = getChunkOrder(key, prefix);
+      if (!order.has_value()) {
+        continue; // probably stored with a different chunk configuration
+      }
+      auto lastModified = entry.get<uint64_t>(repository::metadata_keys::lastModified, 0);
+      auto& version = chunks[order.value()];
+      if (version.key.empty() || version.lastModified < lastModified) {
+        version = { key, entry.get<long>(repository::metadata_keys::validFrom), lastModified };
+      }
+    }
+  } catch (const std::exception& ex) {
+    ILOG(Warning, Support) << "Could not list the trend chunks in '" << path << "', a new trend will be started: " << ex.what() << ENDM;
+    return;
+  }
 
-    mTrend->Branch("meta", &mMetaData, mMetaData.getBranchLeafList());
-    mTrend->Branch("time", &mTime);
-    for (const auto& [sourceName, reductor] : mReductors) {
-      mTrend->Branch(sourceName.c_str(), reductor->getBranchAddress(), reductor->getBranchLeafList());
+  // only the chunks which are plotted are retrieved
+  auto first = chunks.begin();
+  if (mConfig.trendChunksInPlots > 0 && chunks.size() > mConfig.trendChunksInPlots) {
+    std::advance(first, chunks.size() - mConfig.trendChunksInPlots);
+  }
+  ILOG(Info, Support) << "Found " << chunks.size() << " trend chunks in '" << path << "', will retrieve " << std::distance(first, chunks.end()) << " of them." << ENDM;
+
+  for (auto it = first; it != chunks.end(); ++it) {
+    const auto& version = it->second;
+    std::unique_ptr<TObject> object(qcdb.retrieveTObject(path, { { trendChunkKey, version.key } }, version.validFrom));
+    auto chunk = dynamic_cast<TTree*>(object.get());
+    if (!canContinueTrend(chunk)) {
+      ILOG(Warning, Support) << "Could not use the trend chunk '" << version.key << "', skipping it." << ENDM;
+      continue;
+    }
+    setBranchAddresses(chunk);
+    const bool lastChunk = std::next(it) == chunks.end();
+    for (Long64_t i = 0; i < chunk->GetEntries(); i++) {
+      chunk->GetEntry(i);
+      mTrend->Fill();
+      // the last chunk may be continued, thus we have to keep its points as well
+      if (lastChunk) {
+        mChunk->Fill();
+      }
+    }
+    mTrendChunks.emplace_back(version.key, chunk->GetEntries());
+    if (lastChunk) {
+      mChunkKey = version.key;
     }
   }
+  ILOG(Info, Support) << "Will continue the trend with " << mTrend->GetEntries() << " points from " << mTrendChunks.size() << " chunks." << ENDM;
+}
+
+std::unique_ptr<TTree> TrendingTask::createTree(const std::string& name)
+{
+  auto tree = std::make_unique<TTree>();
+  tree->SetName(name.c_str());
+
+  tree->Branch("meta", &mMetaData, mMetaData.getBranchLeafList());
+  tree->Branch("time", &mTime);
+  for (const auto& [sourceName, reductor] : mReductors) {
+    tree->Branch(sourceName.c_str(), reductor->getBranchAddress(), reductor->getBranchLeafList());
+  }
+  return tree;
+}
+
+void TrendingTask::setBranchAddresses(TTree* tree)
+{
+  tree->SetBranchAddress("meta", &mMetaData);
+  tree->SetBranchAddress("time", &mTime);
+  for (const auto& [sourceName, reductor] : mReductors) {
+    tree->SetBranchAddress(sourceName.c_str(), reductor->getBranchAddress());
+  }
+}
+
+std::string TrendingTask::getChunkName() const
+{
+  return PostProcessingInterface::getName() + "_chunk";
+}
+
+std::string TrendingTask::getChunkKey(const Trigger& t, UInt_t time) const
+{
+  if (mConfig.trendChunks == "run") {
+    return "run_" + std::to_string(t.activity.mId);
+  }
+  auto period = static_cast<uint64_t>(mConfig.trendChunkPeriodSeconds);
+  return "time_" + std::to_string(time / period * period);
+}
+
+void TrendingTask::switchChunk(const std::string& chunkKey)
+{
+  // the previous chunk was already uploaded with all its points after the last update
+  mChunk->Reset();
+  mChunkKey = chunkKey;
+  getObjectsManager()->addOrUpdateMetadata(getChunkName(), trendChunkKey, mChunkKey);
+  mTrendChunks.emplace_back(chunkKey, 0);
+
+  if (mConfig.trendChunksInPlots == 0 || mTrendChunks.size() <= mConfig.trendChunksInPlots) {
+    return;
+  }
+  // The oldest chunks are dropped from the plotted trend. TTrees do not allow to remove entries,
+  // so we copy the remaining ones to a new tree. It happens only once per chunk.
+  Long64_t droppedEntries = 0;
+  while (mTrendChunks.size() > mConfig.trendChunksInPlots) {
+    droppedEntries += mTrendChunks.front().second;
+    mTrendChunks.pop_front();
+  }
+  auto trend = createTree(PostProcessingInterface::getName());
+  for (Long64_t i = droppedEntries; i < mTrend->GetEntries(); i++) {
+    mTrend->GetEntry(i);
+    trend->Fill();
+  }
+  mTrend = std::move(trend);
 }
 
 void TrendingTask::initialize(Trigger, framework::ServiceRegistryRef services)
@@ -148,7 +317,13 @@ void TrendingTask::initialize(Trigger, framework::ServiceRegistryRef services)
 
   initializeTrend(services.get<repository::DatabaseInterface>());
 
-  if (mConfig.producePlotsOnUpdate) {
+  if (!mConfig.trendChunks.empty()) {
+    // only the current chunk is stored, the plotted trend stays in memory
+    getObjectsManager()->startPublishing(mChunk.get(), PublicationPolicy::ThroughStop);
+    if (!mChunkKey.empty()) {
+      getObjectsManager()->addOrUpdateMetadata(getChunkName(), trendChunkKey, mChunkKey);
+    }
+  } else if (mConfig.producePlotsOnUpdate) {
     getObjectsManager()->startPublishing(mTrend.get(), PublicationPolicy::ThroughStop);
   }
 }
@@ -166,7 +341,7 @@ void TrendingTask::update(Trigger t, framework::ServiceRegistryRef services)
 
 void TrendingTask::finalize(Trigger, framework::ServiceRegistryRef)
 {
-  if (!mConfig.producePlotsOnUpdate) {
+  if (!mConfig.producePlotsOnUpdate && mConfig.trendChunks.empty()) {
     getObjectsManager()->startPublishing(mTrend.get());
   }
   generatePlots();
@@ -174,14 +349,22 @@ void TrendingTask::finalize(Trigger, framework::ServiceRegistryRef)
 
 bool TrendingTask::trendValues(const Trigger& t, repository::DatabaseInterface& qcdb)
 {
+  UInt_t time;
   if (mConfig.trendingTimestamp == "trigger") {
     // ROOT expects seconds since epoch.
-    mTime = t.timestamp / 1000;
+    time = t.timestamp / 1000;
   } else if (mConfig.trendingTimestamp == "validFrom") {
-    mTime = t.activity.mValidity.getMin() / 1000;
+    time = t.activity.mValidity.getMin() / 1000;
   } else { // validUntil
-    mTime = t.activity.mValidity.getMax() / 1000;
+    time = t.activity.mValidity.getMax() / 1000;
+  }
+  // switching chunks might reuse the branch buffers, so it has to happen before we set any new values
+  if (!mConfig.trendChunks.empty()) {
+    if (auto chunkKey = getChunkKey(t, time); chunkKey != mChunkKey) {
+      switchChunk(chunkKey);
+    }
   }
+  mTime = time;
   mMetaData.runNumber = t.activity.mId;
   bool wereAllSourcesInvoked = true;
 
@@ -196,6 +379,10 @@ bool TrendingTask::trendValues(const Trigger& t, repository::DatabaseInterface&
 
   if (!mConfig.trendIfAllInputs || wereAllSourcesInvoked) {
     mTrend->Fill();
+    if (mChunk != nullptr) {
+      mChunk->Fill();
+      mTrendChunks.back().second++;
+    }
   }
 
   return wereAllSourcesInvoked;
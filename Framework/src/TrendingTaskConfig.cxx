@@ -15,6 +15,7 @@
 ///
 
 #include "QualityControl/TrendingTaskConfig.h"
+#include "QualityControl/TriggerHelpers.h"
 #include <boost/property_tree/ptree.hpp>
 
 namespace o2::quality_control::postprocessing
@@ -27,6 +28,15 @@ TrendingTaskConfig::TrendingTaskConfig(std::string id, const boost::property_tre
   resumeTrend = config.get<bool>("qc.postprocessing." + id + ".resumeTrend", false);
   trendIfAllInputs = config.get<bool>("qc.postprocessing." + id + ".trendIfAllInputs", false);
   trendingTimestamp = config.get<std::string>("qc.postprocessing." + id + ".trendingTimestamp", "validUntil");
+  trendChunks = config.get<std::string>("qc.postprocessing." + id + ".trendChunks", "");
+  if (!trendChunks.empty() && trendChunks != "run") {
+    auto seconds = trigger_helpers::string2Seconds(trendChunks);
+    if (!seconds.has_value() || seconds.value() < 1) {
+      throw std::runtime_error("Unexpected value of 'trendChunks' in 'qc.postprocessing." + id + "': '" + trendChunks + "', it should be 'run' or a duration, e.g. '24hour'");
+    }
+    trendChunkPeriodSeconds = seconds.value();
+  }
+  trendChunksInPlots = config.get<size_t>("qc.postprocessing." + id + ".trendChunksInPlots", 0);
 
   for (const auto& [_, plotConfig] : config.get_child("qc.postprocessing." + id + ".plots")) {
     // since QC-1155 we allow for more than one graph in a single plot (canvas). we support both the new and old ways
@@ -105,7 +105,7 @@ TriggerFcn triggerFactory(const std::string& trigger, const PostProcessingConfig
   } else if (triggerLowerCase.find("newobject") != std::string::npos) {
     const auto [db, objectPath] = parseDbTriggers(trigger, "newobject");
     const std::string& dbUrl = db == "qcdb" ? config.qcdbUrl : config.ccdbUrl;
-    return triggers::NewObject(dbUrl, db, objectPath, activity, trigger);
+    return triggers::NewObject(dbUrl, db, objectPath, activity, trigger, config.newObjectPollingPeriodSeconds);
   } else if (triggerLowerCase.find("foreachobject") != std::string::npos) {
     const auto [db, objectPath] = parseDbTriggers(trigger, "foreachobject");
     const std::string& dbUrl = db == "qcdb" ? config.qcdbUrl : config.ccdbUrl;
@@ -20,14 +20,20 @@
 #include "QualityControl/CcdbDatabase.h"
 #include "QualityControl/ObjectMetadataKeys.h"
 #include "QualityControl/KafkaPoller.h"
+#include "QualityControl/ObjectListingPoller.h"
+#include "QualityControl/RepoPathUtils.h"
 
 #include <CCDB/CcdbApi.h>
 #include <Common/Timer.h>
+#include <algorithm>
 #include <chrono>
+#include <optional>
 #include <ostream>
+#include <thread>
 #include <tuple>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
+#include <boost/algorithm/string.hpp>
 
 using namespace std::chrono;
 using namespace o2::quality_control::core;
@@ -189,63 +195,108 @@ TriggerFcn Periodic(double seconds, const Activity& activity, std::string config
   };
 }
 
-TriggerFcn NewObject(const std::string& databaseUrl, const std::string& databaseType, const std::string& objectPath, const Activity& activity, const std::string& config)
+std::string publicationMarkerPath(const std::string& databaseType, const std::string& objectPath, const Activity& activity)
+{
+  // Only the MOs stored by CheckRunners are followed by publication markers, i.e. <det>/MO/<task>/<object>
+  std::vector<std::string> tokens;
+  boost::split(tokens, objectPath, boost::is_any_of("/"));
+  if (databaseType != "qcdb" || tokens.size() < 4 || tokens[1] != "MO") {
+    return {};
+  }
+  return RepoPathUtils::getMoPath(tokens[0], tokens[2], RepoPathUtils::publicationMarkerName, activity.mProvenance);
+}
+
+TriggerFcn NewObject(const std::string& databaseUrl, const std::string& databaseType, const std::string& objectPath, const Activity& activity, const std::string& config, double pollingPeriodSeconds)
 {
-  // Key names in the header map.
-  constexpr auto timestampKey = metadata_keys::validFrom;
   auto fullObjectPath = (databaseType == "qcdb" ? activity.mProvenance + "/" : "") + objectPath;
+  auto markerPath = publicationMarkerPath(databaseType, objectPath, activity);
   auto metadata = databaseType == "qcdb" ? activity_helpers::asDatabaseMetadata(activity, false) : std::map<std::string, std::string>();
   auto objectActivity = activity;
+  auto maxListingAge = duration_cast<steady_clock::duration>(duration<double>(std::max(pollingPeriodSeconds, 0.0)));
 
   ILOG(Debug, Support) << "Initializing newObject trigger for the object '" << fullObjectPath << "' and Activity '" << activity << "'" << ENDM;
-  // We support only CCDB here.
-  auto db = std::make_shared<repository::CcdbDatabase>();
-  db->connect(databaseUrl, "", "", "");
-
-  // Returns "Valid-From" of an object if there is a new one, otherwise 0.
-  auto newObjectValidity = [db, fullObjectPath, metadata, databaseUrl, activity, lastModified = validity_time_t{ 0 }]() mutable -> ValidityInterval {
-    const auto listing = db->getListingAsPtree(fullObjectPath, metadata, true);
-    if (listing.count("objects") == 0) {
-      ILOG(Warning, Support) << "Could not get a valid listing from db '" << databaseUrl << "' for object '" << fullObjectPath << "'" << ENDM;
-      return gInvalidValidityInterval;
+  // The listings are shared with other triggers watching objects in the same directory.
+  auto poller = ObjectListingPoller::getShared(databaseUrl);
+
+  // Returns the validity and the modification time of the object if there is a new one, otherwise an invalid interval.
+  auto newObjectVersion = [poller, fullObjectPath, metadata, maxListingAge, databaseUrl, activity, lastModified = validity_time_t{ 0 }]() mutable -> std::pair<ValidityInterval, validity_time_t> {
+    const auto object = poller->getLatest(fullObjectPath, metadata, maxListingAge);
+    if (!object.has_value()) {
+      // the poller has already complained
+      return { gInvalidValidityInterval, 0 };
     }
-    const auto& objects = listing.get_child("objects");
-    if (objects.empty()) {
+    if (object->empty()) {
       // We don't make a fuss over it, because we might be just waiting for the first version of such object.
       // Apparently it happens always for a few iterations at SOR, so Warnings might be too annoying.
       ILOG(Debug, Devel) << "Could not find the file '" << fullObjectPath << "' in the db '"
                          << databaseUrl << "' for given Activity settings (" << activity << "). Zeroes and empty strings are treated as wildcards." << ENDM;
-      return gInvalidValidityInterval;
-    } else if (objects.size() > 1) {
-      ILOG(Warning, Support) << "Expected just one metadata entry for object '" << fullObjectPath << "'. Trying to continue by using the first." << ENDM;
+      return { gInvalidValidityInterval, 0 };
     }
 
-    const auto& object = objects.front().second;
-    validity_time_t newLastModified = object.get<uint64_t>(metadata_keys::lastModified, 0);
+    validity_time_t newLastModified = object->get<uint64_t>(metadata_keys::lastModified, 0);
     if (newLastModified > lastModified) {
       lastModified = newLastModified;
-      return { object.get<uint64_t>(metadata_keys::validFrom, 0), object.get<uint64_t>(metadata_keys::validUntil) };
+      return { { object->get<uint64_t>(metadata_keys::validFrom, 0), object->get<uint64_t>(metadata_keys::validUntil) }, newLastModified };
     }
-    return gInvalidValidityInterval;
+    return { gInvalidValidityInterval, 0 };
   };
   // we execute it once before in order to know about the latest existing object.
-  newObjectValidity();
-
-  return [objectActivity, config, newObjectValidity]() mutable -> Trigger {
-    if (auto validity = newObjectValidity(); validity.isValid()) {
-      if (getenv("QC_DISABLE_NEWOBJECT_DELAY") == nullptr) {
-        // On rare occasions we might run into the following race condition:
-        // 1) A CheckRunner starts to publish a collection of MOs for a QC Task
-        // 2) A PostProcessing task receives a newobject trigger for a just-published object
-        // 3) The PP task tries to retrieve also other objects normally published by the same QC task, it fails
-        //    because not all were published yet.
-        // 4) The CheckRunner finishes publishing the collection of MOs
-        // To avoid this scenario, a small delay is added before returning the trigger. Considerations about other
-        // possible solutions are included in the commit message.
-        std::this_thread::sleep_for(std::chrono::seconds{ 1 });
+  newObjectVersion();
+
+  // Tells whether all the objects published together with the new version are available as well.
+  // On rare occasions we might run into the following race condition:
+  // 1) A CheckRunner starts to publish a collection of MOs for a QC Task
+  // 2) A PostProcessing task receives a newobject trigger for a just-published object
+  // 3) The PP task tries to retrieve also other objects normally published by the same QC task, it fails
+  //    because not all were published yet.
+  // 4) The CheckRunner finishes publishing the collection of MOs
+  // CheckRunners store a publication marker after the MOs of each task, thus we wait until the marker is more recent
+  // than the new object. If there are no markers (other kind of objects, older CheckRunners or disabled markers),
+  // a small delay is added before returning the trigger instead.
+  // The marker might also stop being updated, e.g. if the CheckRunner was restarted with the markers disabled or crashed
+  // between storing the MOs and the marker. Thus we do not wait for it longer than maxMarkerWait and we use the delay
+  // as long as this marker version is not replaced by a newer one.
+  constexpr auto maxMarkerWait = seconds{ 10 };
+  auto isPublicationComplete = [poller, markerPath, metadata, maxListingAge, markersSeen = false, abandonedMarker = std::optional<validity_time_t>{},
+                                waitedObject = validity_time_t{ 0 }, waitStart = steady_clock::time_point{}](validity_time_t objectLastModified) mutable -> bool {
+    if (!markerPath.empty()) {
+      const auto marker = poller->getLatest(markerPath, metadata, maxListingAge);
+      if (!marker.has_value()) {
+        return false; // we will try again at the next call
       }
-      objectActivity.mValidity = validity;
-      auto timestamp = activity_helpers::isLegacyValidity(validity) ? validity.getMin() : (validity.getMax() - 1);
+      markersSeen = markersSeen || !marker->empty();
+      const validity_time_t markerLastModified = marker->get<uint64_t>(metadata_keys::lastModified, 0);
+      if (markersSeen && markerLastModified >= objectLastModified) {
+        return true;
+      }
+      if (markersSeen && markerLastModified != abandonedMarker) {
+        if (waitedObject != objectLastModified) {
+          waitedObject = objectLastModified;
+          waitStart = steady_clock::now();
+        }
+        if (steady_clock::now() - waitStart < maxMarkerWait) {
+          return false;
+        }
+        ILOG(Warning, Support) << "The publication marker '" << markerPath << "' was not updated within " << maxMarkerWait.count()
+                               << "s after a new object was stored, using a fixed delay until it is updated again" << ENDM;
+        abandonedMarker = markerLastModified;
+      }
+    }
+    if (getenv("QC_DISABLE_NEWOBJECT_DELAY") == nullptr) {
+      std::this_thread::sleep_for(std::chrono::seconds{ 1 });
+    }
+    return true;
+  };
+
+  return [objectActivity, config, newObjectVersion, isPublicationComplete, pendingValidity = gInvalidValidityInterval, pendingLastModified = validity_time_t{ 0 }]() mutable -> Trigger {
+    if (auto [validity, lastModified] = newObjectVersion(); validity.isValid()) {
+      pendingValidity = validity;
+      pendingLastModified = lastModified;
+    }
+    if (pendingValidity.isValid() && isPublicationComplete(pendingLastModified)) {
+      objectActivity.mValidity = pendingValidity;
+      pendingValidity = gInvalidValidityInterval;
+      auto timestamp = activity_helpers::isLegacyValidity(objectActivity.mValidity) ? objectActivity.mValidity.getMin() : (objectActivity.mValidity.getMax() - 1);
       return { TriggerType::NewObject, false, objectActivity, timestamp, config };
     }
     objectActivity.mValidity = gInvalidValidityInterval;
@@ -14,6 +14,7 @@
 /// \author Barthelemy von Haller
 ///
 
+#include <algorithm>
 #include <utility>
 
 #include "QualityControl/UpdatePolicyManager.h"
@@ -33,19 +34,33 @@ void UpdatePolicyManager::updateGlobalRevision()
     // mGlobalRevision cannot be 0
     // 0 means overflow, increment and update all check revisions to 0
     ++mGlobalRevision;
-    for (auto& actor : mPoliciesByActor) {
-      updateActorRevision(actor.second.actorName, 0);
+    for (auto& policy : mPolicies) {
+      updateActorRevision(policy.actorName, 0);
+    }
+  }
+}
+
+void UpdatePolicyManager::countNewerInputs(UpdatePolicy& policy)
+{
+  policy.newerInputs = 0;
+  for (auto objectId : policy.inputObjectIds) {
+    const auto& object = mObjects[objectId];
+    if (object.received && object.revision > policy.revision) {
+      policy.newerInputs++;
     }
   }
 }
 
 void UpdatePolicyManager::updateActorRevision(const std::string& actorName, RevisionType revision)
 {
-  if (mPoliciesByActor.count(actorName) == 0) {
+  auto it = mActorIds.find(actorName);
+  if (it == mActorIds.end()) {
     ILOG(Error, Support) << "Cannot update revision for " << actorName << " : object not found" << ENDM;
     BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(actorName));
   }
-  mPoliciesByActor.at(actorName).revision = revision;
+  auto& policy = mPolicies[it->second];
+  policy.revision = revision;
+  countNewerInputs(policy);
 }
 
 void UpdatePolicyManager::updateActorRevision(const std::string& actorName)
@@ -53,9 +68,33 @@ void UpdatePolicyManager::updateActorRevision(const std::string& actorName)
   updateActorRevision(actorName, mGlobalRevision);
 }
 
+size_t UpdatePolicyManager::getObjectId(const std::string& objectName)
+{
+  auto [it, inserted] = mObjectIds.try_emplace(objectName, mObjects.size());
+  if (inserted) {
+    mObjects.emplace_back();
+  }
+  return it->second;
+}
+
 void UpdatePolicyManager::updateObjectRevision(const std::string& objectName, RevisionType revision)
 {
-  mObjectsRevision[objectName] = revision;
+  auto& object = mObjects[getObjectId(objectName)];
+  for (auto actorId : object.dependentActors) {
+    auto& policy = mPolicies[actorId];
+    if (!object.received) {
+      policy.missingInputs--;
+    }
+    bool wasNewer = object.received && object.revision > policy.revision;
+    bool isNewer = revision > policy.revision;
+    if (isNewer && !wasNewer) {
+      policy.newerInputs++;
+    } else if (!isNewer && wasNewer) {
+      policy.newerInputs--;
+    }
+  }
+  object.revision = revision;
+  object.received = true;
 }
 
 void UpdatePolicyManager::updateObjectRevision(const std::string& objectName)
@@ -65,25 +104,30 @@ void UpdatePolicyManager::updateObjectRevision(const std::string& objectName)
 
 void UpdatePolicyManager::addPolicy(const std::string& actorName, UpdatePolicyType policyType, std::vector<std::string> objectNames, bool allObjects, bool policyHelper)
 {
+  auto [actorIt, newActor] = mActorIds.try_emplace(actorName, mPolicies.size());
+  const size_t actorId = actorIt->second;
+  if (newActor) {
+    mPolicies.emplace_back();
+  } else {
+    // the policy is replaced, we forget the dependencies of the previous one
+    for (auto objectId : mPolicies[actorId].inputObjectIds) {
+      auto& dependentActors = mObjects[objectId].dependentActors;
+      dependentActors.erase(std::remove(dependentActors.begin(), dependentActors.end(), actorId), dependentActors.end());
+    }
+  }
+
+  // QC-1033 - failure to use OnAll and OnAnyNonZero policies with checks producing single QO
+  bool removeFinalSlash = policyType == UpdatePolicyType::OnAll || policyType == UpdatePolicyType::OnAnyNonZero;
+
   IsReadyFunctionType isReadyFunction;
   switch (policyType) {
     case UpdatePolicyType::OnAll: {
       /**
        * Run check if all MOs are updated
        */
-      isReadyFunction = [&, actorName]() {
-        for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-          // QC-1033 - failure to use this policy with checks producing single QO
-          std::string objectNameLocal = objectName;
-          if (objectNameLocal.back() == '/') {
-            ILOG(Debug, Devel) << "OnAll - remove the final slash" << ENDM;
-            objectNameLocal.pop_back();
-          }
-          if (mObjectsRevision.count(objectNameLocal) == 0 || mObjectsRevision.at(objectNameLocal) <= mPoliciesByActor.at(actorName).revision) {
-            return false;
-          }
-        }
-        return true;
+      isReadyFunction = [this, actorId]() {
+        const auto& policy = mPolicies[actorId];
+        return policy.missingInputs == 0 && policy.newerInputs == policy.inputObjectIds.size();
       };
       break;
     }
@@ -92,36 +136,17 @@ void UpdatePolicyManager::addPolicy(const std::string& actorName, UpdatePolicyTy
        * Return true if any declared MOs were updated
        * Guarantee that all declared MOs are available
        */
-      isReadyFunction = [&, actorName]() {
-        if (!mPoliciesByActor.at(actorName).policyHelperFlag) {
+      isReadyFunction = [this, actorId]() {
+        auto& policy = mPolicies[actorId];
+        if (!policy.policyHelperFlag) {
           // Check if all monitor objects are available
-          for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-            // QC-1033 - failure to use this policy with checks producing single QO
-            std::string objectNameLocal = objectName;
-            if (objectNameLocal.back() == '/') {
-              ILOG(Debug, Devel) << "OnAnyNonZero - remove the final slash" << ENDM;
-              objectNameLocal.pop_back();
-            }
-
-            if (!mObjectsRevision.count(objectNameLocal)) {
-              return false;
-            }
+          if (policy.missingInputs > 0) {
+            return false;
           }
           // From now on all MOs are available
-          mPoliciesByActor.at(actorName).policyHelperFlag = true;
-        }
-
-        for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-          std::string objectNameLocal = objectName;
-          if (objectNameLocal.back() == '/') {
-            ILOG(Debug, Devel) << "OnAnyNonZero - remove the final slash" << ENDM;
-            objectNameLocal.pop_back();
-          }
-          if (mObjectsRevision[objectNameLocal] > mPoliciesByActor.at(actorName).revision) {
-            return true;
-          }
+          policy.policyHelperFlag = true;
         }
-        return false;
+        return policy.newerInputs > 0;
       };
       break;
     }
@@ -130,17 +155,9 @@ void UpdatePolicyManager::addPolicy(const std::string& actorName, UpdatePolicyTy
         * Return true if any declared object were updated.
         * This is the same behaviour as OnAny.
         */
-      isReadyFunction = [&, actorName]() {
-        if (mPoliciesByActor.at(actorName).allInputObjects) {
-          return true;
-        }
-
-        for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-          if (mObjectsRevision.count(objectName) && mObjectsRevision[objectName] > mPoliciesByActor.at(actorName).revision) {
-            return true;
-          }
-        }
-        return false;
+      isReadyFunction = [this, actorId]() {
+        const auto& policy = mPolicies[actorId];
+        return policy.allInputObjects || policy.newerInputs > 0;
       };
       break;
     }
@@ -163,30 +180,49 @@ void UpdatePolicyManager::addPolicy(const std::string& actorName, UpdatePolicyTy
        *
        * Return true if any MOs are updated
        */
-      isReadyFunction = [&, actorName]() {
-        for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-          if (mObjectsRevision.count(objectName) && mObjectsRevision[objectName] > mPoliciesByActor.at(actorName).revision) {
-            return true;
-          }
-        }
-        return false;
+      isReadyFunction = [this, actorId]() {
+        return mPolicies[actorId].newerInputs > 0;
       };
       break;
     }
   }
 
-  mPoliciesByActor[actorName] = { actorName, isReadyFunction, std::move(objectNames), allObjects, policyHelper };
+  std::vector<size_t> inputObjectIds;
+  for (const auto& objectName : objectNames) {
+    std::string objectNameLocal = objectName;
+    if (removeFinalSlash && !objectNameLocal.empty() && objectNameLocal.back() == '/') {
+      ILOG(Debug, Devel) << "Removing the final slash of " << objectName << ENDM;
+      objectNameLocal.pop_back();
+    }
+    auto objectId = getObjectId(objectNameLocal);
+    if (std::find(inputObjectIds.begin(), inputObjectIds.end(), objectId) == inputObjectIds.end()) {
+      inputObjectIds.push_back(objectId);
+    }
+  }
+
+  auto& policy = mPolicies[actorId];
+  policy = { actorName, isReadyFunction, std::move(objectNames), allObjects, policyHelper };
+  policy.inputObjectIds = std::move(inputObjectIds);
+  for (auto objectId : policy.inputObjectIds) {
+    auto& object = mObjects[objectId];
+    object.dependentActors.push_back(actorId);
+    if (!object.received) {
+      policy.missingInputs++;
+    }
+  }
+  countNewerInputs(policy);
 
-  ILOG(Info, Devel) << "Added a policy : " << mPoliciesByActor[actorName] << ENDM;
+  ILOG(Info, Devel) << "Added a policy : " << policy << ENDM;
 }
 
 bool UpdatePolicyManager::isReady(const std::string& actorName)
 {
-  if (mPoliciesByActor.count(actorName) == 0) {
+  auto it = mActorIds.find(actorName);
+  if (it == mActorIds.end()) {
     ILOG(Error, Support) << "Cannot check if " << actorName << " is ready : object not found" << ENDM;
     BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(actorName));
   }
-  return mPoliciesByActor.at(actorName).isReady();
+  return mPolicies[it->second].isReady();
 }
 
 std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy) // output
@@ -204,8 +240,10 @@ std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy) //
 
 void UpdatePolicyManager::reset()
 {
-  mPoliciesByActor.clear();
-  mObjectsRevision.clear();
+  mActorIds.clear();
+  mPolicies.clear();
+  mObjectIds.clear();
+  mObjects.clear();
   mGlobalRevision = 1;
 }
 
@@ -15,6 +15,9 @@
 ///
 
 #include "QualityControl/UserCodeInterface.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <algorithm>
 
 using namespace o2::ccdb;
 
@@ -24,9 +27,44 @@ namespace o2::quality_control::core
 void UserCodeInterface::setCustomParameters(const CustomParameters& parameters)
 {
   mCustomParameters = parameters;
+  mValidatedRunBeamTypes.clear();
   configure();
 }
 
+void UserCodeInterface::resolveCustomParameters(const Activity& activity)
+{
+  mResolvedCustomParameters = ResolvedCustomParameters(mCustomParameters, activity);
+
+  const auto runBeamType = activity.mType + "/" + activity.mBeamType;
+  if (std::find(mValidatedRunBeamTypes.begin(), mValidatedRunBeamTypes.end(), runBeamType) != mValidatedRunBeamTypes.end()) {
+    return;
+  }
+  mValidatedRunBeamTypes.push_back(runBeamType);
+  const auto expected = getExpectedCustomParameters();
+  if (expected.empty()) {
+    return;
+  }
+  const auto report = mResolvedCustomParameters.validate(expected);
+  for (const auto& key : report.unknownKeys) {
+    ILOG(Warning, Support) << "Custom parameter '" << key << "' of '" << mName << "' is not used (run type " << activity.mType
+                           << ", beam type " << activity.mBeamType << ")" << ENDM;
+  }
+  for (const auto& malformed : report.malformedKeys) {
+    ILOG(Error, Support) << "Custom parameter of '" << mName << "' cannot be parsed, its default value will be used: " << malformed
+                         << " (run type " << activity.mType << ", beam type " << activity.mBeamType << ")" << ENDM;
+  }
+}
+
+const ResolvedCustomParameters& UserCodeInterface::getResolvedCustomParameters() const
+{
+  return mResolvedCustomParameters;
+}
+
+std::vector<ResolvedCustomParameters::Expected> UserCodeInterface::getExpectedCustomParameters() const
+{
+  return {};
+}
+
 const std::string& UserCodeInterface::getName() const { return mName; }
 
 void UserCodeInterface::setName(const std::string& name) { mName = name; }
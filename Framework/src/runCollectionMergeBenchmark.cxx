@@ -0,0 +1,117 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    runCollectionMergeBenchmark.cxx
+///
+/// \brief Measures the time needed to merge two MonitorObjectCollections depending on the number of objects they contain.
+///
+
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Timer.h>
+#include <TH1F.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
+
+std::unique_ptr<MonitorObjectCollection> createCollection(size_t numberOfObjects, int bins)
+{
+  auto collection = std::make_unique<MonitorObjectCollection>();
+  collection->SetOwner(true);
+  for (size_t i = 0; i < numberOfObjects; i++) {
+    auto name = "histogram_" + std::to_string(i);
+    auto histogram = new TH1F(name.c_str(), name.c_str(), bins, 0, bins);
+    histogram->SetDirectory(nullptr);
+    histogram->Fill(i % bins);
+    auto mo = new MonitorObject(histogram, "benchmark", "Benchmark", "TST");
+    mo->setIsOwner(true);
+    collection->Add(mo);
+  }
+  return collection;
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                                                               //
+    ("help,h", "Help screen")                                                                                                                      //
+    ("sizes", bpo::value<std::vector<size_t>>()->multitoken()->default_value({ 10, 100, 1000, 10000 }, "10 100 1000 10000"), "Numbers of objects") //
+    ("repetitions", bpo::value<size_t>()->default_value(10), "Number of merges measured for each size")                                            //
+    ("bins", bpo::value<int>()->default_value(10), "Number of bins of the merged histograms");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+
+  const auto repetitions = std::max<size_t>(1, vm["repetitions"].as<size_t>());
+  const auto bins = vm["bins"].as<int>();
+  ILOG_INST.filterDiscardDebug(true);
+
+  std::cout << std::setw(10) << "objects"
+            << std::setw(20) << "merge [ms]"
+            << std::setw(20) << "per object [us]"
+            << std::setw(20) << "lookups [ms]"
+            << std::setw(24) << "linear lookups [ms]" << std::endl;
+
+  for (auto size : vm["sizes"].as<std::vector<size_t>>()) {
+    auto target = createCollection(size, bins);
+    auto other = createCollection(size, bins);
+
+    AliceO2::Common::Timer timer;
+    double mergeDuration = 0;
+    for (size_t i = 0; i < repetitions; i++) {
+      timer.reset();
+      target->merge(other.get());
+      mergeDuration += timer.getTime();
+    }
+
+    // the lookups alone, compared to the linear search of TObjArray which was used before
+    double lookupDuration = 0;
+    double linearLookupDuration = 0;
+    size_t found = 0;
+    for (size_t i = 0; i < repetitions; i++) {
+      timer.reset();
+      for (auto* object : *other) {
+        found += target->FindObject(object->GetName()) != nullptr;
+      }
+      lookupDuration += timer.getTime();
+      timer.reset();
+      for (auto* object : *other) {
+        found += target->TObjArray::FindObject(object->GetName()) != nullptr;
+      }
+      linearLookupDuration += timer.getTime();
+    }
+    if (found != 2 * size * repetitions) {
+      std::cerr << "Some objects were not found, the benchmark is not valid" << std::endl;
+      return 1;
+    }
+
+    std::cout << std::setw(10) << size
+              << std::setw(20) << mergeDuration / repetitions * 1e3
+              << std::setw(20) << (size > 0 ? mergeDuration / repetitions / size * 1e6 : 0)
+              << std::setw(20) << lookupDuration / repetitions * 1e3
+              << std::setw(24) << linearLookupDuration / repetitions * 1e3 << std::endl;
+  }
+
+  return 0;
+}
@@ -17,6 +17,7 @@
 
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/ThreadPool.h"
 
 #include <string>
 #include <unordered_map>
@@ -24,9 +25,15 @@
 #include <filesystem>
 #include <boost/program_options.hpp>
 #include <boost/exception/diagnostic_information.hpp>
+#include <Common/Timer.h>
 #include <TFile.h>
+#include <TH1.h>
 #include <TKey.h>
 #include <TGrid.h>
+#include <TROOT.h>
+#include <atomic>
+#include <mutex>
+#include <set>
 #include <variant>
 
 namespace bpo = boost::program_options;
@@ -48,9 +55,279 @@ struct Node {
   std::string getFullPath() const { return pathTo + std::filesystem::path::preferred_separator + name; }
 };
 
+using ErrorHandler = std::function<void(const std::string&)>;
+
+struct MergeStatistics {
+  std::atomic<size_t> filesRead = 0;
+  std::atomic<uint64_t> bytesRead = 0;
+};
+
+void deleteRecursively(Node& node)
+{
+  for (auto& [name, value] : node.children) {
+    std::visit(overloaded{
+                 [](Node& child) { deleteRecursively(child); },
+                 [](MonitorObjectCollection* moc) { delete moc; } },
+               value);
+  }
+  node.children.clear();
+}
+
+// Merges the content of a directory of an input file into the memory node.
+// If onlyKey is not empty, only the key with this name is considered.
+void mergeRecursively(TDirectory* fileNode, Node& memoryNode, const std::vector<std::string>& excludedDirectories, const std::string& onlyKey, const ErrorHandler& handleError)
+{
+  if (fileNode == nullptr) {
+    ILOG(Error) << "Provided parentNode pointer is null, skipping." << ENDM;
+    return;
+  }
+  TIter next(fileNode->GetListOfKeys());
+  TKey* key;
+  while ((key = (TKey*)next())) {
+    if (!onlyKey.empty() && onlyKey != key->GetName()) {
+      continue;
+    }
+    // we look for exact matches here. we skip if there are no subdirectories
+    if (std::find(excludedDirectories.begin(), excludedDirectories.end(), key->GetName()) != excludedDirectories.end()) {
+      ILOG(Info, Support) << "Skipping '" << key->GetName() << "' as requested in the input arguments" << ENDM;
+      continue;
+    }
+    // we check if we have to skip any subdirectories wrt where we are
+    std::vector<std::string> excludedSubdirectories;
+    for (const auto& excludedDirectory : excludedDirectories) {
+      auto match = std::string(key->GetName()) + '/';
+      if (excludedDirectory.find(match) == 0) {
+        if (excludedDirectory.size() < match.size()) {
+          ILOG(Warning, Support) << "Invalid exclusion path '" << excludedDirectory << "'" << ENDM;
+          continue;
+        }
+        excludedSubdirectories.push_back(excludedDirectory.substr(match.size()));
+      }
+    }
+
+    ILOG(Debug, Devel) << "Getting the value for key '" << key->GetName() << "'" << ENDM;
+    auto* value = fileNode->Get(key->GetName());
+    if (value == nullptr) {
+      ILOG(Error) << "Could not get the value '" << key->GetName() << "', skipping." << ENDM;
+      continue;
+    }
+    if (auto inputMOC = dynamic_cast<MonitorObjectCollection*>(value)) {
+      inputMOC->postDeserialization();
+      if (memoryNode.children.count(inputMOC->GetName())) {
+        try {
+          std::get<MonitorObjectCollection*>(memoryNode.children[inputMOC->GetName()])->merge(inputMOC);
+        } catch (...) {
+          handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
+        }
+        delete inputMOC;
+      } else {
+        memoryNode.children[inputMOC->GetName()] = inputMOC;
+      }
+    } else if (auto dir = dynamic_cast<TDirectory*>(value)) {
+      auto name = dir->GetName();
+      if (memoryNode.children.count(name) == 0) {
+        memoryNode.children[name] = Node{ memoryNode.getFullPath(), name };
+      }
+      mergeRecursively(dir, std::get<Node>(memoryNode.children[name]), excludedSubdirectories, "", handleError);
+    } else {
+      handleError("Could not cast the node to MonitorObjectCollection nor TDirectory.");
+      delete value;
+      continue;
+    }
+  }
+}
+
+// Merges the other tree into the target tree. The other tree is emptied.
+void mergeTrees(Node& target, Node& other, const ErrorHandler& handleError)
+{
+  for (auto& [name, otherValue] : other.children) {
+    auto targetValue = target.children.find(name);
+    if (targetValue == target.children.end()) {
+      target.children.emplace(name, std::move(otherValue));
+      continue;
+    }
+    if (std::holds_alternative<Node>(targetValue->second) && std::holds_alternative<Node>(otherValue)) {
+      mergeTrees(std::get<Node>(targetValue->second), std::get<Node>(otherValue), handleError);
+    } else if (std::holds_alternative<MonitorObjectCollection*>(targetValue->second) && std::holds_alternative<MonitorObjectCollection*>(otherValue)) {
+      auto* otherMOC = std::get<MonitorObjectCollection*>(otherValue);
+      try {
+        std::get<MonitorObjectCollection*>(targetValue->second)->merge(otherMOC);
+      } catch (...) {
+        handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
+      }
+      delete otherMOC;
+    } else {
+      handleError("Could not merge '" + name + "', it is a directory in one file and an object in another.");
+      std::visit(overloaded{
+                   [](Node& node) { deleteRecursively(node); },
+                   [](MonitorObjectCollection* moc) { delete moc; } },
+                 otherValue);
+    }
+  }
+  other.children.clear();
+}
+
+TFile* openInputFile(const std::string& inputFilePath, const ErrorHandler& handleError)
+{
+  auto* file = TFile::Open(inputFilePath.c_str(), "READ");
+  if (file == nullptr) {
+    handleError("File handler for '" + inputFilePath + "' is nullptr.");
+    return nullptr;
+  }
+  if (file->IsZombie()) {
+    handleError("File '" + inputFilePath + "' is zombie.");
+    delete file;
+    return nullptr;
+  }
+  if (!file->IsOpen()) {
+    handleError("Failed to open the file: " + inputFilePath);
+    delete file;
+    return nullptr;
+  }
+  ILOG(Debug) << "Input file '" << inputFilePath << "' successfully open." << ENDM;
+  return file;
+}
+
+// Merges the input files with a number of workers, each of them merging its share of files into its own tree.
+// The trees are then merged in pairs, in parallel, until only one remains.
+Node mergeFiles(const std::vector<std::string>& inputFilePaths, ThreadPool& pool, const std::vector<std::string>& excludedDirectories,
+                const std::string& onlyKey, const ErrorHandler& handleError, MergeStatistics& statistics)
+{
+  std::atomic<size_t> nextFile = 0;
+  std::vector<Node> trees(std::min(pool.size(), inputFilePaths.size()));
+  std::vector<std::future<void>> results;
+  for (auto& tree : trees) {
+    results.push_back(pool.submit([&, tree = &tree]() {
+      for (size_t i = nextFile++; i < inputFilePaths.size(); i = nextFile++) {
+        auto* file = openInputFile(inputFilePaths[i], handleError);
+        if (file == nullptr) {
+          continue;
+        }
+        mergeRecursively(file, *tree, excludedDirectories, onlyKey, handleError);
+        statistics.bytesRead += file->GetBytesRead();
+        file->Close();
+        delete file;
+        statistics.filesRead++;
+      }
+    }));
+  }
+
+  auto waitForAll = [&results]() {
+    for (auto& result : results) {
+      result.wait();
+    }
+    for (auto& result : results) {
+      result.get();
+    }
+    results.clear();
+  };
+
+  waitForAll();
+  for (size_t stride = 1; stride < trees.size(); stride *= 2) {
+    for (size_t i = 0; i + stride < trees.size(); i += 2 * stride) {
+      results.push_back(pool.submit([&, i, stride]() { mergeTrees(trees[i], trees[i + stride], handleError); }));
+    }
+    waitForAll();
+  }
+
+  return trees.empty() ? Node{} : std::move(trees[0]);
+}
+
+// Merges the objects which are already in the output file into the tree, so they are not overwritten.
+void mergeWithOutput(TDirectory* outputDirectory, Node& memoryNode, const ErrorHandler& handleError)
+{
+  if (outputDirectory == nullptr) {
+    return;
+  }
+  for (auto& [name, value] : memoryNode.children) {
+    if (std::holds_alternative<Node>(value)) {
+      mergeWithOutput(outputDirectory->GetDirectory(name.c_str()), std::get<Node>(value), handleError);
+      continue;
+    }
+    auto mergedTObj = outputDirectory->Get(name.c_str());
+    if (mergedTObj == nullptr) {
+      continue;
+    }
+    auto mergedMOC = dynamic_cast<MonitorObjectCollection*>(mergedTObj);
+    if (mergedMOC == nullptr) {
+      handleError("Could not cast the merged object to MonitorObjectCollection, skipping.");
+      delete mergedTObj;
+      continue;
+    }
+    mergedMOC->postDeserialization();
+    ILOG(Info) << "Read merged object '" << mergedMOC->GetName() << "'" << ENDM;
+    auto* newMOC = std::get<MonitorObjectCollection*>(value);
+    try {
+      mergedMOC->merge(newMOC);
+    } catch (...) {
+      handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
+    }
+    delete newMOC;
+    value = mergedMOC;
+  }
+}
+
+// Stores the tree in the output file and deletes the objects.
+void storeRecursively(TDirectory* fout, Node& memoryNode, const ErrorHandler& handleError)
+{
+  for (auto& [name, value] : memoryNode.children) {
+    std::visit(overloaded{
+                 [&](Node& node) {
+                   auto* dir = fout->GetDirectory(node.name.c_str());
+                   if (dir == nullptr) {
+                     fout->mkdir(node.name.c_str());
+                   }
+                   dir = fout->GetDirectory(node.name.c_str());
+                   if (dir == nullptr) {
+                     handleError("Could not create directory '" + node.name + "' in path '" + node.pathTo + "'");
+                     deleteRecursively(node);
+                   } else {
+                     storeRecursively(dir, node, handleError);
+                   }
+                 },
+                 [&](MonitorObjectCollection* moc) {
+                   fout->WriteObject(moc, moc->GetName(), "Overwrite");
+                   delete moc;
+                 } },
+               value);
+  }
+  memoryNode.children.clear();
+}
+
+// Lists the top-level keys of all the input files
+std::set<std::string> listTopLevelKeys(const std::vector<std::string>& inputFilePaths, ThreadPool& pool, const std::vector<std::string>& excludedDirectories, const ErrorHandler& handleError)
+{
+  std::mutex keysMutex;
+  std::set<std::string> keys;
+  std::vector<std::future<void>> results;
+  for (const auto& inputFilePath : inputFilePaths) {
+    results.push_back(pool.submit([&]() {
+      auto* file = openInputFile(inputFilePath, handleError);
+      if (file == nullptr) {
+        return;
+      }
+      std::lock_guard lock(keysMutex);
+      for (auto* key : *file->GetListOfKeys()) {
+        if (std::find(excludedDirectories.begin(), excludedDirectories.end(), key->GetName()) == excludedDirectories.end()) {
+          keys.insert(key->GetName());
+        }
+      }
+      file->Close();
+      delete file;
+    }));
+  }
+  for (auto& result : results) {
+    result.wait();
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+  return keys;
+}
+
 int main(int argc, const char* argv[])
 {
-  size_t filesRead = 0;
+  size_t filesMerged = 0;
   try {
     bpo::options_description desc{ "Options" };
     desc.add_options()                                                                                                                                                         //
@@ -60,7 +337,9 @@ int main(int argc, const char* argv[])
       ("output-file", bpo::value<std::string>()->default_value("merged.root"), "File path to store the merged results, if the file exists, it will be merged with new files.") //
       ("input-files-list", bpo::value<std::string>()->default_value(""), "Path to a file containing a list of input files (row by row)")                                       //
       ("input-files", bpo::value<std::vector<std::string>>()->multitoken(), "Space-separated file paths which should be merged.")                                              //
-      ("exclude-directories", bpo::value<std::vector<std::string>>()->multitoken(), "Space-separated directories which should be excluded when merging files.");
+      ("exclude-directories", bpo::value<std::vector<std::string>>()->multitoken(), "Space-separated directories which should be excluded when merging files.")                //
+      ("workers", bpo::value<size_t>()->default_value(1), "Number of threads which read and merge the input files.")                                                           //
+      ("incremental-output", bpo::bool_switch()->default_value(false), "Merge and store one top-level directory at a time to bound memory usage, at the cost of reopening the input files.");
 
     bpo::variables_map vm;
     store(bpo::command_line_parser(argc, argv).options(desc).run(), vm);
@@ -113,7 +392,7 @@ int main(int argc, const char* argv[])
       ILOG(Info, Support) << ENDM;
     }
 
-    auto handleError = vm["exit-on-error"].as<bool>()
+    ErrorHandler handleError = vm["exit-on-error"].as<bool>()
                          ? [](const std::string& message) { throw std::runtime_error(message); }
                          : [](const std::string& message) { ILOG(Error, Support) << message << ENDM; };
 
@@ -134,133 +413,39 @@ int main(int argc, const char* argv[])
     // here we have more relaxed assumptions and try to recursively merge everything, regardless of the directory structure.
     // This is because we might have to change the structure again when we support moving windows, so we might save some work
     // in the future.
-    // We choose to keep the merged file structure in memory and merge everything we can before storing in a file.
-    // If this becomes too memory-hungry, it could be rewritten to store anything merge immediately at the cost of
-    // more I/O operations.
-    Node mergedTree;
-    for (const auto& inputFilePath : inputFilePaths) {
-      auto* file = TFile::Open(inputFilePath.c_str(), "READ");
-      if (file == nullptr) {
-        handleError("File handler for '" + inputFilePath + "' is nullptr.");
-        continue;
-      }
-      if (file->IsZombie()) {
-        handleError("File '" + inputFilePath + "' is zombie.");
-        continue;
-      }
-      if (!file->IsOpen()) {
-        handleError("Failed to open the file: " + inputFilePath);
-        continue;
-      }
-      ILOG(Debug) << "Input file '" << inputFilePath << "' successfully open." << ENDM;
+    // Each worker merges its share of input files into its own tree in memory, then the trees are merged together.
+    // By default, we merge everything before storing it in the output file. To limit the memory usage,
+    // one can request to process one top-level directory at a time, which requires to read each input file
+    // once per directory.
+    // the files are read in the threads of the pool, even if there is only one
+    ROOT::EnableThreadSafety();
+    TH1::AddDirectory(false);
+    ThreadPool pool(std::max<size_t>(1, vm["workers"].as<size_t>()));
+    MergeStatistics statistics;
+    AliceO2::Common::Timer timer;
 
-      std::function<void(TDirectory*, Node&, const std::vector<std::string>&)> mergeRecursively;
-      mergeRecursively = [&](TDirectory* fileNode, Node& memoryNode, const std::vector<std::string>& excludedDirectories = {}) {
-        if (fileNode == nullptr) {
-          ILOG(Error) << "Provided parentNode pointer is null, skipping." << ENDM;
-          return;
-        }
-        TIter next(fileNode->GetListOfKeys());
-        TKey* key;
-        while ((key = (TKey*)next())) {
-          // we look for exact matches here. we skip if there are no subdirectories
-          if (std::find(excludedDirectories.begin(), excludedDirectories.end(), key->GetName()) != excludedDirectories.end()) {
-            ILOG(Info, Support) << "Skipping '" << key->GetName() << "' as requested in the input arguments" << ENDM;
-            continue;
-          }
-          // we check if we have to skip any subdirectories wrt where we are
-          std::vector<std::string> excludedSubdirectories;
-          for (const auto& excludedDirectory : excludedDirectories) {
-            auto match = std::string(key->GetName()) + '/';
-            if (excludedDirectory.find(match) == 0) {
-              if (excludedDirectory.size() < match.size()) {
-                ILOG(Warning, Support) << "Invalid exclusion path '" << excludedDirectory << "'" << ENDM;
-                continue;
-              }
-              excludedSubdirectories.push_back(excludedDirectory.substr(match.size()));
-            }
-          }
-
-          ILOG(Debug, Devel) << "Getting the value for key '" << key->GetName() << "'" << ENDM;
-          auto* value = fileNode->Get(key->GetName());
-          if (value == nullptr) {
-            ILOG(Error) << "Could not get the value '" << key->GetName() << "', skipping." << ENDM;
-            continue;
-          }
-          if (auto inputMOC = dynamic_cast<MonitorObjectCollection*>(value)) {
-            inputMOC->postDeserialization();
-
-            if (memoryNode.children.count(inputMOC->GetName()) == 0) {
-              std::string mocPath = memoryNode.getFullPath() + std::filesystem::path::preferred_separator + key->GetName();
-
-              auto mergedTObj = outputFile->Get(mocPath.c_str());
-              if (mergedTObj != nullptr) {
-                auto mergedMOC = dynamic_cast<MonitorObjectCollection*>(mergedTObj);
-                if (mergedMOC == nullptr) {
-                  handleError("Could not cast the merged object to MonitorObjectCollection, skipping.");
-                  delete mergedMOC;
-                  continue;
-                }
-                mergedMOC->postDeserialization();
-                memoryNode.children[mergedMOC->GetName()] = mergedMOC;
-                ILOG(Info) << "Read merged object '" << mergedMOC->GetName() << "'" << ENDM;
-              }
-            }
-
-            if (memoryNode.children.count(inputMOC->GetName())) {
-              try {
-                std::get<MonitorObjectCollection*>(memoryNode.children[inputMOC->GetName()])->merge(inputMOC);
-              } catch (...) {
-                handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
-              }
-              delete inputMOC;
-            } else {
-              memoryNode.children[inputMOC->GetName()] = inputMOC;
-            }
-          } else if (auto dir = dynamic_cast<TDirectory*>(value)) {
-            auto name = dir->GetName();
-            if (memoryNode.children.count(name) == 0) {
-              memoryNode.children[name] = Node{ memoryNode.getFullPath(), name };
-            }
-            mergeRecursively(dir, std::get<Node>(memoryNode.children[name]), excludedSubdirectories);
-          } else {
-            handleError("Could not cast the node to MonitorObjectCollection nor TDirectory.");
-            delete value;
-            continue;
-          }
-        }
-      };
-
-      mergeRecursively(file, mergedTree, excludedDirectories);
-      file->Close();
-      delete file;
-      filesRead++;
+    std::vector<std::string> keysToMerge{ "" }; // empty means all
+    if (vm["incremental-output"].as<bool>()) {
+      auto keys = listTopLevelKeys(inputFilePaths, pool, excludedDirectories, handleError);
+      keysToMerge.assign(keys.begin(), keys.end());
+      ILOG(Info, Support) << "Will merge " << keysToMerge.size() << " top-level directories one by one" << ENDM;
     }
-
-    std::function<void(TDirectory*, const Node&)> storeRecursively;
-    storeRecursively = [&](TDirectory* fout, const Node& memoryNode) {
-      for (const auto& [name, value] : memoryNode.children) {
-        std::visit(overloaded{
-                     [&](const Node& node) {
-                       auto* dir = fout->GetDirectory(node.name.c_str());
-                       if (dir == nullptr) {
-                         fout->mkdir(node.name.c_str());
-                       }
-                       dir = fout->GetDirectory(node.name.c_str());
-                       if (dir == nullptr) {
-                         handleError("Could not create directory '" + node.name + "' in path '" + node.pathTo + "'");
-                       } else {
-                         storeRecursively(dir, node);
-                       }
-                     },
-                     [&](const MonitorObjectCollection* moc) {
-                       fout->WriteObject(moc, moc->GetName(), "Overwrite");
-                       delete moc;
-                     } },
-                   value);
+    for (const auto& key : keysToMerge) {
+      statistics.filesRead = 0;
+      Node mergedTree = mergeFiles(inputFilePaths, pool, excludedDirectories, key, handleError, statistics);
+      filesMerged = std::max(filesMerged, statistics.filesRead.load());
+      mergeWithOutput(outputFile, mergedTree, handleError);
+      storeRecursively(outputFile, mergedTree, handleError);
+      if (!key.empty()) {
+        ILOG(Info, Support) << "Merged and stored '" << key << "'" << ENDM;
       }
-    };
-    storeRecursively(outputFile, mergedTree);
+    }
+
+    double duration = timer.getTime();
+    double megabytesRead = statistics.bytesRead / 1e6;
+    ILOG(Info, Support) << "Read " << megabytesRead << " MB from " << filesMerged << " files in " << duration << " s: "
+                        << (duration > 0 ? filesMerged / duration : 0) << " files/s, "
+                        << (duration > 0 ? megabytesRead / duration : 0) << " MB/s" << ENDM;
     outputFile->Close();
 
   } catch (const bpo::error& ex) {
@@ -271,8 +456,8 @@ int main(int argc, const char* argv[])
     return 1;
   }
 
-  if (filesRead > 0) {
-    ILOG(Info, Support) << "Successfully merged " << filesRead << " files into one." << ENDM;
+  if (filesMerged > 0) {
+    ILOG(Info, Support) << "Successfully merged " << filesMerged << " files into one." << ENDM;
   } else {
     ILOG(Info, Support) << "No files were merged." << ENDM;
   }
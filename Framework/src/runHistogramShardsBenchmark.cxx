@@ -0,0 +1,185 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    runHistogramShardsBenchmark.cxx
+///
+/// \brief Compares filling histograms serially, from threads sharing a lock and from threads using HistogramShards.
+///
+
+#include "QualityControl/HistogramShards.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Timer.h>
+#include <TH1D.h>
+#include <TH2D.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
+
+struct Histograms {
+  std::vector<std::unique_ptr<TH1>> histograms;
+
+  Histograms(size_t numberOfHistograms, int bins)
+  {
+    for (size_t i = 0; i < numberOfHistograms; i++) {
+      auto name = "histogram_" + std::to_string(i);
+      TH1* histogram = i % 2 ? static_cast<TH1*>(new TH2D(name.c_str(), name.c_str(), bins, 0, 1, bins, 0, 1))
+                             : static_cast<TH1*>(new TH1D(name.c_str(), name.c_str(), bins, 0, 1));
+      histogram->SetDirectory(nullptr);
+      histograms.emplace_back(histogram);
+    }
+  }
+
+  double entries() const
+  {
+    double sum = 0;
+    for (const auto& histogram : histograms) {
+      sum += histogram->GetEntries();
+    }
+    return sum;
+  }
+};
+
+// Each input value is filled in one of the histograms, similarly to a task looping over hits or clusters.
+void fill(TH1* histogram, double x, double y)
+{
+  if (histogram->GetDimension() == 1) {
+    histogram->Fill(x);
+  } else {
+    histogram->Fill(x, y);
+  }
+}
+
+template <typename FillFcn>
+double runThreads(size_t threads, size_t fills, FillFcn fillFcn)
+{
+  AliceO2::Common::Timer timer;
+  timer.reset();
+  std::vector<std::thread> workers;
+  const size_t chunk = (fills + threads - 1) / threads;
+  for (size_t t = 0; t < threads; t++) {
+    workers.emplace_back([&, t]() {
+      const auto end = std::min(fills, (t + 1) * chunk);
+      for (size_t i = t * chunk; i < end; i++) {
+        fillFcn(t, i);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return timer.getTime();
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                                                                //
+    ("help,h", "Help screen")                                                                                                                       //
+    ("threads", bpo::value<std::vector<size_t>>()->multitoken()->default_value({ 1, 2, 4, 8, 16, 32 }, "1 2 4 8 16 32"), "Numbers of threads") //
+    ("fills", bpo::value<size_t>()->default_value(10'000'000), "Number of fills in total")                                                          //
+    ("histograms", bpo::value<size_t>()->default_value(20), "Number of filled histograms")                                                          //
+    ("bins", bpo::value<int>()->default_value(100), "Number of bins on each axis")                                                                  //
+    ("repetitions", bpo::value<size_t>()->default_value(3), "Number of measurements for each configuration");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+
+  const auto fills = vm["fills"].as<size_t>();
+  const auto numberOfHistograms = std::max<size_t>(1, vm["histograms"].as<size_t>());
+  const auto bins = vm["bins"].as<int>();
+  const auto repetitions = std::max<size_t>(1, vm["repetitions"].as<size_t>());
+  ILOG_INST.filterDiscardDebug(true);
+
+  std::vector<double> values(2 * fills);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(0, 1);
+  std::generate(values.begin(), values.end(), [&]() { return distribution(generator); });
+  auto histogramIndex = [numberOfHistograms](size_t i) { return (i * 7919) % numberOfHistograms; };
+
+  // the reference, as a task would do it without threads
+  double serialDuration = 0;
+  for (size_t r = 0; r < repetitions; r++) {
+    Histograms reference(numberOfHistograms, bins);
+    AliceO2::Common::Timer timer;
+    timer.reset();
+    for (size_t i = 0; i < fills; i++) {
+      fill(reference.histograms[histogramIndex(i)].get(), values[2 * i], values[2 * i + 1]);
+    }
+    serialDuration += timer.getTime();
+  }
+  serialDuration /= repetitions;
+  std::cout << "Serial fill of " << fills << " values in " << numberOfHistograms << " histograms: " << serialDuration * 1e3 << " ms" << std::endl;
+
+  std::cout << std::setw(10) << "threads"
+            << std::setw(16) << "locked [ms]"
+            << std::setw(16) << "sharded [ms]"
+            << std::setw(16) << "merge [ms]"
+            << std::setw(20) << "speedup vs serial" << std::endl;
+
+  for (auto threads : vm["threads"].as<std::vector<size_t>>()) {
+    threads = std::max<size_t>(1, threads);
+    double lockedDuration = 0;
+    double shardedDuration = 0;
+    double mergeDuration = 0;
+
+    for (size_t r = 0; r < repetitions; r++) {
+      // one lock around the shared histograms, what a task would need to do to stay correct without shards
+      Histograms locked(numberOfHistograms, bins);
+      std::mutex mutex;
+      lockedDuration += runThreads(threads, fills, [&](size_t, size_t i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        fill(locked.histograms[histogramIndex(i)].get(), values[2 * i], values[2 * i + 1]);
+      });
+
+      Histograms sharded(numberOfHistograms, bins);
+      HistogramShards shards(threads);
+      for (const auto& histogram : sharded.histograms) {
+        shards.add(histogram.get());
+      }
+      shardedDuration += runThreads(threads, fills, [&](size_t shard, size_t i) {
+        fill(shards.get(sharded.histograms[histogramIndex(i)].get(), shard), values[2 * i], values[2 * i + 1]);
+      });
+      AliceO2::Common::Timer timer;
+      timer.reset();
+      shards.merge();
+      mergeDuration += timer.getTime();
+
+      if (sharded.entries() != fills || locked.entries() != fills) {
+        std::cerr << "The number of entries does not match the number of fills, the benchmark is not valid" << std::endl;
+        return 1;
+      }
+    }
+
+    std::cout << std::setw(10) << threads
+              << std::setw(16) << lockedDuration / repetitions * 1e3
+              << std::setw(16) << shardedDuration / repetitions * 1e3
+              << std::setw(16) << mergeDuration / repetitions * 1e3
+              << std::setw(20) << serialDuration / ((shardedDuration + mergeDuration) / repetitions) << std::endl;
+  }
+
+  return 0;
+}
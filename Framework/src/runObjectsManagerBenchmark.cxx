@@ -0,0 +1,130 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    runObjectsManagerBenchmark.cxx
+///
+/// \brief Measures the bookkeeping cost of ObjectsManager for many objects, e.g. plots registered in each update.
+///
+
+#include "QualityControl/ObjectsManager.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Timer.h>
+#include <TH1F.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
+
+void printResult(const std::string& operation, size_t operations, double duration)
+{
+  std::cout << std::setw(40) << std::left << operation
+            << std::setw(16) << std::right << duration * 1e3
+            << std::setw(16) << duration * 1e9 / std::max<size_t>(1, operations) << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                //
+    ("help,h", "Help screen")                                                                       //
+    ("objects", bpo::value<size_t>()->default_value(10'000), "Number of objects")                  //
+    ("cycles", bpo::value<size_t>()->default_value(10), "Number of cycles re-registering the objects");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+
+  const auto numberOfObjects = std::max<size_t>(1, vm["objects"].as<size_t>());
+  const auto cycles = std::max<size_t>(1, vm["cycles"].as<size_t>());
+  ILOG_INST.filterDiscardDebug(true);
+
+  std::vector<std::unique_ptr<TH1F>> histograms;
+  std::vector<std::string> names;
+  for (size_t i = 0; i < numberOfObjects; i++) {
+    names.push_back("histogram_" + std::to_string(i));
+    histograms.emplace_back(new TH1F(names.back().c_str(), names.back().c_str(), 10, 0, 1));
+    histograms.back()->SetDirectory(nullptr);
+  }
+
+  ObjectsManager objectsManager("benchmark", "Benchmark", "TST", "", 0, true);
+  AliceO2::Common::Timer timer;
+
+  std::cout << std::setw(40) << std::left << "operation"
+            << std::setw(16) << std::right << "total [ms]"
+            << std::setw(16) << "per object [ns]" << std::endl;
+
+  timer.reset();
+  for (auto& histogram : histograms) {
+    objectsManager.startPublishing(histogram.get(), PublicationPolicy::Forever);
+  }
+  printResult("startPublishing", numberOfObjects, timer.getTime());
+
+  timer.reset();
+  for (const auto& name : names) {
+    objectsManager.getMonitorObject(name);
+  }
+  printResult("getMonitorObject(name)", numberOfObjects, timer.getTime());
+
+  timer.reset();
+  for (auto& histogram : histograms) {
+    objectsManager.setDefaultDrawOptions(histogram.get(), "hist");
+  }
+  printResult("setDefaultDrawOptions(object)", numberOfObjects, timer.getTime());
+
+  timer.reset();
+  for (size_t i = 0; i < numberOfObjects; i++) {
+    objectsManager.addOrUpdateMetadata(names[i], "key", "value");
+  }
+  printResult("addOrUpdateMetadata(name)", numberOfObjects, timer.getTime());
+
+  timer.reset();
+  std::unique_ptr<MonitorObjectCollection> array(objectsManager.getNonOwningArray());
+  printResult("getNonOwningArray", numberOfObjects, timer.getTime());
+
+  timer.reset();
+  for (auto& histogram : histograms) {
+    objectsManager.stopPublishing(histogram.get());
+  }
+  printResult("stopPublishing(object)", numberOfObjects, timer.getTime());
+
+  // the pattern of post-processing tasks which publish new plots in each update
+  double cycleDuration = 0;
+  for (size_t cycle = 0; cycle < cycles; cycle++) {
+    timer.reset();
+    for (auto& histogram : histograms) {
+      objectsManager.startPublishing(histogram.get(), PublicationPolicy::Once);
+      objectsManager.setDefaultDrawOptions(histogram.get(), "hist");
+    }
+    array.reset(objectsManager.getNonOwningArray());
+    objectsManager.stopPublishing(PublicationPolicy::Once);
+    cycleDuration += timer.getTime();
+
+    if (array->GetEntries() != static_cast<int>(numberOfObjects) || objectsManager.getNumberPublishedObjects() != 0) {
+      std::cerr << "Unexpected number of published objects, the benchmark is not valid" << std::endl;
+      return 1;
+    }
+  }
+  printResult("cycle with PublicationPolicy::Once", numberOfObjects, cycleDuration / cycles);
+
+  return 0;
+}
@@ -0,0 +1,307 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    runPublicationBenchmark.cxx
+///
+/// \brief Measures the cost of filling the objects published by a QC task and of publishing them at the end of each cycle,
+/// as a function of the number of objects, their size and the cycle length.
+///
+/// The task is a TaskInterface driven through the same sequence of calls as in TaskRunner, while the objects to be
+/// published and the resets are decided by the TaskRunner functions used in production. Creating a ProcessingContext
+/// or a DataAllocator outside of DPL is not practical, thus the input messages are handed to the task directly
+/// instead of through monitorData() and the collection is serialized with a TMessage, as DataAllocator::snapshot() does.
+/// Consequently, the results do not include the cost of the message passing.
+///
+
+#include "QualityControl/TaskInterface.h"
+#include "QualityControl/TaskRunner.h"
+#include "QualityControl/TaskRunnerConfig.h"
+#include "QualityControl/ObjectsManager.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Timer.h>
+#include <Framework/ConfigParamRegistry.h>
+#include <Framework/ConfigParamStore.h>
+#include <Framework/InitContext.h>
+#include <Framework/InputRecord.h>
+#include <Framework/ProcessingContext.h>
+#include <Framework/ServiceRegistry.h>
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TMessage.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
+using namespace o2::framework;
+
+// One entry of a synthetic input message, similar to what a task decodes from a raw payload.
+struct Hit {
+  uint32_t histogram;
+  float x;
+  float y;
+};
+
+// A QC task which books the histograms in initialize() and fills them with the hits of each input message.
+class SyntheticTask final : public TaskInterface
+{
+ public:
+  SyntheticTask(size_t numberOfHistograms, int bins) : mNumberOfHistograms(numberOfHistograms), mBins(bins) {}
+  ~SyntheticTask() override = default;
+
+  void initialize(InitContext&) override
+  {
+    for (size_t i = 0; i < mNumberOfHistograms; i++) {
+      auto name = "histogram_" + std::to_string(i);
+      TH1* histogram = i % 2 ? static_cast<TH1*>(new TH2F(name.c_str(), name.c_str(), mBins, 0, 1, mBins, 0, 1))
+                             : static_cast<TH1*>(new TH1F(name.c_str(), name.c_str(), mBins, 0, 1));
+      histogram->SetDirectory(nullptr);
+      mHistograms.emplace_back(histogram);
+      getObjectsManager()->startPublishing(histogram);
+    }
+  }
+
+  void startOfActivity(const Activity&) override { reset(); }
+  void startOfCycle() override {}
+
+  void monitorData(ProcessingContext& ctx) override
+  {
+    auto payload = ctx.inputs().get<gsl::span<char>>("hits");
+    fill(payload.data(), payload.size());
+  }
+
+  // the part of monitorData() which does not depend on DPL, the payload is copied first as DPL hands over a new buffer for each message
+  void fill(const char* payload, size_t size)
+  {
+    mBuffer.resize(size);
+    std::memcpy(mBuffer.data(), payload, size);
+    const auto* hits = reinterpret_cast<const Hit*>(mBuffer.data());
+    const size_t nHits = mBuffer.size() / sizeof(Hit);
+    for (size_t i = 0; i < nHits; i++) {
+      auto* histogram = mHistograms[hits[i].histogram].get();
+      if (histogram->GetDimension() == 1) {
+        histogram->Fill(hits[i].x);
+      } else {
+        histogram->Fill(hits[i].x, hits[i].y);
+      }
+    }
+  }
+
+  void endOfCycle() override {}
+  void endOfActivity(const Activity&) override {}
+
+  void reset() override
+  {
+    for (auto& histogram : mHistograms) {
+      histogram->Reset();
+    }
+  }
+
+  double entries() const
+  {
+    double sum = 0;
+    for (const auto& histogram : mHistograms) {
+      sum += histogram->GetEntries();
+    }
+    return sum;
+  }
+
+ private:
+  size_t mNumberOfHistograms;
+  int mBins;
+  std::vector<std::unique_ptr<TH1>> mHistograms;
+  std::vector<char> mBuffer;
+};
+
+// TaskRunner::publish() without the DPL output: the objects are selected by TaskRunner and
+// the collection is streamed with a TMessage, which gives the cost and the size of a publication.
+size_t publish(ObjectsManager& objectsManager, const TaskRunnerConfig& config, int cycleNumber, size_t& objectsPublished)
+{
+  auto array = TaskRunner::getObjectsToPublish(objectsManager, config, cycleNumber);
+  objectsPublished = array->GetEntries();
+
+  TMessage message(kMESS_OBJECT);
+  message.WriteObjectAny(array.get(), array->IsA());
+  objectsManager.stopPublishing(PublicationPolicy::Once);
+  return message.Length();
+}
+
+double percentile(std::vector<double> values, double fraction)
+{
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  auto index = static_cast<size_t>(std::ceil(fraction * values.size()));
+  return values[std::clamp<size_t>(index, 1, values.size()) - 1];
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                                            //
+    ("help,h", "Help screen")                                                                                                   //
+    ("objects", bpo::value<size_t>()->default_value(100), "Number of published histograms, half of them 1D and half 2D")        //
+    ("bins", bpo::value<int>()->default_value(100), "Number of bins on each axis")                                              //
+    ("messages-per-cycle", bpo::value<size_t>()->default_value(1000), "Number of input messages in each cycle")                 //
+    ("hits-per-message", bpo::value<size_t>()->default_value(1000), "Number of values filled for each input message")           //
+    ("active-objects", bpo::value<size_t>()->default_value(0), "Number of histograms which are filled, 0 means all of them")    //
+    ("cycles", bpo::value<size_t>()->default_value(20), "Number of cycles")                                                     //
+    ("reset-after-cycles", bpo::value<size_t>()->default_value(0), "Reset the histograms every N cycles, 0 means never")        //
+    ("updated-only", bpo::bool_switch()->default_value(false), "Publish only the updated objects (publishUpdatedObjectsOnly)")  //
+    ("full-publication-cycles", bpo::value<int>()->default_value(0), "With --updated-only, publish all objects every N cycles") //
+    ("csv", bpo::bool_switch()->default_value(false), "Print the results as one CSV line, for regression tracking");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+
+  const auto numberOfObjects = std::max<size_t>(1, vm["objects"].as<size_t>());
+  const auto bins = vm["bins"].as<int>();
+  const auto messagesPerCycle = std::max<size_t>(1, vm["messages-per-cycle"].as<size_t>());
+  const auto hitsPerMessage = vm["hits-per-message"].as<size_t>();
+  const auto activeObjects = vm["active-objects"].as<size_t>() == 0 ? numberOfObjects : std::min(numberOfObjects, vm["active-objects"].as<size_t>());
+  const auto cycles = std::max<size_t>(1, vm["cycles"].as<size_t>());
+  const auto updatedOnly = vm["updated-only"].as<bool>();
+  const auto csv = vm["csv"].as<bool>();
+  ILOG_INST.filterDiscardDebug(true);
+
+  // a pool of distinct messages, so we do not measure always the same cache-resident buffer
+  const size_t poolSize = std::min<size_t>(messagesPerCycle, 64);
+  std::vector<std::vector<char>> messages(poolSize);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> distribution(0, 1);
+  std::uniform_int_distribution<uint32_t> histogramDistribution(0, activeObjects - 1);
+  for (auto& message : messages) {
+    std::vector<Hit> hits(hitsPerMessage);
+    for (auto& hit : hits) {
+      hit = { histogramDistribution(generator), distribution(generator), distribution(generator) };
+    }
+    message.resize(hits.size() * sizeof(Hit));
+    std::memcpy(message.data(), hits.data(), message.size());
+  }
+
+  TaskRunnerConfig config;
+  config.taskName = "benchmark";
+  config.className = "SyntheticTask";
+  config.detectorName = "TST";
+  config.resetAfterCycles = static_cast<int>(vm["reset-after-cycles"].as<size_t>());
+  config.publishUpdatedObjectsOnly = updatedOnly;
+  config.fullPublicationCycles = vm["full-publication-cycles"].as<int>();
+
+  auto objectsManager = std::make_shared<ObjectsManager>(config.taskName, config.className, config.detectorName, "", 0, true);
+  SyntheticTask task(numberOfObjects, bins);
+  task.setObjectsManager(objectsManager);
+  {
+    std::vector<ConfigParamSpec> specs;
+    std::vector<std::unique_ptr<ParamRetriever>> retrievers;
+    auto store = std::make_unique<ConfigParamStore>(specs, std::move(retrievers));
+    store->preload();
+    store->activate();
+    ConfigParamRegistry options(std::move(store));
+    ServiceRegistry services;
+    InitContext initContext(options, services);
+    task.initialize(initContext);
+  }
+  Activity activity;
+  objectsManager->setActivity(activity);
+  task.startOfActivity(activity);
+
+  std::vector<double> publicationDurations;
+  std::vector<double> publishedBytes;
+  double monitorDataDuration = 0;
+  double totalPublishedObjects = 0;
+  size_t filledSinceReset = 0;
+
+  AliceO2::Common::Timer totalTimer;
+  totalTimer.reset();
+  // the same sequence of calls as in TaskRunner::run(), startCycle() and finishCycle()
+  for (int cycle = 0; cycle < static_cast<int>(cycles); cycle++) {
+    task.startOfCycle();
+    AliceO2::Common::Timer timer;
+    timer.reset();
+    for (size_t m = 0; m < messagesPerCycle; m++) {
+      const auto& message = messages[m % poolSize];
+      task.fill(message.data(), message.size());
+    }
+    monitorDataDuration += timer.getTime();
+    filledSinceReset += messagesPerCycle * hitsPerMessage;
+
+    timer.reset();
+    task.endOfCycle();
+    size_t objectsPublished = 0;
+    publishedBytes.push_back(publish(*objectsManager, config, cycle, objectsPublished));
+    publicationDurations.push_back(timer.getTime());
+    totalPublishedObjects += objectsPublished;
+
+    if (task.entries() != filledSinceReset) {
+      std::cerr << "The number of entries does not match the number of fills, the benchmark is not valid" << std::endl;
+      return 1;
+    }
+    if (TaskRunner::isResetNeeded(config, cycle + 1)) {
+      task.reset();
+      filledSinceReset = 0;
+    }
+  }
+  task.endOfActivity(activity);
+  const double totalDuration = totalTimer.getTime();
+
+  const double messages = static_cast<double>(cycles * messagesPerCycle);
+  double meanBytes = 0;
+  for (auto bytes : publishedBytes) {
+    meanBytes += bytes;
+  }
+  meanBytes /= publishedBytes.size();
+
+  if (csv) {
+    std::cout << "objects,bins,messages_per_cycle,hits_per_message,cycles,updated_only,"
+                 "messages_per_s,monitor_data_messages_per_s,publication_p50_ms,publication_p90_ms,publication_p99_ms,"
+                 "published_objects_per_cycle,published_bytes_per_cycle"
+              << std::endl;
+    std::cout << numberOfObjects << "," << bins << "," << messagesPerCycle << "," << hitsPerMessage << "," << cycles << "," << updatedOnly << ","
+              << messages / totalDuration << "," << messages / monitorDataDuration << ","
+              << percentile(publicationDurations, 0.5) * 1e3 << "," << percentile(publicationDurations, 0.9) * 1e3 << ","
+              << percentile(publicationDurations, 0.99) * 1e3 << ","
+              << totalPublishedObjects / cycles << "," << meanBytes << std::endl;
+    return 0;
+  }
+
+  std::cout << "Objects: " << numberOfObjects << " (" << activeObjects << " filled), bins: " << bins
+            << ", messages per cycle: " << messagesPerCycle << ", hits per message: " << hitsPerMessage
+            << ", cycles: " << cycles << (updatedOnly ? ", publishing updated objects only" : "") << std::endl;
+  std::cout << std::setw(36) << std::left << "messages/s (whole loop)" << messages / totalDuration << std::endl;
+  std::cout << std::setw(36) << std::left << "messages/s (monitorData only)" << messages / monitorDataDuration << std::endl;
+  std::cout << std::setw(36) << std::left << "publication p50/p90/p99/max [ms]"
+            << percentile(publicationDurations, 0.5) * 1e3 << " / "
+            << percentile(publicationDurations, 0.9) * 1e3 << " / "
+            << percentile(publicationDurations, 0.99) * 1e3 << " / "
+            << percentile(publicationDurations, 1.0) * 1e3 << std::endl;
+  std::cout << std::setw(36) << std::left << "published objects per cycle" << totalPublishedObjects / cycles << std::endl;
+  std::cout << std::setw(36) << std::left << "serialized bytes per cycle" << meanBytes << std::endl;
+  std::cout << std::setw(36) << std::left << "share of time spent publishing" << 1.0 - monitorDataDuration / totalDuration << std::endl;
+
+  return 0;
+}
@@ -18,27 +18,248 @@
 /// This is an executable which reads QAResults.root generated by DPL analysis tasks and puts them to QCDB.
 /// It will ignore the directory structure and put all objects in under the task name specified as the argument.
 /// By default the current date and time will be used as the start of validity, and the object will be valid for 10 years.
+///
+/// The file is read in the main thread, while the objects are uploaded by a number of workers, each with its own
+/// connection to the QCDB. The total size of the objects which were read but not uploaded yet is bounded.
+/// Failed uploads are retried with an exponential backoff. If a journal file is given, the paths of uploaded objects
+/// are appended to it and the objects listed there are skipped, so an interrupted upload can be resumed.
 
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/CcdbDatabase.h"
 #include "QualityControl/MonitorObject.h"
 #include "QualityControl/RepoPathUtils.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
 #include <functional>
 #include <filesystem>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <boost/program_options.hpp>
 #include <boost/exception/diagnostic_information.hpp>
+#include <Common/Timer.h>
+#include <TClass.h>
 #include <TFile.h>
+#include <TH1.h>
 #include <TKey.h>
+#include <TROOT.h>
 
 namespace bpo = boost::program_options;
 using namespace o2::quality_control::core;
 using namespace o2::quality_control::repository;
 
+struct UploadItem {
+  std::string pathInFile;
+  std::shared_ptr<MonitorObject> mo;
+  uint64_t bytes = 0;
+};
+
+struct UploadStatistics {
+  std::atomic<size_t> objectsUploaded = 0;
+  std::atomic<size_t> objectsFailed = 0;
+  std::atomic<uint64_t> bytesUploaded = 0;
+  size_t objectsSkipped = 0;
+};
+
+// Passes the objects from the reader to the upload workers.
+// The reader is blocked as long as adding an object would exceed the maximum of bytes in flight,
+// i.e. read and not uploaded yet. An object bigger than the maximum is let through when nothing else is in flight.
+class UploadQueue
+{
+ public:
+  explicit UploadQueue(uint64_t maxBytesInFlight) : mMaxBytesInFlight(maxBytesInFlight) {}
+
+  void push(UploadItem item)
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mSpaceAvailable.wait(lock, [&] { return mBytesInFlight == 0 || mBytesInFlight + item.bytes <= mMaxBytesInFlight; });
+    mBytesInFlight += item.bytes;
+    mItems.push_back(std::move(item));
+    mItemAvailable.notify_one();
+  }
+
+  // Returns nothing once the queue is closed and empty.
+  std::optional<UploadItem> pop()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mItemAvailable.wait(lock, [&] { return !mItems.empty() || mClosed; });
+    if (mItems.empty()) {
+      return std::nullopt;
+    }
+    auto item = std::move(mItems.front());
+    mItems.pop_front();
+    return item;
+  }
+
+  // Should be called once the object popped before is not needed anymore.
+  void release(uint64_t bytes)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mBytesInFlight -= bytes;
+    }
+    mSpaceAvailable.notify_one();
+  }
+
+  void close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mClosed = true;
+    }
+    mItemAvailable.notify_all();
+  }
+
+ private:
+  const uint64_t mMaxBytesInFlight;
+  uint64_t mBytesInFlight = 0;
+  bool mClosed = false;
+  std::deque<UploadItem> mItems;
+  std::mutex mMutex;
+  std::condition_variable mItemAvailable;
+  std::condition_variable mSpaceAvailable;
+};
+
+// Keeps the paths (in the input file) of the objects which were uploaded, one per line.
+class ProgressJournal
+{
+ public:
+  // A read-only journal is only used to skip the objects, the newly uploaded ones are not added.
+  ProgressJournal(const std::string& journalPath, bool readOnly)
+  {
+    if (journalPath.empty()) {
+      return;
+    }
+    std::ifstream input(journalPath);
+    std::string line;
+    while (std::getline(input, line)) {
+      if (!line.empty()) {
+        mDone.insert(line);
+      }
+    }
+    if (readOnly) {
+      return;
+    }
+    mOutput.open(journalPath, std::ios::app);
+    if (!mOutput.is_open()) {
+      throw std::runtime_error("Failed to open the journal file: " + journalPath);
+    }
+  }
+
+  size_t size() const { return mDone.size(); }
+
+  bool isDone(const std::string& pathInFile) const { return mDone.count(pathInFile) > 0; }
+
+  void markDone(const std::string& pathInFile)
+  {
+    if (!mOutput.is_open()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    // flushed each time, so that the journal is complete if the upload is interrupted
+    mOutput << pathInFile << std::endl;
+  }
+
+ private:
+  std::unordered_set<std::string> mDone; // read once before the upload, not modified afterwards
+  std::ofstream mOutput;
+  std::mutex mMutex;
+};
+
+// Calls the visitor for each object of the directory and its subdirectories which is not in the journal yet.
+// The visitor gets the path of the object in the file and its key, so it decides if the object should be read.
+void browseFile(TDirectory* directory, const std::string& path, const ProgressJournal& journal, size_t& objectsSkipped,
+                const std::function<void(const std::string&, TKey*)>& visit)
+{
+  TIter next(directory->GetListOfKeys());
+  TKey* key;
+  while ((key = (TKey*)next())) {
+    auto keyClass = TClass::GetClass(key->GetClassName());
+    if (keyClass != nullptr && keyClass->InheritsFrom(TDirectory::Class())) {
+      auto subdirectory = directory->GetDirectory(key->GetName());
+      if (subdirectory != nullptr) {
+        browseFile(subdirectory, path + std::string(key->GetName()) + std::filesystem::path::preferred_separator, journal, objectsSkipped, visit);
+      }
+      continue;
+    }
+    if (directory->GetKey(key->GetName()) != key) {
+      continue; // only the highest cycle of an object is uploaded
+    }
+    auto pathInFile = path + key->GetName();
+    if (journal.isDone(pathInFile)) {
+      objectsSkipped++;
+      continue;
+    }
+    visit(pathInFile, key);
+  }
+}
+
+// Stores the object, retrying with an exponentially increasing delay if the QCDB could not be reached.
+// Returns false if the object could not be stored, including when it was refused without retrying, e.g. for its size.
+bool uploadWithRetries(CcdbDatabase& database, const UploadItem& item, size_t retries, std::chrono::milliseconds backoff)
+{
+  for (size_t attempt = 0; attempt <= retries; attempt++) {
+    if (attempt > 0) {
+      auto delay = backoff * (1ull << std::min<size_t>(attempt - 1, 16));
+      ILOG(Warning, Support) << "Failed to upload '" << item.pathInFile << "', retrying in " << delay.count() << " ms (attempt "
+                             << attempt + 1 << "/" << retries + 1 << ")" << ENDM;
+      std::this_thread::sleep_for(delay);
+    }
+    try {
+      database.storeMO(item.mo);
+    } catch (const boost::exception&) {
+      // invalid object or task names, retrying would not help
+      ILOG(Error, Support) << "Object '" << item.pathInFile << "' cannot be uploaded: " << boost::current_exception_diagnostic_information(true) << ENDM;
+      return false;
+    } catch (const std::exception& e) {
+      // e.g. a failed serialization or allocation, it should not stop the other workers
+      ILOG(Error, Support) << "Object '" << item.pathInFile << "' cannot be uploaded: " << e.what() << ENDM;
+      return false;
+    }
+    const auto result = database.getLastStoreResult();
+    if (result == 0) {
+      return true;
+    }
+    if (result == CcdbDatabase::storeObjectTooBig) {
+      ILOG(Error, Support) << "Object '" << item.pathInFile << "' is bigger than the maximum object size, it is not uploaded. "
+                           << "Use --max-object-size to allow it." << ENDM;
+      return false;
+    }
+    if (result == CcdbDatabase::storeInvalidValidity) {
+      return false; // already reported by the database
+    }
+  }
+  ILOG(Error, Support) << "Giving up on uploading '" << item.pathInFile << "' after " << retries + 1 << " attempts" << ENDM;
+  return false;
+}
+
+void runUploadWorker(CcdbDatabase& database, UploadQueue& queue, ProgressJournal& journal, UploadStatistics& statistics,
+                     size_t retries, std::chrono::milliseconds backoff)
+{
+  while (auto item = queue.pop()) {
+    if (uploadWithRetries(database, *item, retries, backoff)) {
+      journal.markDone(item->pathInFile);
+      statistics.objectsUploaded++;
+      statistics.bytesUploaded += item->bytes;
+    } else {
+      statistics.objectsFailed++;
+    }
+    const auto bytes = item->bytes;
+    item.reset(); // the object is deleted before more are read
+    queue.release(bytes);
+  }
+}
+
 int main(int argc, const char* argv[])
 {
-  size_t objectsUploaded = 0;
+  UploadStatistics statistics;
 
   try {
     bpo::options_description desc{ "Options" };
@@ -54,7 +275,14 @@ int main(int argc, const char* argv[])
       ("period-name", bpo::value<std::string>()->default_value("unknown"), "Period name of the objects")                                                               // todo one could ask logbook
       ("pass-name", bpo::value<std::string>()->default_value("unknown"), "Calib/reco/sim pass name")                                                                   //
       ("provenance", bpo::value<std::string>()->default_value("qc"), "Object path prefix used to mark if data comes from detector (use qc) or simulation (use qc_mc)") //
-      ("preserve-directories", bpo::bool_switch()->default_value(false), "If present, the directory structure of the input file will be preserved in QCDB");
+      ("preserve-directories", bpo::bool_switch()->default_value(false), "If present, the directory structure of the input file will be preserved in QCDB")            //
+      ("workers", bpo::value<size_t>()->default_value(4), "Number of threads which upload the objects, each with its own connection to the QCDB.")                     //
+      ("max-in-flight-mb", bpo::value<uint64_t>()->default_value(256), "Maximum size of the objects which were read but not uploaded yet, in MB.")                     //
+      ("retries", bpo::value<size_t>()->default_value(3), "Number of times a failed upload is retried.")                                                               //
+      ("retry-backoff-ms", bpo::value<uint64_t>()->default_value(1000), "Delay before the first retry of a failed upload, doubled with each subsequent retry.")        //
+      ("journal", bpo::value<std::string>()->default_value(""), "File to which the paths of uploaded objects are appended. Objects already listed there are skipped.") //
+      ("max-object-size", bpo::value<uint64_t>()->default_value(0), "Maximum size of a stored object in bytes, 0 for the default of the QCDB interface (2MB).")        //
+      ("dry-run", bpo::bool_switch()->default_value(false), "If present, the objects are only counted, nothing is uploaded.");
 
     bpo::variables_map vm;
     store(parse_command_line(argc, argv, desc), vm);
@@ -78,6 +306,13 @@ int main(int argc, const char* argv[])
     auto passName = vm["pass-name"].as<std::string>();
     auto provenance = vm["provenance"].as<std::string>();
     auto preserveDirectories = vm["preserve-directories"].as<bool>();
+    auto workers = std::max<size_t>(1, vm["workers"].as<size_t>());
+    auto maxBytesInFlight = vm["max-in-flight-mb"].as<uint64_t>() * 1000000;
+    auto retries = vm["retries"].as<size_t>();
+    auto backoff = std::chrono::milliseconds(vm["retry-backoff-ms"].as<uint64_t>());
+    auto journalPath = vm["journal"].as<std::string>();
+    auto maxObjectSize = vm["max-object-size"].as<uint64_t>();
+    auto dryRun = vm["dry-run"].as<bool>();
 
     if (validityStart == 0) {
       validityStart = CcdbDatabase::getCurrentTimestamp();
@@ -92,6 +327,10 @@ int main(int argc, const char* argv[])
       throw std::runtime_error(std::string(RepoPathUtils::allowedProvenancesMessage) + " '" + provenance + "' was given.");
     }
 
+    // the objects are streamed by the workers while the file is read, they should not be attached to it
+    ROOT::EnableThreadSafety();
+    TH1::AddDirectory(false);
+
     /// Open ROOT file
     auto* file = new TFile(inputFilePath.c_str(), "READ");
     if (file->IsZombie()) {
@@ -102,45 +341,86 @@ int main(int argc, const char* argv[])
     }
     ILOG(Info) << "Input file '" << inputFilePath << "' successfully open." << ENDM;
 
-    /// Open CCDB interface
-    CcdbDatabase database;
-    database.connect(qcdbUrl, "", "", "");
+    ProgressJournal journal(journalPath, dryRun);
+    if (journal.size() > 0) {
+      ILOG(Info, Support) << "Journal '" << journalPath << "' lists " << journal.size() << " objects which were already uploaded, they will be skipped." << ENDM;
+    }
+
+    if (dryRun) {
+      size_t objects = 0;
+      uint64_t bytes = 0;
+      browseFile(file, "", journal, statistics.objectsSkipped, [&](const std::string&, TKey* key) {
+        objects++;
+        bytes += key->GetObjlen();
+      });
+      file->Close();
+      delete file;
+      ILOG(Info, Support) << "Dry run: " << objects << " objects, " << bytes << " bytes (" << bytes / 1e6 << " MB uncompressed) would be uploaded to the QCDB, "
+                          << statistics.objectsSkipped << " objects would be skipped." << ENDM;
+      return 0;
+    }
+
+    /// Open CCDB interfaces, one per worker. We retry ourselves, so the storage should not be suspended after a failure.
+    std::vector<std::unique_ptr<CcdbDatabase>> databases;
+    for (size_t i = 0; i < workers; i++) {
+      auto& database = databases.emplace_back(std::make_unique<CcdbDatabase>());
+      std::unordered_map<std::string, std::string> databaseConfig{ { "host", qcdbUrl } };
+      if (maxObjectSize > 0) {
+        databaseConfig["maxObjectSize"] = std::to_string(maxObjectSize);
+      }
+      database->connect(databaseConfig);
+      database->setFailureDelay(0);
+    }
 
     /// Upload the objects
-    std::function<void(TDirectoryFile*, std::string)> browseFileAndUpload = [&](TDirectoryFile* directory, const std::string& path) {
-      TIter next(directory->GetListOfKeys());
-      TKey* key;
-      while ((key = (TKey*)next())) {
-        auto storedTObj = directory->Get(key->GetName());
-        if (storedTObj != nullptr) {
-          if (storedTObj->InheritsFrom("TDirectoryFile")) {
-            browseFileAndUpload(dynamic_cast<TDirectoryFile*>(storedTObj), path + std::string(key->GetName()) + std::filesystem::path::preferred_separator);
-          } else {
-            std::shared_ptr<MonitorObject> mo = nullptr;
-            if (preserveDirectories) {
-              // one cannot change a name of a TObject, we have to create a new one...
-              auto clonedTObj = storedTObj->Clone((path + storedTObj->GetName()).c_str());
-              mo = std::make_shared<MonitorObject>(clonedTObj, taskName, "unknown", detectorCode, runNumber, periodName, passName, provenance);
-              mo->setIsOwner(true);
-            } else {
-              mo = std::make_shared<MonitorObject>(storedTObj, taskName, "unknown", detectorCode, runNumber, periodName, passName, provenance);
-              mo->setIsOwner(false);
-            }
-            mo->setValidity({ validityStart, validityEnd });
-            database.storeMO(mo);
-            objectsUploaded++;
-          }
+    UploadQueue queue(maxBytesInFlight);
+    AliceO2::Common::Timer timer;
+    std::vector<std::thread> threads;
+    for (auto& database : databases) {
+      threads.emplace_back(runUploadWorker, std::ref(*database), std::ref(queue), std::ref(journal), std::ref(statistics), retries, backoff);
+    }
+
+    try {
+      browseFile(file, "", journal, statistics.objectsSkipped, [&](const std::string& pathInFile, TKey* key) {
+        auto storedTObj = key->ReadObj();
+        if (storedTObj == nullptr) {
+          return;
+        }
+        if (preserveDirectories) {
+          // one cannot change a name of a TObject, we have to create a new one...
+          auto clonedTObj = storedTObj->Clone(pathInFile.c_str());
+          delete storedTObj;
+          storedTObj = clonedTObj;
         }
-        delete storedTObj;
+        auto mo = std::make_shared<MonitorObject>(storedTObj, taskName, "unknown", detectorCode, runNumber, periodName, passName, provenance);
+        mo->setIsOwner(true);
+        mo->setValidity({ validityStart, validityEnd });
+        queue.push({ pathInFile, std::move(mo), static_cast<uint64_t>(key->GetObjlen()) });
+      });
+    } catch (...) {
+      queue.close();
+      for (auto& thread : threads) {
+        thread.join();
       }
-    };
+      throw;
+    }
+    queue.close();
+    for (auto& thread : threads) {
+      thread.join();
+    }
 
-    browseFileAndUpload(file, "");
+    double duration = timer.getTime();
+    double megabytesUploaded = statistics.bytesUploaded / 1e6;
+    ILOG(Info, Support) << "Uploaded " << megabytesUploaded << " MB in " << duration << " s with " << workers << " workers: "
+                        << (duration > 0 ? statistics.objectsUploaded / duration : 0) << " objects/s, "
+                        << (duration > 0 ? megabytesUploaded / duration : 0) << " MB/s" << ENDM;
 
     file->Close();
     delete file;
 
-    database.disconnect();
+    for (auto& database : databases) {
+      database->disconnect();
+    }
 
   } catch (const bpo::error& ex) {
     ILOG(Error, Ops) << "Exception caught: " << ex.what() << ENDM;
@@ -148,12 +428,23 @@ int main(int argc, const char* argv[])
   } catch (const boost::exception& ex) {
     ILOG(Error, Ops) << "Exception caught: " << boost::current_exception_diagnostic_information(true) << ENDM;
     return 1;
+  } catch (const std::exception& ex) {
+    ILOG(Error, Ops) << "Exception caught: " << ex.what() << ENDM;
+    return 1;
   }
 
-  if (objectsUploaded > 0) {
-    ILOG(Info, Support) << "Successfully uploaded " << objectsUploaded << " objects to the QCDB." << ENDM;
+  if (statistics.objectsSkipped > 0) {
+    ILOG(Info, Support) << "Skipped " << statistics.objectsSkipped << " objects which were already uploaded according to the journal." << ENDM;
+  }
+  if (statistics.objectsFailed > 0) {
+    ILOG(Error, Support) << "Failed to upload " << statistics.objectsFailed << " objects, " << statistics.objectsUploaded
+                         << " were uploaded. Run again with the same journal to upload only the missing ones." << ENDM;
+    return 1;
+  }
+  if (statistics.objectsUploaded > 0) {
+    ILOG(Info, Support) << "Successfully uploaded " << statistics.objectsUploaded << " objects to the QCDB." << ENDM;
   } else {
     ILOG(Info, Support) << "No objects were uploaded to the QCDB. Maybe the file is empty?" << ENDM;
   }
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,301 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testAsyncDatabase.cxx
+///
+
+#include "QualityControl/AsyncDatabase.h"
+#include "QualityControl/DummyDatabase.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/QualityObject.h"
+
+#include <TH1F.h>
+#include <catch_amalgamated.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+// Stands in for a (slow) QCDB. All instances created by a test share the same record of stored objects.
+struct StoredObjects {
+  std::mutex mutex;
+  std::vector<std::pair<std::string, double>> entries; // path and number of entries of the histogram
+  std::atomic<int> concurrentStores = 0;
+  std::atomic<int> maxConcurrentStores = 0;
+  std::condition_variable storeStateChanged;
+  int startedStores = 0;     // guarded by the mutex
+  bool storesOnHold = false; // guarded by the mutex, the started stores do not finish until released
+
+  // Waits until the given number of MOs are being or have been stored, so that a test knows which ones left the queue.
+  bool waitForStartedStores(int count)
+  {
+    std::unique_lock lock(mutex);
+    return storeStateChanged.wait_for(lock, 10s, [&] { return startedStores >= count; });
+  }
+
+  void holdStores()
+  {
+    std::lock_guard lock(mutex);
+    storesOnHold = true;
+  }
+
+  void releaseStores()
+  {
+    {
+      std::lock_guard lock(mutex);
+      storesOnHold = false;
+    }
+    storeStateChanged.notify_all();
+  }
+};
+
+class SlowDatabase : public DummyDatabase
+{
+ public:
+  SlowDatabase(std::shared_ptr<StoredObjects> stored, std::chrono::milliseconds delay) : mStored(std::move(stored)), mDelay(delay) {}
+
+  void storeMO(std::shared_ptr<const MonitorObject> mo) override
+  {
+    auto concurrent = ++mStored->concurrentStores;
+    int previousMax = mStored->maxConcurrentStores;
+    while (concurrent > previousMax && !mStored->maxConcurrentStores.compare_exchange_weak(previousMax, concurrent)) {
+    }
+    {
+      std::unique_lock lock(mStored->mutex);
+      mStored->startedStores++;
+      mStored->storeStateChanged.notify_all();
+      // bounded, so that a failing test does not hang
+      mStored->storeStateChanged.wait_for(lock, 10s, [this] { return !mStored->storesOnHold; });
+    }
+    std::this_thread::sleep_for(mDelay);
+    // refused without an exception, like CcdbDatabase does with too big objects
+    mLastObjectStored = mo->getName().find("refused") != 0;
+    if (mLastObjectStored) {
+      std::lock_guard lock(mStored->mutex);
+      mStored->entries.emplace_back(mo->getPath(), dynamic_cast<TH1*>(mo->getObject())->GetEntries());
+    }
+    --mStored->concurrentStores;
+  }
+
+  bool isLastObjectStored() const override { return mLastObjectStored; }
+
+  void storeQO(std::shared_ptr<const QualityObject> qo) override
+  {
+    if (qo->getName().empty()) {
+      throw std::runtime_error("empty name");
+    }
+    std::lock_guard lock(mStored->mutex);
+    mStored->entries.emplace_back(qo->getPath(), 0);
+  }
+
+ private:
+  std::shared_ptr<StoredObjects> mStored;
+  std::chrono::milliseconds mDelay;
+  bool mLastObjectStored = true;
+};
+
+std::shared_ptr<MonitorObject> makeMO(const std::string& name, int entries)
+{
+  auto* histo = new TH1F(name.c_str(), name.c_str(), 10, 0, 10);
+  for (int i = 0; i < entries; i++) {
+    histo->Fill(1);
+  }
+  auto mo = std::make_shared<MonitorObject>(histo, "task", "class", "TST");
+  mo->setIsOwner(true);
+  return mo;
+}
+
+} // namespace
+
+TEST_CASE("async_database_config")
+{
+  std::unordered_map<std::string, std::string> config{ { "implementation", "CCDB" } };
+  CHECK(!AsyncDatabase::isEnabled(config));
+  config["asyncStorage"] = "true";
+  config["asyncStorageWorkers"] = "4";
+  config["asyncStorageQueueSize"] = "50";
+  CHECK(AsyncDatabase::isEnabled(config));
+  auto asyncConfig = AsyncDatabase::Config::fromDatabaseConfig(config);
+  CHECK(asyncConfig.workers == 4);
+  CHECK(asyncConfig.queueCapacity == 50);
+  CHECK(asyncConfig.dropWhenFull == false);
+}
+
+TEST_CASE("async_database_stores_everything")
+{
+  auto stored = std::make_shared<StoredObjects>();
+  AsyncDatabase db([stored]() { return std::make_unique<SlowDatabase>(stored, 5ms); }, { 4, 100, false });
+
+  for (int i = 0; i < 20; i++) {
+    db.storeMO(makeMO("histo" + std::to_string(i), i));
+  }
+  db.flush();
+
+  CHECK(stored->entries.size() == 20);
+  CHECK(stored->maxConcurrentStores > 1);
+  CHECK(stored->maxConcurrentStores <= 4);
+  auto stats = db.getStatistics();
+  CHECK(stats.enqueued == 20);
+  CHECK(stats.stored == 20);
+  CHECK(stats.queueSize == 0);
+}
+
+TEST_CASE("async_database_coalescing")
+{
+  auto stored = std::make_shared<StoredObjects>();
+  AsyncDatabase db([stored]() { return std::make_unique<SlowDatabase>(stored, 50ms); }, { 1, 100, false });
+
+  // the first version is picked up by the worker and held there, the following ones wait in the queue
+  // and all but the last one should be superseded.
+  stored->holdStores();
+  db.storeMO(makeMO("histo", 1));
+  REQUIRE(stored->waitForStartedStores(1));
+  for (int entries = 2; entries <= 5; entries++) {
+    db.storeMO(makeMO("histo", entries));
+  }
+  stored->releaseStores();
+  db.flush();
+
+  REQUIRE(stored->entries.size() == 2);
+  CHECK(stored->entries[0].second == 1);
+  CHECK(stored->entries[1].second == 5);
+  CHECK(db.getStatistics().coalesced == 3);
+}
+
+TEST_CASE("async_database_snapshot")
+{
+  auto stored = std::make_shared<StoredObjects>();
+  AsyncDatabase db([stored]() { return std::make_unique<SlowDatabase>(stored, 20ms); }, { 1, 100, false });
+
+  auto mo = makeMO("histo", 1);
+  db.storeMO(mo);
+  // modifying the object after handing it over must not affect what is stored
+  dynamic_cast<TH1*>(mo->getObject())->Fill(2);
+  db.flush();
+
+  REQUIRE(stored->entries.size() == 1);
+  CHECK(stored->entries[0].second == 1);
+}
+
+TEST_CASE("async_database_full_queue")
+{
+  SECTION("drop")
+  {
+    auto stored = std::make_shared<StoredObjects>();
+    AsyncDatabase db([stored]() { return std::make_unique<SlowDatabase>(stored, 50ms); }, { 1, 2, true });
+    stored->holdStores();
+    db.storeMO(makeMO("histo0", 0));
+    REQUIRE(stored->waitForStartedStores(1)); // histo0 is being stored, the queue is empty
+    for (int i = 1; i <= 4; i++) {
+      db.storeMO(makeMO("histo" + std::to_string(i), i));
+    }
+    stored->releaseStores();
+    db.flush();
+    CHECK(stored->entries.size() == 3);
+    CHECK(db.getStatistics().dropped == 2);
+  }
+
+  SECTION("back-pressure")
+  {
+    auto stored = std::make_shared<StoredObjects>();
+    AsyncDatabase db([stored]() { return std::make_unique<SlowDatabase>(stored, 20ms); }, { 1, 2, false });
+    for (int i = 0; i < 6; i++) {
+      db.storeMO(makeMO("histo" + std::to_string(i), i));
+    }
+    db.flush();
+    CHECK(stored->entries.size() == 6);
+    auto stats = db.getStatistics();
+    CHECK(stats.dropped == 0);
+    CHECK(stats.blockedSeconds > 0);
+  }
+}
+
+TEST_CASE("async_database_failures")
+{
+  auto stored = std::make_shared<StoredObjects>();
+  AsyncDatabase db([stored]() { return std::make_unique<SlowDatabase>(stored, 0ms); }, { 2, 10, false });
+
+  db.storeQO(std::make_shared<QualityObject>(Quality::Good, "check"));
+  db.storeQO(std::make_shared<QualityObject>(Quality::Good, ""));
+  db.flush();
+
+  auto stats = db.getStatistics();
+  CHECK(stats.stored == 1);
+  CHECK(stats.failed == 1);
+}
+
+TEST_CASE("async_database_destructor_flushes")
+{
+  auto stored = std::make_shared<StoredObjects>();
+  {
+    AsyncDatabase db([stored]() { return std::make_unique<SlowDatabase>(stored, 5ms); }, { 2, 100, false });
+    for (int i = 0; i < 10; i++) {
+      db.storeMO(makeMO("histo" + std::to_string(i), i));
+    }
+  }
+  CHECK(stored->entries.size() == 10);
+}
+
+TEST_CASE("async_database_store_after")
+{
+  auto stored = std::make_shared<StoredObjects>();
+  AsyncDatabase db([stored]() { return std::make_unique<SlowDatabase>(stored, 5ms); }, { 4, 100, false });
+
+  std::vector<std::string> paths;
+  for (int i = 0; i < 10; i++) {
+    auto mo = makeMO("histo" + std::to_string(i), i);
+    paths.push_back(mo->getPath());
+    db.storeMO(mo);
+  }
+  db.storeMOAfter(makeMO("marker", 1), paths);
+  db.flush();
+
+  REQUIRE(stored->entries.size() == 11);
+  CHECK(stored->entries.back().first == makeMO("marker", 1)->getPath());
+}
+
+TEST_CASE("async_database_store_after_refused")
+{
+  auto stored = std::make_shared<StoredObjects>();
+  AsyncDatabase db([stored]() { return std::make_unique<SlowDatabase>(stored, 5ms); }, { 2, 100, false });
+
+  auto mo = makeMO("histo", 1);
+  auto refusedMO = makeMO("refusedHisto", 1);
+  db.storeMO(mo);
+  db.storeMO(refusedMO);
+  db.storeMOAfter(makeMO("marker", 1), { mo->getPath(), refusedMO->getPath() });
+  db.flush();
+
+  // the marker follows an object which was not stored, thus it is not stored either
+  REQUIRE(stored->entries.size() == 1);
+  CHECK(stored->entries[0].first == mo->getPath());
+  auto stats = db.getStatistics();
+  CHECK(stats.stored == 1);
+  CHECK(stats.failed == 1);
+  CHECK(stats.skipped == 1);
+
+  // once the object is stored, the marker can follow again
+  db.storeMO(mo);
+  db.storeMOAfter(makeMO("marker", 1), { mo->getPath() });
+  db.flush();
+  REQUIRE(stored->entries.size() == 3);
+  CHECK(stored->entries.back().first == makeMO("marker", 1)->getPath());
+}
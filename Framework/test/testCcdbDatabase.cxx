@@ -25,6 +25,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <TH1F.h>
+#include <TH2F.h>
 #include "QualityControl/RepoPathUtils.h"
 #include "QualityControl/ObjectMetadataKeys.h"
 #include "QualityControl/ActivityHelpers.h"
@@ -32,6 +33,7 @@
 #include <DataFormatsQualityControl/FlagTypeFactory.h>
 #include <TROOT.h>
 #include <CCDB/CcdbApi.h>
+#include <Common/Exceptions.h>
 
 namespace utf = boost::unit_test;
 
@@ -389,6 +391,41 @@ BOOST_AUTO_TEST_CASE(ccdb_store_retrieve_any)
   BOOST_CHECK(h1_back->GetEntries() > 0);
 }
 
+BOOST_AUTO_TEST_CASE(ccdb_compression_settings)
+{
+  BOOST_CHECK_EQUAL(CcdbDatabase::parseCompressionSettings(""), -1);
+  BOOST_CHECK_EQUAL(CcdbDatabase::parseCompressionSettings("default"), -1);
+  BOOST_CHECK_EQUAL(CcdbDatabase::parseCompressionSettings("none"), 0);
+  BOOST_CHECK_EQUAL(CcdbDatabase::parseCompressionSettings("zstd"), 505);
+  BOOST_CHECK_EQUAL(CcdbDatabase::parseCompressionSettings("lz4:2"), 402);
+  BOOST_CHECK_EQUAL(CcdbDatabase::parseCompressionSettings("zlib:9"), 109);
+  BOOST_CHECK_THROW(CcdbDatabase::parseCompressionSettings("gzip"), AliceO2::Common::DatabaseException);
+  BOOST_CHECK_THROW(CcdbDatabase::parseCompressionSettings("zstd:"), AliceO2::Common::DatabaseException);
+  BOOST_CHECK_THROW(CcdbDatabase::parseCompressionSettings("zstd:5x"), AliceO2::Common::DatabaseException);
+  BOOST_CHECK_THROW(CcdbDatabase::parseCompressionSettings("zstd:10"), AliceO2::Common::DatabaseException);
+}
+
+BOOST_AUTO_TEST_CASE(ccdb_store_retrieve_compressed)
+{
+  test_fixture f;
+
+  f.backend->setCompressionSettings(CcdbDatabase::parseCompressionSettings("zstd:5"));
+  auto* h1 = new TH2F("compressed", "compressed", 500, 0, 1, 500, 0, 1);
+  h1->Fill(0.5, 0.5);
+  shared_ptr<MonitorObject> mo = make_shared<MonitorObject>(h1, f.taskName, "TestClass", "TST");
+  f.backend->storeMO(mo);
+
+  auto statistics = f.backend->getCompressionStatistics();
+  BOOST_CHECK_EQUAL(statistics.objects, 1);
+  BOOST_CHECK_GT(statistics.rawBytes, statistics.compressedBytes);
+
+  auto moBack = f.backend->retrieveMO(f.getMoFolder("compressed"), "compressed");
+  BOOST_REQUIRE(moBack != nullptr);
+  auto* h1Back = dynamic_cast<TH2F*>(moBack->getObject());
+  BOOST_REQUIRE(h1Back != nullptr);
+  BOOST_CHECK_EQUAL(h1Back->GetEntries(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(ccdb_store_retrieve_latest)
 {
   test_fixture f;
@@ -168,4 +168,40 @@ TEST_CASE("test_check_activity")
   REQUIRE(qos.size() == 1);
   ValidityInterval correctValidity{ 1, 15 };
   CHECK(qos[0]->getActivity().mValidity == correctValidity);
-}
\ No newline at end of file
+}
+TEST_CASE("test_check_maps_to_check")
+{
+  Check check({ "test",
+                "QcSkeleton",
+                "o2::quality_control_modules::skeleton::SkeletonCheck",
+                "TST",
+                {},
+                UpdatePolicyType::OnEachSeparately,
+                {},
+                true });
+
+  std::map<std::string, std::shared_ptr<MonitorObject>> moMap{
+    { "abcTask/test1", dummyMO("test1") },
+    { "abcTask/test2", dummyMO("test2") },
+    { "abcTask/test3", dummyMO("test3") }
+  };
+
+  check.init();
+  check.startOfActivity(Activity());
+
+  auto moMaps = check.prepareMapsToCheck(moMap);
+  REQUIRE(moMaps.size() == 3);
+  CHECK(moMaps[0].begin()->first == "abcTask/test1");
+  CHECK(moMaps[2].begin()->first == "abcTask/test3");
+
+  // evaluating the maps one by one must give the same result as check()
+  auto qos = check.check(moMap);
+  REQUIRE(qos.size() == 3);
+  for (size_t i = 0; i < moMaps.size(); i++) {
+    auto qo = check.checkSingle(moMaps[i]);
+    REQUIRE(qo != nullptr);
+    CHECK(qo->getName() == qos[i]->getName());
+    CHECK(qo->getQuality() == qos[i]->getQuality());
+  }
+  CHECK(check.isParallelEvaluationAllowed() == false);
+}
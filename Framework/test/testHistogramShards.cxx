@@ -0,0 +1,93 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testHistogramShards.cxx
+///
+
+#include "QualityControl/HistogramShards.h"
+
+#include <catch_amalgamated.hpp>
+#include <TH1I.h>
+#include <TH2F.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace o2::quality_control::core;
+
+TEST_CASE("histogram_shards_single_shard")
+{
+  TH1I histogram("histogram", "histogram", 10, 0, 10);
+  histogram.SetDirectory(nullptr);
+  HistogramShards shards;
+  shards.add(&histogram);
+
+  // no copies, the histogram is filled directly
+  CHECK(shards.get(&histogram, 0) == &histogram);
+  shards.get(&histogram, 0)->Fill(5);
+  shards.merge();
+  CHECK(histogram.GetEntries() == 1);
+  CHECK_THROWS_AS(shards.get(&histogram, 1), std::out_of_range);
+}
+
+TEST_CASE("histogram_shards_merge")
+{
+  TH1I histogram1D("histogram1D", "histogram1D", 10, 0, 10);
+  histogram1D.SetDirectory(nullptr);
+  TH2F histogram2D("histogram2D", "histogram2D", 10, 0, 10, 10, 0, 10);
+  histogram2D.SetDirectory(nullptr);
+  TH1I notRegistered("notRegistered", "notRegistered", 10, 0, 10);
+  notRegistered.SetDirectory(nullptr);
+  histogram1D.Fill(1);
+
+  const size_t nShards = 4;
+  const int fillsPerShard = 1000;
+  HistogramShards shards(nShards);
+  shards.add(&histogram1D);
+  shards.add(&histogram2D);
+  CHECK(shards.getNumberOfShards() == nShards);
+  CHECK(shards.get(&histogram1D, 0) != &histogram1D);
+  CHECK_THROWS_AS(shards.get(&notRegistered, 0), std::out_of_range);
+  CHECK_THROWS_AS(shards.get(&histogram1D, nShards), std::out_of_range);
+
+  std::vector<std::thread> threads;
+  for (size_t shard = 0; shard < nShards; shard++) {
+    threads.emplace_back([&shards, &histogram1D, &histogram2D, shard, fillsPerShard]() {
+      for (int i = 0; i < fillsPerShard; i++) {
+        shards.get(&histogram1D, shard)->Fill(shard);
+        shards.get(&histogram2D, shard)->Fill(shard, i % 10, 0.5);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // nothing is published before merging
+  CHECK(histogram1D.GetEntries() == 1);
+  shards.merge();
+  CHECK(histogram1D.GetEntries() == 1 + nShards * fillsPerShard);
+  CHECK(histogram1D.GetBinContent(histogram1D.FindBin(1)) == 1 + fillsPerShard);
+  CHECK(histogram1D.GetBinContent(histogram1D.FindBin(3)) == fillsPerShard);
+  CHECK(histogram2D.GetEntries() == nShards * fillsPerShard);
+  CHECK(histogram2D.GetSumOfWeights() == Catch::Approx(0.5 * nShards * fillsPerShard));
+
+  // the copies are empty after merging
+  shards.merge();
+  CHECK(histogram1D.GetEntries() == 1 + nShards * fillsPerShard);
+
+  // reset drops what was not merged
+  shards.get(&histogram1D, 2)->Fill(2);
+  shards.reset();
+  shards.merge();
+  CHECK(histogram1D.GetEntries() == 1 + nShards * fillsPerShard);
+}
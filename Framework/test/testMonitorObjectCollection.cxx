@@ -242,4 +242,72 @@ TEST_CASE("monitor_object_collection_clone_mw")
   delete mwMOC2;
 }
 
+TEST_CASE("monitor_object_collection_find_object")
+{
+  MonitorObjectCollection moc;
+  moc.SetOwner(true);
+  for (int i = 0; i < 10; i++) {
+    auto name = "histo" + std::to_string(i);
+    auto mo = new MonitorObject(new TH1I(name.c_str(), name.c_str(), 10, 0, 10), "task", "class", "DET");
+    mo->setIsOwner(true);
+    moc.Add(mo);
+  }
+
+  REQUIRE(moc.FindObject("histo0") == moc.At(0));
+  REQUIRE(moc.FindObject("histo9") == moc.At(9));
+  CHECK(moc.FindObject("histo10") == nullptr);
+  CHECK(moc.FindObject("") == nullptr);
+
+  // modifications which are not tracked by the index
+  delete moc.RemoveAt(3);
+  CHECK(moc.FindObject("histo3") == nullptr);
+  moc.Compress();
+  CHECK(moc.FindObject("histo4") == moc.At(3));
+  CHECK(moc.FindObject("histo9") == moc.At(8));
+
+  auto mo = new MonitorObject(new TH1I("histo3", "histo3", 10, 0, 10), "task", "class", "DET");
+  mo->setIsOwner(true);
+  delete moc.RemoveAt(0);
+  moc.AddFirst(mo);
+  CHECK(moc.FindObject("histo3") == mo);
+  CHECK(moc.FindObject("histo0") == nullptr);
+
+  moc.Delete();
+  CHECK(moc.FindObject("histo3") == nullptr);
+  CHECK(moc.FindObject("histo4") == nullptr);
+}
+
+TEST_CASE("monitor_object_collection_find_renamed_object")
+{
+  MonitorObjectCollection moc;
+  moc.SetOwner(true);
+  for (int i = 0; i < 3; i++) {
+    auto name = "histo" + std::to_string(i);
+    auto mo = new MonitorObject(new TH1I(name.c_str(), name.c_str(), 10, 0, 10), "task", "class", "DET");
+    mo->setIsOwner(true);
+    moc.Add(mo);
+  }
+  REQUIRE(moc.FindObject("histo1") == moc.At(1));
+
+  // the index still knows the object under its former name
+  auto renamed = dynamic_cast<MonitorObject*>(moc.At(1));
+  renamed->getObject()->SetName("renamed");
+  CHECK(moc.FindObject("renamed") == renamed);
+  CHECK(moc.FindObject("histo1") == nullptr);
+
+  // merging an object with the new name should not add a duplicate, the target is renamed again to make the index stale
+  MonitorObjectCollection other;
+  other.SetOwner(true);
+  auto otherMO = new MonitorObject(new TH1I("renamed", "renamed", 10, 0, 10), "task", "class", "DET");
+  otherMO->setIsOwner(true);
+  dynamic_cast<TH1I*>(otherMO->getObject())->Fill(5);
+  other.Add(otherMO);
+
+  renamed->getObject()->SetName("renamedAgain");
+  dynamic_cast<MonitorObject*>(other.At(0))->getObject()->SetName("renamedAgain");
+  moc.merge(&other);
+  CHECK(moc.GetEntries() == 3);
+  CHECK(dynamic_cast<TH1I*>(renamed->getObject())->GetEntries() == 1);
+}
+
 } // namespace o2::quality_control::core
@@ -0,0 +1,133 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testObjectCache.cxx
+///
+
+#include "QualityControl/ObjectCache.h"
+
+#include <filesystem>
+#include <unistd.h>
+#include <catch_amalgamated.hpp>
+#include <TH1I.h>
+
+using namespace o2::quality_control::repository;
+
+struct TestDirectoryFixture {
+  TestDirectoryFixture(const std::string& testCase)
+  {
+    directory = "/tmp/qc_test_object_cache_" + testCase + "_" + std::to_string(getpid());
+    std::filesystem::remove_all(directory);
+  }
+
+  ~TestDirectoryFixture()
+  {
+    std::filesystem::remove_all(directory);
+  }
+
+  std::string directory;
+};
+
+TEST_CASE("object_cache_config")
+{
+  CHECK_FALSE(ObjectCache::isEnabled({}));
+  CHECK_FALSE(ObjectCache::isEnabled({ { "objectCache", "false" } }));
+  CHECK(ObjectCache::isEnabled({ { "objectCache", "true" } }));
+
+  auto config = ObjectCache::Config::fromDatabaseConfig({ { "objectCacheDirectory", "/tmp/abc" }, { "objectCacheMaxSizeMB", "3" }, { "objectCacheMemoryEntries", "7" } });
+  CHECK(config.directory == "/tmp/abc");
+  CHECK(config.maxDiskBytes == 3 * 1024 * 1024);
+  CHECK(config.memoryEntries == 7);
+}
+
+TEST_CASE("object_cache_memory")
+{
+  ObjectCache cache({ 2, "", 0 });
+  TH1I histogram("histo", "histo", 10, 0, 10);
+  histogram.SetDirectory(nullptr);
+  histogram.Fill(5);
+
+  CHECK_FALSE(cache.get("a").has_value());
+  cache.put("a", histogram, { { "ETag", "\"a\"" } });
+  histogram.Fill(5);
+  cache.put("b", histogram, {});
+
+  auto entry = cache.get("a");
+  REQUIRE(entry.has_value());
+  REQUIRE(entry->object != nullptr);
+  CHECK(entry->headers.at("ETag") == "\"a\"");
+  auto* retrieved = dynamic_cast<TH1I*>(entry->object.get());
+  REQUIRE(retrieved != nullptr);
+  CHECK(retrieved->GetEntries() == 1);
+
+  // "b" is now the least recently used
+  cache.put("c", histogram, {});
+  CHECK_FALSE(cache.get("b").has_value());
+  CHECK(cache.get("a").has_value());
+  CHECK(cache.get("c").has_value());
+
+  auto statistics = cache.getStatistics();
+  CHECK(statistics.memoryHits == 3);
+  CHECK(statistics.diskHits == 0);
+  CHECK(statistics.misses == 2);
+}
+
+TEST_CASE("object_cache_disk")
+{
+  TestDirectoryFixture fixture("disk");
+  TH1I histogram("histo", "histo", 1000, 0, 1000);
+  histogram.SetDirectory(nullptr);
+  histogram.Fill(5);
+
+  {
+    ObjectCache cache({ 0, fixture.directory, 1ull << 20 });
+    cache.put("a", histogram, { { "Valid-From", "1" } });
+    CHECK(cache.getStatistics().diskBytes > 0);
+  }
+
+  // a new cache finds the objects stored by the previous one
+  ObjectCache cache({ 0, fixture.directory, 1ull << 20 });
+  CHECK(cache.getStatistics().diskBytes > 0);
+  auto entry = cache.get("a");
+  REQUIRE(entry.has_value());
+  CHECK(entry->headers.at("Valid-From") == "1");
+  auto* retrieved = dynamic_cast<TH1I*>(entry->object.get());
+  REQUIRE(retrieved != nullptr);
+  CHECK(retrieved->GetBinContent(retrieved->FindBin(5)) == 1);
+  CHECK_FALSE(cache.get("b").has_value());
+  CHECK(cache.getStatistics().diskHits == 1);
+  CHECK(cache.getStatistics().misses == 1);
+}
+
+TEST_CASE("object_cache_disk_eviction")
+{
+  TestDirectoryFixture fixture("disk_eviction");
+  TH1I histogram("histo", "histo", 1000, 0, 1000);
+  histogram.SetDirectory(nullptr);
+
+  ObjectCache sizing({ 0, fixture.directory, 1ull << 20 });
+  sizing.put("size", histogram, {});
+  const auto fileSize = sizing.getStatistics().diskBytes;
+
+  // room for two files, the third one evicts the least recently used
+  ObjectCache cache({ 0, fixture.directory, 2 * fileSize });
+  cache.put("a", histogram, {});
+  cache.put("b", histogram, {});
+  CHECK(cache.get("a").has_value());
+  cache.put("c", histogram, {});
+
+  CHECK(cache.getStatistics().evictions >= 2);
+  CHECK(cache.getStatistics().diskBytes <= 2 * fileSize);
+  CHECK(cache.get("a").has_value());
+  CHECK(cache.get("c").has_value());
+  CHECK_FALSE(cache.get("b").has_value());
+}
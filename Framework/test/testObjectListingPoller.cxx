@@ -0,0 +1,127 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testObjectListingPoller.cxx
+///
+
+#include "QualityControl/ObjectListingPoller.h"
+
+#include <catch_amalgamated.hpp>
+#include <regex>
+#include <stdexcept>
+#include <vector>
+
+using namespace o2::quality_control::postprocessing;
+using namespace std::chrono;
+using boost::property_tree::ptree;
+
+namespace
+{
+ptree createEntry(const std::string& path, uint64_t lastModified)
+{
+  ptree entry;
+  entry.put("path", path);
+  entry.put("lastModified", lastModified);
+  return entry;
+}
+
+struct FakeDatabase {
+  std::vector<std::string> listedPatterns;
+  std::map<std::string, uint64_t> objects; // path -> lastModified
+  bool failing = false;
+
+  ObjectListingPoller::ListingFcn listingFcn()
+  {
+    return [this](const std::string& pathPattern, const std::map<std::string, std::string>&) {
+      listedPatterns.push_back(pathPattern);
+      if (failing) {
+        throw std::runtime_error("failure");
+      }
+      ptree objectsTree;
+      for (const auto& [path, lastModified] : objects) {
+        if (std::regex_match(path, std::regex(pathPattern))) {
+          objectsTree.push_back({ "", createEntry(path, lastModified) });
+        }
+      }
+      return objectsTree;
+    };
+  }
+};
+} // namespace
+
+TEST_CASE("object_listing_poller_groups_by_directory")
+{
+  FakeDatabase db;
+  db.objects = { { "qc/TST/MO/Task/a", 10 }, { "qc/TST/MO/Task/b", 20 }, { "qc/TST/MO/Other/c", 30 } };
+  ObjectListingPoller poller(db.listingFcn());
+
+  // a single object is listed alone, each new object makes the directory listed again with all the requested objects
+  auto a = poller.getLatest("qc/TST/MO/Task/a", {}, hours(1));
+  auto b = poller.getLatest("qc/TST/MO/Task/b", {}, hours(1));
+  auto missing = poller.getLatest("qc/TST/MO/Task/mis.sing", {}, hours(1));
+  REQUIRE(db.listedPatterns.size() == 3);
+  CHECK(db.listedPatterns[0] == "qc/TST/MO/Task/a");
+  CHECK(db.listedPatterns[1] == "qc/TST/MO/Task/(a|b)");
+  CHECK(db.listedPatterns[2] == "qc/TST/MO/Task/(a|b|mis\\.sing)");
+
+  // afterwards, one listing serves all of them
+  a = poller.getLatest("qc/TST/MO/Task/a", {}, hours(1));
+  b = poller.getLatest("qc/TST/MO/Task/b", {}, hours(1));
+  missing = poller.getLatest("qc/TST/MO/Task/mis.sing", {}, hours(1));
+  REQUIRE(a.has_value());
+  REQUIRE(b.has_value());
+  REQUIRE(missing.has_value());
+  CHECK(a->get<uint64_t>("lastModified") == 10);
+  CHECK(b->get<uint64_t>("lastModified") == 20);
+  CHECK(missing->empty());
+  CHECK(db.listedPatterns.size() == 3);
+
+  // the other objects in the directory are not listed
+  db.objects["qc/TST/MO/Task/notWatched"] = 40;
+  a = poller.getLatest("qc/TST/MO/Task/a", {}, seconds(0));
+  CHECK(a->get<uint64_t>("lastModified") == 10);
+  CHECK(db.listedPatterns.size() == 4);
+
+  // another directory and another metadata filter need their own listings
+  CHECK(poller.getLatest("qc/TST/MO/Other/c", {}, hours(1)).has_value());
+  CHECK(poller.getLatest("qc/TST/MO/Task/a", { { "RunNumber", "1" } }, hours(1)).has_value());
+  CHECK(db.listedPatterns.size() == 6);
+
+  auto statistics = poller.getStatistics();
+  CHECK(statistics.listings == 6);
+  CHECK(statistics.requests == 9);
+  CHECK(statistics.failedListings == 0);
+}
+
+TEST_CASE("object_listing_poller_refresh")
+{
+  FakeDatabase db;
+  db.objects = { { "qc/TST/MO/Task/a", 10 } };
+  ObjectListingPoller poller(db.listingFcn());
+
+  CHECK(poller.getLatest("qc/TST/MO/Task/a", {}, hours(1))->get<uint64_t>("lastModified") == 10);
+  db.objects["qc/TST/MO/Task/a"] = 11;
+  // the listing is still fresh enough
+  CHECK(poller.getLatest("qc/TST/MO/Task/a", {}, hours(1))->get<uint64_t>("lastModified") == 10);
+  // it is not
+  CHECK(poller.getLatest("qc/TST/MO/Task/a", {}, seconds(0))->get<uint64_t>("lastModified") == 11);
+  CHECK(db.listedPatterns.size() == 2);
+
+  // objects at the top level are not grouped
+  db.objects["top"] = 1;
+  CHECK(poller.getLatest("top", {}, hours(1))->get<uint64_t>("lastModified") == 1);
+  CHECK(db.listedPatterns.back() == "top");
+
+  db.failing = true;
+  CHECK_FALSE(poller.getLatest("qc/TST/MO/Task/a", {}, seconds(0)).has_value());
+  CHECK(poller.getStatistics().failedListings == 1);
+}
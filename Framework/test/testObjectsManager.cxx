@@ -23,6 +23,8 @@
 #include <TObjArray.h>
 #include <TH1F.h>
 #include <boost/test/unit_test.hpp>
+#include <memory>
+#include <vector>
 
 using namespace std;
 using namespace o2::quality_control::core;
@@ -135,6 +137,46 @@ BOOST_AUTO_TEST_CASE(unpublish_test)
   delete s5;
 }
 
+BOOST_AUTO_TEST_CASE(unpublish_many_test)
+{
+  Config config;
+  config.taskName = "test";
+  ObjectsManager objectsManager(config.taskName, config.taskClass, config.detectorName, config.consulUrl, 0, true);
+
+  std::vector<std::unique_ptr<TObjString>> objects;
+  for (size_t i = 0; i < 100; i++) {
+    objects.emplace_back(std::make_unique<TObjString>(("content" + std::to_string(i)).c_str()));
+    objectsManager.startPublishing<true>(objects.back().get(), i % 2 ? PublicationPolicy::Once : PublicationPolicy::Forever);
+  }
+  objectsManager.stopPublishing(objects[0].get());
+  objectsManager.stopPublishing("content2");
+  BOOST_CHECK_EQUAL(objectsManager.getNumberPublishedObjects(), 98);
+
+  // the removed objects do not leave holes in the published collection nor in the indices
+  std::unique_ptr<MonitorObjectCollection> array(objectsManager.getNonOwningArray());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 98);
+  BOOST_CHECK_EQUAL(array->GetEntriesFast(), 98);
+  BOOST_CHECK(array->FindObject("content0") == nullptr);
+  BOOST_CHECK(array->FindObject("content3") != nullptr);
+  for (size_t i = 0; i < objectsManager.getNumberPublishedObjects(); i++) {
+    BOOST_CHECK(objectsManager.getMonitorObject(i) != nullptr);
+  }
+
+  objectsManager.stopPublishing(PublicationPolicy::Once);
+  BOOST_CHECK_EQUAL(objectsManager.getNumberPublishedObjects(), 48);
+  BOOST_CHECK(!objectsManager.isBeingPublished("content1"));
+  BOOST_CHECK(objectsManager.isBeingPublished("content4"));
+  BOOST_CHECK_EQUAL(objectsManager.getMonitorObject("content98")->getObject(), objects[98].get());
+  BOOST_CHECK_EQUAL(objectsManager.getMonitorObject(47)->getObject(), objects[98].get());
+
+  // the objects can be published again after removal
+  objectsManager.startPublishing<true>(objects[1].get(), PublicationPolicy::Forever);
+  BOOST_CHECK_EQUAL(objectsManager.getNumberPublishedObjects(), 49);
+  BOOST_CHECK_EQUAL(objectsManager.getMonitorObject("content1")->getObject(), objects[1].get());
+  objectsManager.stopPublishingAll();
+  BOOST_CHECK_EQUAL(objectsManager.getNumberPublishedObjects(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(getters_test)
 {
   Config config;
@@ -217,4 +259,52 @@ BOOST_AUTO_TEST_CASE(feed_with_nullptr)
   BOOST_CHECK_NO_THROW(objectsManager.stopPublishing(nullptr));
 }
 
+BOOST_AUTO_TEST_CASE(updated_objects_test)
+{
+  Config config;
+  config.taskName = "test";
+  config.consulUrl = "";
+  ObjectsManager objectsManager(config.taskName, config.taskClass, config.detectorName, config.consulUrl, 0, true);
+
+  TObjString s("content");
+  TH1F h1("histo1", "h", 100, 0, 99);
+  TH1F h2("histo2", "h", 100, 0, 99);
+  objectsManager.startPublishing<true>(&s, PublicationPolicy::Forever);
+  objectsManager.startPublishing<true>(&h1, PublicationPolicy::Forever);
+  objectsManager.startPublishing<true>(&h2, PublicationPolicy::Forever);
+
+  // empty histograms are left out, non-histograms are always considered as modified
+  std::unique_ptr<MonitorObjectCollection> array(objectsManager.getNonOwningArrayOfUpdatedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  BOOST_CHECK(array->FindObject("content") != nullptr);
+  BOOST_CHECK_EQUAL(array->getTaskName(), "test");
+  BOOST_CHECK_EQUAL(array->getDetector(), "TST");
+
+  h1.Fill(5);
+  array.reset(objectsManager.getNonOwningArrayOfUpdatedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+  BOOST_CHECK(array->FindObject("content") != nullptr);
+  BOOST_CHECK(array->FindObject("histo1") != nullptr);
+
+  // two identical consecutive deltas separated by a reset must both be published
+  h1.Reset();
+  h1.Fill(5);
+  array.reset(objectsManager.getNonOwningArrayOfUpdatedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+  BOOST_CHECK(array->FindObject("histo1") != nullptr);
+
+  // a histogram which was not filled since the reset is not published
+  h1.Reset();
+  array.reset(objectsManager.getNonOwningArrayOfUpdatedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  BOOST_CHECK(array->FindObject("histo1") == nullptr);
+
+  array.reset(objectsManager.getNonOwningArrayOfUpdatedObjects(true));
+  BOOST_CHECK_EQUAL(array->GetEntries(), 3);
+
+  // deleting the array does not delete the objects
+  array.reset();
+  BOOST_CHECK_NO_THROW(objectsManager.getMonitorObject("histo1"));
+}
+
 } // namespace o2::quality_control::core
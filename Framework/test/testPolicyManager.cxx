@@ -356,3 +356,28 @@ TEST_CASE("test_errors")
   CHECK(updatePolicyManager.isReady("actor2") == false);
   updatePolicyManager.updateGlobalRevision();
 }
+
+TEST_CASE("test_policy_final_slash_and_redefinition")
+{
+  UpdatePolicyManager updatePolicyManager;
+
+  // objects received before the policy is added are taken into account
+  updatePolicyManager.updateObjectRevision("object1");
+  updatePolicyManager.addPolicy("actor1", UpdatePolicyType::OnAll, { "object1", "object2/", "object1" }, false, false);
+  CHECK(updatePolicyManager.isReady("actor1") == false);
+  updatePolicyManager.updateObjectRevision("object2");
+  CHECK(updatePolicyManager.isReady("actor1") == true);
+  updatePolicyManager.updateActorRevision("actor1");
+  updatePolicyManager.updateGlobalRevision();
+  CHECK(updatePolicyManager.isReady("actor1") == false);
+
+  // redefining the policy of an actor replaces its inputs
+  updatePolicyManager.addPolicy("actor1", UpdatePolicyType::OnAny, { "object3" }, false, false);
+  updatePolicyManager.updateObjectRevision("object1");
+  CHECK(updatePolicyManager.isReady("actor1") == false);
+  updatePolicyManager.updateObjectRevision("object3");
+  CHECK(updatePolicyManager.isReady("actor1") == true);
+
+  updatePolicyManager.reset();
+  CHECK_THROWS_AS(updatePolicyManager.isReady("actor1"), ObjectNotFoundError);
+}
@@ -0,0 +1,116 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testResolvedCustomParameters.cxx
+///
+
+#include "QualityControl/ResolvedCustomParameters.h"
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::core;
+using Type = ResolvedCustomParameters::Type;
+
+TEST_CASE("test_resolved_precedence")
+{
+  CustomParameters cp;
+  cp.set("key", "default");
+  cp.set("key", "beam", "default", "PROTON-PROTON");
+  cp.set("key", "run", "PHYSICS");
+  cp.set("key", "run_beam", "PHYSICS", "PROTON-PROTON");
+  cp.set("onlyDefault", "1");
+  cp.set("onlyOtherRun", "1", "COSMICS");
+
+  // same answers as atOptional for all the combinations
+  for (const auto& [runType, beamType] : std::vector<std::pair<std::string, std::string>>{
+         { "PHYSICS", "PROTON-PROTON" }, { "PHYSICS", "Pb-Pb" }, { "TECHNICAL", "PROTON-PROTON" }, { "TECHNICAL", "Pb-Pb" } }) {
+    ResolvedCustomParameters resolved(cp, runType, beamType);
+    CHECK(resolved.get<std::string>("key") == cp.atOptional("key", runType, beamType));
+    CHECK(resolved.contains("onlyDefault"));
+    CHECK_FALSE(resolved.contains("onlyOtherRun"));
+    CHECK(resolved.size() == 2);
+  }
+
+  Activity activity;
+  activity.mType = "COSMICS";
+  activity.mBeamType = "";
+  ResolvedCustomParameters resolved(cp, activity);
+  CHECK(resolved.get<std::string>("key", "") == "default");
+  CHECK(resolved.get<int>("onlyOtherRun", 0) == 1);
+  CHECK(resolved.getRunType() == "COSMICS");
+}
+
+TEST_CASE("test_resolved_types")
+{
+  CustomParameters cp;
+  cp.set("int", " 42 ");
+  cp.set("negative", "-3");
+  cp.set("double", "1.5e2");
+  cp.set("bool", "True");
+  cp.set("text", "hello");
+  cp.set("ints", "1, 2,3");
+  cp.set("doubles", "0.5,1,2.5");
+  cp.set("strings", "a, b ,c");
+  cp.set("empty", "");
+
+  ResolvedCustomParameters resolved(cp, "default", "default");
+  CHECK(resolved.get<int>("int") == 42);
+  CHECK(resolved.get<unsigned int>("int") == 42u);
+  CHECK(resolved.get<double>("int") == 42.0);
+  CHECK(resolved.get<long>("negative") == -3);
+  CHECK(resolved.get<double>("double") == 150.0);
+  CHECK(resolved.get<float>("double") == 150.0f);
+  CHECK_FALSE(resolved.get<int>("double").has_value());
+  CHECK(resolved.get<bool>("bool") == true);
+  CHECK(resolved.get<bool>("int", false) == false); // 42 is not a boolean
+  CHECK(resolved.get<std::string>("text") == "hello");
+  CHECK_FALSE(resolved.get<int>("text").has_value());
+  CHECK(resolved.get<int>("text", 7) == 7);
+  CHECK(resolved.get<int>("missing", 7) == 7);
+
+  CHECK(resolved.get<std::vector<int>>("ints") == std::vector<int>{ 1, 2, 3 });
+  CHECK(resolved.get<std::vector<double>>("ints") == std::vector<double>{ 1, 2, 3 });
+  CHECK_FALSE(resolved.get<std::vector<int>>("doubles").has_value());
+  CHECK(resolved.get<std::vector<double>>("doubles") == std::vector<double>{ 0.5, 1, 2.5 });
+  CHECK(resolved.get<std::vector<std::string>>("strings") == std::vector<std::string>{ "a", "b", "c" });
+  CHECK_FALSE(resolved.get<std::vector<float>>("strings").has_value());
+  CHECK(resolved.get<std::vector<int>>("empty") == std::vector<int>{});
+  CHECK_FALSE(resolved.get<int>("empty").has_value());
+}
+
+TEST_CASE("test_resolved_validation")
+{
+  CustomParameters cp;
+  cp.set("threshold", "abc");
+  cp.set("enabled", "yes");
+  cp.set("channels", "1,2,x");
+  cp.set("name", "anything");
+  cp.set("treshold", "0.5");
+  cp.set("nBins", "100", "PHYSICS");
+
+  ResolvedCustomParameters resolved(cp, "default", "default");
+  const std::vector<ResolvedCustomParameters::Expected> expected{
+    { "threshold", Type::Double }, { "enabled", Type::Bool }, { "channels", Type::IntegerList }, { "name", Type::String }, { "nBins", Type::Integer }
+  };
+  auto report = resolved.validate(expected);
+  CHECK_FALSE(report.empty());
+  CHECK(report.unknownKeys == std::vector<std::string>{ "treshold" });
+  CHECK(report.malformedKeys.size() == 3);
+
+  CustomParameters fixed;
+  fixed.set("threshold", "0.1");
+  fixed.set("enabled", "false");
+  fixed.set("channels", "1,2,3");
+  fixed.set("nBins", "100", "PHYSICS");
+  fixed.set("treshold", "0.5", "COSMICS"); // not resolved for PHYSICS
+  report = ResolvedCustomParameters(fixed, "PHYSICS", "default").validate(expected);
+  CHECK(report.empty());
+}
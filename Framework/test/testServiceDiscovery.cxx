@@ -0,0 +1,176 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testServiceDiscovery.cxx
+///
+
+#include "QualityControl/ServiceDiscovery.h"
+#include <catch_amalgamated.hpp>
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace o2::quality_control::core;
+using boost::asio::ip::tcp;
+
+namespace
+{
+
+// Minimal HTTP server standing for the Consul agent, it accepts all the requests and records their paths.
+class ConsulStub
+{
+ public:
+  ConsulStub() : mAcceptor(mIoContext, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0))
+  {
+    mThread = std::thread([this]() { serve(); });
+  }
+
+  ~ConsulStub()
+  {
+    mRunning = false;
+    // wake up the blocking accept
+    tcp::socket socket(mIoContext);
+    boost::system::error_code ec;
+    socket.connect(mAcceptor.local_endpoint(), ec);
+    mThread.join();
+  }
+
+  std::string url() const
+  {
+    return "http://127.0.0.1:" + std::to_string(mAcceptor.local_endpoint().port());
+  }
+
+  size_t count(const std::string& pathPrefix)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t n = 0;
+    for (const auto& path : mPaths) {
+      n += path.rfind(pathPrefix, 0) == 0;
+    }
+    return n;
+  }
+
+ private:
+  void serve()
+  {
+    while (mRunning) {
+      tcp::socket socket(mIoContext);
+      boost::system::error_code ec;
+      mAcceptor.accept(socket, ec);
+      if (!mRunning || ec) {
+        continue;
+      }
+      boost::asio::streambuf buffer;
+      auto headerLength = boost::asio::read_until(socket, buffer, "\r\n\r\n", ec);
+      if (ec) {
+        continue;
+      }
+      std::string header(boost::asio::buffers_begin(buffer.data()), boost::asio::buffers_begin(buffer.data()) + headerLength);
+      size_t contentLength = 0;
+      if (auto pos = header.find("Content-Length: "); pos != std::string::npos) {
+        contentLength = std::stoul(header.substr(pos + 16));
+      }
+      if (buffer.size() - headerLength < contentLength) {
+        boost::asio::read(socket, buffer, boost::asio::transfer_exactly(contentLength - (buffer.size() - headerLength)), ec);
+      }
+      const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+      boost::asio::write(socket, boost::asio::buffer(response), ec);
+
+      auto pathStart = header.find(' ') + 1;
+      std::lock_guard<std::mutex> lock(mMutex);
+      mPaths.push_back(header.substr(pathStart, header.find(' ', pathStart) - pathStart));
+    }
+  }
+
+  boost::asio::io_context mIoContext;
+  tcp::acceptor mAcceptor;
+  std::thread mThread;
+  std::atomic<bool> mRunning = true;
+  std::mutex mMutex;
+  std::vector<std::string> mPaths;
+};
+
+// the registrations are processed by the health check thread, once per second
+bool waitFor(const std::function<bool()>& condition)
+{
+  for (int i = 0; i < 100; i++) {
+    if (condition()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  return condition();
+}
+
+} // namespace
+
+TEST_CASE("service_discovery_hash")
+{
+  CHECK(ServiceDiscovery::hashObjects("a,b,c") == ServiceDiscovery::hashObjects("c,a,b"));
+  CHECK(ServiceDiscovery::hashObjects("a,b") != ServiceDiscovery::hashObjects("a,c"));
+  CHECK(ServiceDiscovery::hashObjects("") != ServiceDiscovery::hashObjects("a"));
+}
+
+TEST_CASE("service_discovery_async_registration")
+{
+  ConsulStub consul;
+  {
+    ServiceDiscovery serviceDiscovery(consul.url(), "test", "test_id", "127.0.0.1");
+    // the constructor registers synchronously
+    CHECK(serviceDiscovery.getStatistics().registrations == 1);
+    CHECK(consul.count("/v1/agent/service/register") == 1);
+
+    serviceDiscovery.registerAsync("qc/TST/MO/a,qc/TST/MO/b");
+    REQUIRE(waitFor([&]() { return serviceDiscovery.getStatistics().registrations == 2; }));
+
+    // same objects in another order, nothing is sent
+    serviceDiscovery.registerAsync("qc/TST/MO/b,qc/TST/MO/a");
+    REQUIRE(waitFor([&]() { return serviceDiscovery.getStatistics().unchanged == 1; }));
+    CHECK(serviceDiscovery.getStatistics().registrations == 2);
+
+    // successive lists replace each other until they are sent, the latest one is always registered
+    for (int i = 0; i < 10; i++) {
+      serviceDiscovery.registerAsync("qc/TST/MO/c" + std::to_string(i));
+    }
+    REQUIRE(waitFor([&]() { return serviceDiscovery.getStatistics().registrations >= 3; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    auto statistics = serviceDiscovery.getStatistics();
+    CHECK(statistics.registrations <= 4);
+    CHECK(statistics.failures == 0);
+    CHECK(statistics.maxLatency >= statistics.lastLatency);
+    CHECK(consul.count("/v1/agent/service/register") == statistics.registrations);
+  }
+  CHECK(waitFor([&]() { return consul.count("/v1/agent/service/deregister/test_id") == 1; }));
+}
+
+TEST_CASE("service_discovery_failures")
+{
+  std::string url;
+  {
+    // a port which was free a moment ago, nobody listens there
+    boost::asio::io_context ioContext;
+    tcp::acceptor acceptor(ioContext, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    url = "http://127.0.0.1:" + std::to_string(acceptor.local_endpoint().port());
+  }
+  ServiceDiscovery serviceDiscovery(url, "test", "test_id", "127.0.0.1");
+  CHECK(serviceDiscovery.getStatistics().failures == 1);
+
+  serviceDiscovery.registerAsync("qc/TST/MO/a");
+  // the failed registration is retried until it succeeds or a newer list replaces it
+  REQUIRE(waitFor([&]() { return serviceDiscovery.getStatistics().failures >= 3; }));
+  CHECK(serviceDiscovery.getStatistics().registrations == 0);
+}
@@ -17,6 +17,8 @@
 #include "getTestDataDirectory.h"
 #include "QualityControl/TaskRunnerFactory.h"
 #include "QualityControl/TaskRunner.h"
+#include "QualityControl/ObjectsManager.h"
+#include "QualityControl/MonitorObjectCollection.h"
 #include <Framework/DataSpecUtils.h>
 #include <DataSampling/DataSampling.h>
 #include "QualityControl/InfrastructureSpecReader.h"
@@ -26,6 +28,7 @@
 #include <Framework/ConfigParamRegistry.h>
 #include <Framework/ConfigParamStore.h>
 #include <Common/Exceptions.h>
+#include <TH1F.h>
 
 #define BOOST_TEST_MODULE TaskRunner test
 #define BOOST_TEST_MAIN
@@ -55,6 +58,43 @@ TaskRunnerConfig getTaskConfig(const std::string& configFilePath, const std::str
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_factory_publish_updated_objects_only)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+  auto config = ConfigurationFactory::getConfiguration(configFilePath);
+  auto infrastructureSpec = InfrastructureSpecReader::readInfrastructureSpec(config->getRecursive(), WorkflowType::Standalone);
+  auto taskSpec = *std::find_if(infrastructureSpec.tasks.begin(), infrastructureSpec.tasks.end(), [](const auto& taskSpec) {
+    return taskSpec.taskName == "abcTask";
+  });
+  taskSpec.publishUpdatedObjectsOnly = true;
+  taskSpec.mergingMode = "delta";
+
+  // without Mergers, the objects are reset only every resetAfterCycles, thus empty histograms have to be published
+  taskSpec.resetAfterCycles = 3;
+  auto taskConfig = TaskRunnerFactory::extractConfig(infrastructureSpec.common, taskSpec, 0, taskSpec.resetAfterCycles);
+  BOOST_CHECK_EQUAL(taskConfig.resetAfterCycles, 3);
+  BOOST_CHECK(!taskConfig.publishUpdatedObjectsOnly);
+
+  taskSpec.resetAfterCycles = 0;
+  taskConfig = TaskRunnerFactory::extractConfig(infrastructureSpec.common, taskSpec, 0, taskSpec.resetAfterCycles);
+  BOOST_CHECK(!taskConfig.publishUpdatedObjectsOnly);
+
+  taskSpec.resetAfterCycles = 1;
+  taskConfig = TaskRunnerFactory::extractConfig(infrastructureSpec.common, taskSpec, 0, taskSpec.resetAfterCycles);
+  BOOST_CHECK(taskConfig.publishUpdatedObjectsOnly);
+
+  // with Mergers in the delta mode, the task is reset after each cycle regardless of resetAfterCycles
+  taskSpec.resetAfterCycles = 3;
+  taskConfig = TaskRunnerFactory::extractConfig(infrastructureSpec.common, taskSpec, 1, TaskRunnerFactory::computeResetAfterCycles(taskSpec, true));
+  BOOST_CHECK_EQUAL(taskConfig.resetAfterCycles, 1);
+  BOOST_CHECK(taskConfig.publishUpdatedObjectsOnly);
+
+  taskSpec.mergingMode = "entire";
+  taskSpec.resetAfterCycles = 1;
+  taskConfig = TaskRunnerFactory::extractConfig(infrastructureSpec.common, taskSpec, 1, TaskRunnerFactory::computeResetAfterCycles(taskSpec, true));
+  BOOST_CHECK(!taskConfig.publishUpdatedObjectsOnly);
+}
+
 BOOST_AUTO_TEST_CASE(test_factory)
 {
   std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
@@ -119,6 +159,30 @@ BOOST_AUTO_TEST_CASE(test_task_runner)
   qcTask.init(initContext);
 }
 
+BOOST_AUTO_TEST_CASE(test_task_runner_publication)
+{
+  TaskRunnerConfig config;
+  TH1F filled("filled", "filled", 10, 0, 10);
+  TH1F empty("empty", "empty", 10, 0, 10);
+  ObjectsManager objectsManager(config.taskName, config.className, config.detectorName, config.consulUrl, 0, true);
+  filled.Fill(1);
+  objectsManager.startPublishing(&filled);
+  objectsManager.startPublishing(&empty);
+
+  BOOST_CHECK_EQUAL(TaskRunner::getObjectsToPublish(objectsManager, config, 1)->GetEntries(), 2);
+
+  config.publishUpdatedObjectsOnly = true;
+  config.fullPublicationCycles = 3;
+  BOOST_CHECK_EQUAL(TaskRunner::getObjectsToPublish(objectsManager, config, 0)->GetEntries(), 2);
+  BOOST_CHECK_EQUAL(TaskRunner::getObjectsToPublish(objectsManager, config, 1)->GetEntries(), 1);
+  BOOST_CHECK_EQUAL(TaskRunner::getObjectsToPublish(objectsManager, config, 3)->GetEntries(), 2);
+
+  BOOST_CHECK(!TaskRunner::isResetNeeded(config, 1));
+  config.resetAfterCycles = 2;
+  BOOST_CHECK(!TaskRunner::isResetNeeded(config, 1));
+  BOOST_CHECK(TaskRunner::isResetNeeded(config, 2));
+}
+
 BOOST_AUTO_TEST_CASE(test_task_wrong_detector_name)
 {
   std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
@@ -250,4 +250,34 @@ TEST_CASE("test_trending_task")
   REQUIRE(tree->GetEntries() == 2);
   objectManager->stopPublishing(PublicationPolicy::Once);
   objectManager->stopPublishing(PublicationPolicy::ThroughStop);
+
+  // test storing the trend in chunks, only the current one is published
+  config.put("qc.postprocessing." + trendingTaskID + ".trendChunks", "100sec");
+  {
+    auto chunkObjectManager = std::make_shared<ObjectsManager>(taskName, "o2::quality_control::postprocessing::TrendingTask", "TST", "");
+    TrendingTask chunkedTask;
+    chunkedTask.setName(trendingTaskName);
+    chunkedTask.setID(trendingTaskID);
+    chunkedTask.setObjectsManager(chunkObjectManager);
+    REQUIRE_NOTHROW(chunkedTask.configure(config));
+
+    REQUIRE_NOTHROW(chunkedTask.initialize({ TriggerType::UserOrControl, true, { 0, "NONE", "", "", "qc" }, 1 }, services));
+    REQUIRE(chunkObjectManager->getNumberPublishedObjects() == 1);
+    auto chunkMO = chunkObjectManager->getMonitorObject(trendingTaskName + "_chunk");
+    REQUIRE(chunkMO != nullptr);
+    TTree* chunk = dynamic_cast<TTree*>(chunkMO->getObject());
+    REQUIRE(chunk != nullptr);
+
+    chunkedTask.update({ TriggerType::NewObject, false, { 0, "NONE", "", "", "qc", { 2, 100000 } }, 100000 - 1 }, services);
+    CHECK(chunk->GetEntries() == 1);
+    CHECK(chunkMO->getMetadataMap().at("trendChunk") == "time_100");
+    chunkObjectManager->stopPublishing(PublicationPolicy::Once);
+
+    chunkedTask.update({ TriggerType::NewObject, false, { 0, "NONE", "", "", "qc", { 100000, 200000 } }, 200000 - 1 }, services);
+    CHECK(chunk->GetEntries() == 1);
+    CHECK(chunkMO->getMetadataMap().at("trendChunk") == "time_200");
+    REQUIRE(chunkObjectManager->getNumberPublishedObjects() == 3);
+    chunkObjectManager->stopPublishing(PublicationPolicy::Once);
+    chunkObjectManager->stopPublishing(PublicationPolicy::ThroughStop);
+  }
 }
@@ -28,6 +28,7 @@
 #include <CCDB/CcdbApi.h>
 #include <boost/test/unit_test.hpp>
 #include <TH1F.h>
+#include <TObjString.h>
 #include <cstdlib>
 #include <chrono>
 using namespace std::chrono;
@@ -132,6 +133,46 @@ BOOST_AUTO_TEST_CASE(test_trigger_new_object)
   directDBAPI->truncate(fullObjectPath);
 }
 
+BOOST_AUTO_TEST_CASE(test_trigger_new_object_publication_marker)
+{
+  const std::string pid = std::to_string(getpid());
+  const std::string detectorCode = "TST";
+  const std::string taskName = "testTriggersPublicationMarker" + pid;
+  const std::string objectName = "test_object";
+
+  TH1I* obj = new TH1I(objectName.c_str(), objectName.c_str(), 10, 0, 10.0);
+  std::shared_ptr<MonitorObject> mo = std::make_shared<MonitorObject>(obj, taskName, "TestClass", detectorCode);
+  std::shared_ptr<MonitorObject> marker = std::make_shared<MonitorObject>(new TObjString(RepoPathUtils::publicationMarkerName), taskName, "TestClass", detectorCode);
+  auto newObjectTrigger = triggers::NewObject(CCDB_ENDPOINT, "qcdb", RepoPathUtils::getMoPath(mo.get(), false));
+
+  auto directDBAPI = std::make_shared<o2::ccdb::CcdbApi>();
+  directDBAPI->init(CCDB_ENDPOINT);
+  BOOST_REQUIRE(directDBAPI->isHostReachable());
+  std::shared_ptr<DatabaseInterface> repository = DatabaseFactory::create("CCDB");
+  repository->connect(CCDB_ENDPOINT, "", "", "");
+
+  // the first marker tells the trigger that the markers are in use
+  validity_time_t currentTimestamp = CcdbDatabase::getCurrentTimestamp();
+  marker->setValidity({ currentTimestamp, gInvalidValidityInterval.getMax() });
+  repository->storeMO(marker);
+
+  // the object alone is not enough
+  currentTimestamp = CcdbDatabase::getCurrentTimestamp();
+  mo->setValidity({ currentTimestamp, gInvalidValidityInterval.getMax() });
+  repository->storeMO(mo);
+  BOOST_CHECK_EQUAL(newObjectTrigger(), TriggerType::No);
+  BOOST_CHECK_EQUAL(newObjectTrigger(), TriggerType::No);
+
+  // once the marker follows, the trigger fires for the object
+  marker->setValidity({ currentTimestamp, gInvalidValidityInterval.getMax() });
+  repository->storeMO(marker);
+  BOOST_CHECK_EQUAL(newObjectTrigger(), Trigger(TriggerType::NewObject, currentTimestamp));
+  BOOST_CHECK_EQUAL(newObjectTrigger(), TriggerType::No);
+
+  directDBAPI->truncate(RepoPathUtils::getMoPath(mo.get(), true));
+  directDBAPI->truncate(RepoPathUtils::getMoPath(marker.get(), true));
+}
+
 BOOST_AUTO_TEST_CASE(test_trigger_for_each_object)
 {
   // Setup and initialise objects
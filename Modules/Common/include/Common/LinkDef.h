@@ -5,10 +5,15 @@
 
 #pragma link C++ class o2::quality_control_modules::common::NonEmpty + ;
 #pragma link C++ class o2::quality_control_modules::common::MeanIsAbove + ;
-#pragma link C++ class o2::quality_control_modules::common::TH1Ratio < TH1F> + ;
-#pragma link C++ class o2::quality_control_modules::common::TH1Ratio < TH1D> + ;
-#pragma link C++ class o2::quality_control_modules::common::TH2Ratio < TH2F> + ;
-#pragma link C++ class o2::quality_control_modules::common::TH2Ratio < TH2D> + ;
+#pragma link C++ class o2::quality_control_modules::common::TH1Ratio < TH1F> - ;
+#pragma link C++ class o2::quality_control_modules::common::TH1Ratio < TH1D> - ;
+#pragma link C++ class o2::quality_control_modules::common::TH2Ratio < TH2F> - ;
+#pragma link C++ class o2::quality_control_modules::common::TH2Ratio < TH2D> - ;
+#pragma link C++ class o2::quality_control_modules::common::TH2Accumulator + ;
+#pragma link C++ class o2::quality_control_modules::common::TH2FMeanVariance - ;
+#pragma link C++ class o2::quality_control_modules::common::TH2FFraction - ;
+#pragma link C++ class o2::quality_control_modules::common::TH2FBitmask - ;
+#pragma link C++ class o2::quality_control_modules::common::TH2FMinMax - ;
 #pragma link C++ class o2::quality_control_modules::common::TH1Reductor + ;
 #pragma link C++ class o2::quality_control_modules::common::TH2Reductor + ;
 #pragma link C++ class o2::quality_control_modules::common::THnSparse5Reductor + ;
@@ -207,7 +207,7 @@ void TH1Ratio<T>::merge(MergeInterface* const other)
 
   mHistoNum->Add(dynamic_cast<const TH1Ratio* const>(other)->getNum());
   mHistoDen->Add(dynamic_cast<const TH1Ratio* const>(other)->getDen());
-  update();
+  mRatioOutdated = true;
 }
 
 template<class T>
@@ -216,6 +216,7 @@ void TH1Ratio<T>::update()
   if (!mHistoNum || !mHistoDen) {
     return;
   }
+  mRatioOutdated = false;
 
   T::Reset();
   if (mHistoNum->GetXaxis()->IsVariableBinSize()) {
@@ -375,4 +376,27 @@ void TH1Ratio<T>::Sumw2(Bool_t flag)
   }
 }
 
+template<class T>
+void TH1Ratio<T>::Paint(Option_t* option)
+{
+  if (mRatioOutdated) {
+    update();
+  }
+  T::Paint(option);
+}
+
+template<class T>
+void TH1Ratio<T>::Streamer(TBuffer& buffer)
+{
+  // the ratio is computed only when needed, i.e. once before being sent or stored, and not after each merge
+  if (buffer.IsReading()) {
+    buffer.ReadClassBuffer(TH1Ratio<T>::Class(), this);
+  } else {
+    if (mRatioOutdated) {
+      update();
+    }
+    buffer.WriteClassBuffer(TH1Ratio<T>::Class(), this);
+  }
+}
+
 } // namespace o2::quality_control_modules::common
@@ -0,0 +1,349 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TH2Accumulators.h
+/// \brief 2D histograms which accumulate per-bin statistics (mean and variance, fraction, bit mask, minimum and
+///        maximum) and which can be merged exactly.
+///
+/// The statistics are kept in contiguous arrays, one element per bin without the under- and overflows, so that
+/// merging two objects is a loop over these arrays which the compiler vectorizes. The TH2F bin contents are only
+/// computed from the statistics when the object is serialized or painted, or when update() is called.
+///
+
+#ifndef QUALITYCONTROL_TH2ACCUMULATORS_H
+#define QUALITYCONTROL_TH2ACCUMULATORS_H
+
+#include "Mergers/MergeInterface.h"
+#include <TH2F.h>
+#include <Rtypes.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class TBuffer;
+
+namespace o2::quality_control_modules::common
+{
+
+/// Element-wise merge kernels, written as plain loops over contiguous arrays so that they are vectorized
+namespace accumulator_kernels
+{
+
+template <typename T>
+inline void add(T* destination, const T* source, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    destination[i] += source[i];
+  }
+}
+
+// Merges the counts, means and sums of squared deviations from the mean (M2) of two sets of values,
+// with the pairwise formula of Chan et al., which does not lose precision when the values have a large offset.
+template <typename T>
+inline void mergeMoments(T* count, T* mean, T* m2, const T* otherCount, const T* otherMean, const T* otherM2, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    const T n = count[i] + otherCount[i];
+    const T delta = otherMean[i] - mean[i];
+    // the counts are both 0 if n is 0, the divisor only avoids a branch
+    const T otherFraction = otherCount[i] / (n > 0 ? n : T(1));
+    mean[i] += delta * otherFraction;
+    m2[i] += otherM2[i] + delta * delta * count[i] * otherFraction;
+    count[i] = n;
+  }
+}
+
+template <typename T>
+inline void bitwiseOr(T* destination, const T* source, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    destination[i] |= source[i];
+  }
+}
+
+template <typename T>
+inline void minimum(T* destination, const T* source, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    destination[i] = source[i] < destination[i] ? source[i] : destination[i];
+  }
+}
+
+template <typename T>
+inline void maximum(T* destination, const T* source, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    destination[i] = source[i] > destination[i] ? source[i] : destination[i];
+  }
+}
+
+} // namespace accumulator_kernels
+
+/// \brief Common part of the TH2 accumulators: binning, merging, lazy computation of the bin contents.
+///
+/// Fill(x, y, w) passes w as the value to accumulate in the bin of (x, y), the under- and overflows are ignored.
+/// SetBins() discards the accumulated statistics, since they cannot be redistributed over other bins, while
+/// RebinX(), RebinY() and Rebin2D() are not supported and return nullptr. The TH2F operations on the bin contents,
+/// such as Add(), Scale() or SetBinContent(), do not modify the statistics, thus their effect is lost at the next update().
+class TH2Accumulator : public TH2F, public o2::mergers::MergeInterface
+{
+ public:
+  TH2Accumulator() = default;
+  TH2Accumulator(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax);
+  ~TH2Accumulator() override = default;
+
+  void merge(MergeInterface* const other) override;
+
+  /// \brief Computes the bin contents from the accumulated statistics.
+  ///
+  /// Filling and merging only update the statistics and mark the bin contents as outdated. They are updated when
+  /// the object is serialized or painted, while the code reading the bin contents directly in the same process
+  /// should call update() first.
+  void update();
+  bool isOutdated() const { return mOutdated; }
+
+  using TH2F::Fill;
+  Int_t Fill(Double_t x, Double_t y) override;
+  Int_t Fill(Double_t x, Double_t y, Double_t w) override;
+  void Reset(Option_t* option = "") override;
+  void Copy(TObject& obj) const override;
+  void Paint(Option_t* option = "") override;
+
+  using TH2F::SetBins;
+  /// Changes the binning and resets the object
+  void SetBins(Int_t nx, Double_t xmin, Double_t xmax, Int_t ny, Double_t ymin, Double_t ymax) override;
+  /// Changes the binning and resets the object
+  void SetBins(Int_t nx, const Double_t* xBins, Int_t ny, const Double_t* yBins) override;
+  /// Not supported, since the statistics of several bins cannot be combined into the ones of a bin.
+  /// RebinX() and RebinY() of TH2 call it as well.
+  TH2* Rebin2D(Int_t nxgroup = 2, Int_t nygroup = 2, const char* newname = "") override;
+
+ protected:
+  /// Index in the statistics arrays of the bin containing (x, y), or -1 if it is an under- or overflow
+  int cellIndex(double x, double y) const;
+  /// Index in the statistics arrays of the bin (binx, biny), numbered as in TH2 (from 1)
+  size_t cellOfBin(int binx, int biny) const { return static_cast<size_t>(biny - 1) * GetNbinsX() + (binx - 1); }
+  size_t numberOfCells() const { return static_cast<size_t>(GetNbinsX()) * GetNbinsY(); }
+  void setOutdated() { mOutdated = true; }
+
+  /// Reads the object or writes it after updating the bin contents, to be called by the Streamer of each accumulator
+  void streamLazily(TBuffer& buffer, TClass* cl, void* object);
+
+  virtual void accumulate(size_t cell, double value) = 0;
+  /// Merges the statistics of an object of the same class, returns false if the binnings differ
+  virtual bool mergeCells(const TH2Accumulator& other) = 0;
+  virtual void resetCells() = 0;
+  virtual void copyCells(TH2Accumulator& destination) const = 0;
+  /// Sets the content (and the error if relevant) of the given bin from the statistics of the cell
+  virtual void materialize(int bin, size_t cell) = 0;
+
+ private:
+  bool mOutdated{ false }; //! the statistics changed since the last update()
+  std::string mTreatMeAs{ "TH2F" };
+
+  ClassDefOverride(TH2Accumulator, 1);
+};
+
+/// \brief Per-bin count, mean and sum of squared deviations from the mean of the filled values, displays their mean
+/// (with its error) or their standard deviation. As opposed to averaging the means weighted by the entries, the merged
+/// mean and variance are the ones of all the values. They are updated with Welford's algorithm and merged with
+/// the formula of Chan et al., so they stay precise for values with a large offset compared to their spread.
+class TH2FMeanVariance : public TH2Accumulator
+{
+ public:
+  enum class Display : int {
+    Mean,  // mean of the values, with the standard error on the mean as error
+    StdDev // standard deviation of the values
+  };
+
+  TH2FMeanVariance() = default;
+  TH2FMeanVariance(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Display display = Display::Mean);
+  ~TH2FMeanVariance() override = default;
+
+  void fill(double x, double y, double value)
+  {
+    if (auto cell = cellIndex(x, y); cell >= 0) {
+      TH2FMeanVariance::accumulate(cell, value);
+    }
+  }
+
+  void setDisplay(Display display)
+  {
+    mDisplay = static_cast<int>(display);
+    setOutdated();
+  }
+  Display getDisplay() const { return static_cast<Display>(mDisplay); }
+
+  double getCount(int binx, int biny) const { return mCount[cellOfBin(binx, biny)]; }
+  double getMean(int binx, int biny) const;
+  double getVariance(int binx, int biny) const;
+
+ protected:
+  void accumulate(size_t cell, double value) override
+  {
+    mCount[cell] += 1;
+    const double delta = value - mMean[cell];
+    mMean[cell] += delta / mCount[cell];
+    mM2[cell] += delta * (value - mMean[cell]);
+    fEntries++;
+    setOutdated();
+  }
+  bool mergeCells(const TH2Accumulator& other) override;
+  void resetCells() override;
+  void copyCells(TH2Accumulator& destination) const override;
+  void materialize(int bin, size_t cell) override;
+
+ private:
+  std::vector<double> mCount;
+  std::vector<double> mMean;
+  std::vector<double> mM2; // sum of squared deviations from the mean
+  int mDisplay{ static_cast<int>(Display::Mean) };
+
+  ClassDefOverride(TH2FMeanVariance, 2);
+};
+
+/// \brief Per-bin number of passed and total trials, displays the fraction of passed trials with its binomial error.
+class TH2FFraction : public TH2Accumulator
+{
+ public:
+  TH2FFraction() = default;
+  TH2FFraction(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax);
+  ~TH2FFraction() override = default;
+
+  void fill(double x, double y, bool passed)
+  {
+    if (auto cell = cellIndex(x, y); cell >= 0) {
+      TH2FFraction::accumulate(cell, passed ? 1.0 : 0.0);
+    }
+  }
+
+  double getPassed(int binx, int biny) const { return mPassed[cellOfBin(binx, biny)]; }
+  double getTotal(int binx, int biny) const { return mTotal[cellOfBin(binx, biny)]; }
+
+ protected:
+  /// a non-zero value counts as passed
+  void accumulate(size_t cell, double value) override
+  {
+    mPassed[cell] += value != 0;
+    mTotal[cell] += 1;
+    fEntries++;
+    setOutdated();
+  }
+  bool mergeCells(const TH2Accumulator& other) override;
+  void resetCells() override;
+  void copyCells(TH2Accumulator& destination) const override;
+  void materialize(int bin, size_t cell) override;
+
+ private:
+  std::vector<double> mPassed;
+  std::vector<double> mTotal;
+
+  ClassDefOverride(TH2FFraction, 1);
+};
+
+/// \brief Per-bin bitwise OR of the filled values, e.g. the error types seen by each link.
+/// Fill(x, y, w) converts w to an integer, fill() takes the bits directly.
+class TH2FBitmask : public TH2Accumulator
+{
+ public:
+  TH2FBitmask() = default;
+  TH2FBitmask(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax);
+  ~TH2FBitmask() override = default;
+
+  void fill(double x, double y, uint64_t bits)
+  {
+    if (auto cell = cellIndex(x, y); cell >= 0) {
+      mMask[cell] |= bits;
+      fEntries++;
+      setOutdated();
+    }
+  }
+
+  uint64_t getMask(int binx, int biny) const { return mMask[cellOfBin(binx, biny)]; }
+
+ protected:
+  void accumulate(size_t cell, double value) override
+  {
+    mMask[cell] |= static_cast<uint64_t>(value);
+    fEntries++;
+    setOutdated();
+  }
+  bool mergeCells(const TH2Accumulator& other) override;
+  void resetCells() override;
+  void copyCells(TH2Accumulator& destination) const override;
+  void materialize(int bin, size_t cell) override;
+
+ private:
+  std::vector<ULong64_t> mMask;
+
+  ClassDefOverride(TH2FBitmask, 1);
+};
+
+/// \brief Per-bin minimum and maximum of the filled values, displays either of them or their difference.
+/// The bins without values are displayed as 0.
+class TH2FMinMax : public TH2Accumulator
+{
+ public:
+  enum class Display : int {
+    Min,
+    Max,
+    Range // maximum - minimum
+  };
+
+  TH2FMinMax() = default;
+  TH2FMinMax(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Display display = Display::Max);
+  ~TH2FMinMax() override = default;
+
+  void fill(double x, double y, double value)
+  {
+    if (auto cell = cellIndex(x, y); cell >= 0) {
+      TH2FMinMax::accumulate(cell, value);
+    }
+  }
+
+  void setDisplay(Display display)
+  {
+    mDisplay = static_cast<int>(display);
+    setOutdated();
+  }
+  Display getDisplay() const { return static_cast<Display>(mDisplay); }
+
+  /// true if at least one value was filled in the bin
+  bool hasValues(int binx, int biny) const;
+  double getMin(int binx, int biny) const { return mMin[cellOfBin(binx, biny)]; }
+  double getMax(int binx, int biny) const { return mMax[cellOfBin(binx, biny)]; }
+
+ protected:
+  void accumulate(size_t cell, double value) override
+  {
+    mMin[cell] = value < mMin[cell] ? value : mMin[cell];
+    mMax[cell] = value > mMax[cell] ? value : mMax[cell];
+    fEntries++;
+    setOutdated();
+  }
+  bool mergeCells(const TH2Accumulator& other) override;
+  void resetCells() override;
+  void copyCells(TH2Accumulator& destination) const override;
+  void materialize(int bin, size_t cell) override;
+
+ private:
+  std::vector<double> mMin; // +max() in the bins without values
+  std::vector<double> mMax; // lowest() in the bins without values
+  int mDisplay{ static_cast<int>(Display::Max) };
+
+  ClassDefOverride(TH2FMinMax, 1);
+};
+
+} // namespace o2::quality_control_modules::common
+
+#endif // QUALITYCONTROL_TH2ACCUMULATORS_H
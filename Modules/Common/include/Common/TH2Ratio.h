@@ -21,6 +21,7 @@
 #include <TH2F.h>
 #include <TH2D.h>
 #include <TDirectory.h>
+#include <TBuffer.h>
 
 namespace o2::quality_control_modules::common
 {
@@ -68,7 +69,14 @@ class TH2Ratio : public T, public o2::mergers::MergeInterface
   void setHasBinominalErrors(bool flag = true) { mBinominalErrors = flag; }
   bool hasBinominalErrors() const { return mBinominalErrors; }
 
+  /// \brief Computes the ratio from the numerator and the denominator.
+  ///
+  /// merge() only adds the numerators and denominators and marks the ratio as outdated, so that it is not
+  /// recomputed for each partial merge. An outdated ratio is updated when the object is serialized or painted,
+  /// while the code reading the ratio of a merged object directly in the same process should call update() first.
+  /// Add() updates the ratio immediately, as it did before.
   void update();
+  bool isRatioOutdated() const { return mRatioOutdated; }
 
   // functions inherited from TH2x
   void Reset(Option_t* option = "") override;
@@ -79,6 +87,7 @@ class TH2Ratio : public T, public o2::mergers::MergeInterface
   Bool_t Add(const TH1* h1, Double_t c1 = 1) override;
   void SetBins(Int_t nx, Double_t xmin, Double_t xmax, Int_t ny, Double_t ymin, Double_t ymax) override;
   void Sumw2(Bool_t flag = kTRUE) override;
+  void Paint(Option_t* option = "") override;
 
  private:
   T* mHistoNum{ nullptr };
@@ -86,6 +95,7 @@ class TH2Ratio : public T, public o2::mergers::MergeInterface
   bool mUniformScaling{ true };
   bool mBinominalErrors{ false };
   Bool_t mSumw2Enabled{ kTRUE };
+  bool mRatioOutdated{ false }; //! the numerator or the denominator changed since the last update()
   std::string mTreatMeAs{ T::Class_Name() };
 
   ClassDefOverride(TH2Ratio, 3);
@@ -266,7 +266,7 @@ void TH2Ratio<T>::merge(MergeInterface* const other)
 
   mHistoNum->Add(dynamic_cast<const TH2Ratio* const>(other)->getNum());
   mHistoDen->Add(dynamic_cast<const TH2Ratio* const>(other)->getDen());
-  update();
+  mRatioOutdated = true;
 }
 
 template<class T>
@@ -275,6 +275,7 @@ void TH2Ratio<T>::update()
   if (!mHistoNum || !mHistoDen) {
     return;
   }
+  mRatioOutdated = false;
 
   T::Reset();
   if (mHistoNum->GetXaxis()->IsVariableBinSize()) {
@@ -435,4 +436,27 @@ void TH2Ratio<T>::Sumw2(Bool_t flag)
   T::Sumw2(flag);
 }
 
+template<class T>
+void TH2Ratio<T>::Paint(Option_t* option)
+{
+  if (mRatioOutdated) {
+    update();
+  }
+  T::Paint(option);
+}
+
+template<class T>
+void TH2Ratio<T>::Streamer(TBuffer& buffer)
+{
+  // the ratio is computed only when needed, i.e. once before being sent or stored, and not after each merge
+  if (buffer.IsReading()) {
+    buffer.ReadClassBuffer(TH2Ratio<T>::Class(), this);
+  } else {
+    if (mRatioOutdated) {
+      update();
+    }
+    buffer.WriteClassBuffer(TH2Ratio<T>::Class(), this);
+  }
+}
+
 } // namespace o2::quality_control_modules::common
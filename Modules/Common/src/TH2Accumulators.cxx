@@ -0,0 +1,370 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TH2Accumulators.cxx
+///
+
+#include "Common/TH2Accumulators.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TBuffer.h>
+#include <TClass.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace o2::quality_control_modules::common
+{
+
+// TH2Accumulator
+
+TH2Accumulator::TH2Accumulator(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax)
+  : TH2F(name, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax),
+    o2::mergers::MergeInterface()
+{
+}
+
+int TH2Accumulator::cellIndex(double x, double y) const
+{
+  const int binx = fXaxis.FindFixBin(x);
+  const int biny = fYaxis.FindFixBin(y);
+  if (binx < 1 || binx > fXaxis.GetNbins() || biny < 1 || biny > fYaxis.GetNbins()) {
+    return -1;
+  }
+  return static_cast<int>(cellOfBin(binx, biny));
+}
+
+Int_t TH2Accumulator::Fill(Double_t x, Double_t y)
+{
+  return Fill(x, y, 1.0);
+}
+
+Int_t TH2Accumulator::Fill(Double_t x, Double_t y, Double_t w)
+{
+  const int cell = cellIndex(x, y);
+  if (cell < 0) {
+    return -1;
+  }
+  accumulate(cell, w);
+  return GetBin(fXaxis.FindFixBin(x), fYaxis.FindFixBin(y));
+}
+
+void TH2Accumulator::merge(MergeInterface* const other)
+{
+  auto otherAccumulator = dynamic_cast<const TH2Accumulator*>(other);
+  if (otherAccumulator == nullptr || otherAccumulator->IsA() != IsA()) {
+    ILOG(Warning, Devel) << "Cannot merge '" << GetName() << "' with an object of another class, ignoring it" << ENDM;
+    return;
+  }
+  if (!mergeCells(*otherAccumulator)) {
+    ILOG(Warning, Devel) << "Cannot merge '" << GetName() << "' with an object with another binning, ignoring it" << ENDM;
+    return;
+  }
+  fEntries += otherAccumulator->fEntries;
+  mOutdated = true;
+}
+
+void TH2Accumulator::update()
+{
+  mOutdated = false;
+  // SetBinContent increments the number of entries, which we want to keep as the number of filled values
+  const auto entries = fEntries;
+  for (int biny = 1; biny <= GetNbinsY(); biny++) {
+    for (int binx = 1; binx <= GetNbinsX(); binx++) {
+      materialize(GetBin(binx, biny), cellOfBin(binx, biny));
+    }
+  }
+  fEntries = entries;
+}
+
+void TH2Accumulator::Reset(Option_t* option)
+{
+  TH2F::Reset(option);
+  resetCells();
+  mOutdated = false;
+}
+
+void TH2Accumulator::SetBins(Int_t nx, Double_t xmin, Double_t xmax, Int_t ny, Double_t ymin, Double_t ymax)
+{
+  TH2F::SetBins(nx, xmin, xmax, ny, ymin, ymax);
+  // resizes the statistics arrays as well
+  Reset();
+}
+
+void TH2Accumulator::SetBins(Int_t nx, const Double_t* xBins, Int_t ny, const Double_t* yBins)
+{
+  TH2F::SetBins(nx, xBins, ny, yBins);
+  Reset();
+}
+
+TH2* TH2Accumulator::Rebin2D(Int_t, Int_t, const char*)
+{
+  ILOG(Error, Devel) << "Rebinning '" << GetName() << "' is not supported, since the accumulated statistics cannot be combined. "
+                     << "Use SetBins() before filling the object instead." << ENDM;
+  return nullptr;
+}
+
+void TH2Accumulator::Copy(TObject& obj) const
+{
+  TH2F::Copy(obj);
+  if (auto destination = dynamic_cast<TH2Accumulator*>(&obj); destination != nullptr && destination->IsA() == IsA()) {
+    copyCells(*destination);
+    destination->mOutdated = mOutdated;
+  }
+}
+
+void TH2Accumulator::Paint(Option_t* option)
+{
+  if (mOutdated) {
+    update();
+  }
+  TH2F::Paint(option);
+}
+
+void TH2Accumulator::streamLazily(TBuffer& buffer, TClass* cl, void* object)
+{
+  // the bin contents are computed only when needed, i.e. once before being sent or stored, and not after each merge
+  if (buffer.IsReading()) {
+    buffer.ReadClassBuffer(cl, object);
+  } else {
+    if (mOutdated) {
+      update();
+    }
+    buffer.WriteClassBuffer(cl, object);
+  }
+}
+
+// TH2FMeanVariance
+
+TH2FMeanVariance::TH2FMeanVariance(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Display display)
+  : TH2Accumulator(name, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax),
+    mDisplay(static_cast<int>(display))
+{
+  TH2FMeanVariance::resetCells();
+}
+
+double TH2FMeanVariance::getMean(int binx, int biny) const
+{
+  return mMean[cellOfBin(binx, biny)];
+}
+
+double TH2FMeanVariance::getVariance(int binx, int biny) const
+{
+  const auto cell = cellOfBin(binx, biny);
+  return mCount[cell] > 0 ? mM2[cell] / mCount[cell] : 0;
+}
+
+bool TH2FMeanVariance::mergeCells(const TH2Accumulator& other)
+{
+  const auto& otherMeanVariance = static_cast<const TH2FMeanVariance&>(other);
+  if (otherMeanVariance.mCount.size() != mCount.size()) {
+    return false;
+  }
+  accumulator_kernels::mergeMoments(mCount.data(), mMean.data(), mM2.data(),
+                                    otherMeanVariance.mCount.data(), otherMeanVariance.mMean.data(), otherMeanVariance.mM2.data(), mCount.size());
+  return true;
+}
+
+void TH2FMeanVariance::resetCells()
+{
+  mCount.assign(numberOfCells(), 0.0);
+  mMean.assign(numberOfCells(), 0.0);
+  mM2.assign(numberOfCells(), 0.0);
+}
+
+void TH2FMeanVariance::copyCells(TH2Accumulator& destination) const
+{
+  auto& destinationMeanVariance = static_cast<TH2FMeanVariance&>(destination);
+  destinationMeanVariance.mCount = mCount;
+  destinationMeanVariance.mMean = mMean;
+  destinationMeanVariance.mM2 = mM2;
+  destinationMeanVariance.mDisplay = mDisplay;
+}
+
+void TH2FMeanVariance::materialize(int bin, size_t cell)
+{
+  const double count = mCount[cell];
+  if (count <= 0) {
+    SetBinContent(bin, 0);
+    SetBinError(bin, 0);
+    return;
+  }
+  const double mean = mMean[cell];
+  const double variance = mM2[cell] / count;
+  if (getDisplay() == Display::Mean) {
+    SetBinContent(bin, mean);
+    SetBinError(bin, std::sqrt(variance / count));
+  } else {
+    SetBinContent(bin, std::sqrt(variance));
+    SetBinError(bin, 0);
+  }
+}
+
+void TH2FMeanVariance::Streamer(TBuffer& buffer)
+{
+  streamLazily(buffer, TH2FMeanVariance::Class(), this);
+}
+
+// TH2FFraction
+
+TH2FFraction::TH2FFraction(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax)
+  : TH2Accumulator(name, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax)
+{
+  TH2FFraction::resetCells();
+}
+
+bool TH2FFraction::mergeCells(const TH2Accumulator& other)
+{
+  const auto& otherFraction = static_cast<const TH2FFraction&>(other);
+  if (otherFraction.mTotal.size() != mTotal.size()) {
+    return false;
+  }
+  accumulator_kernels::add(mPassed.data(), otherFraction.mPassed.data(), mPassed.size());
+  accumulator_kernels::add(mTotal.data(), otherFraction.mTotal.data(), mTotal.size());
+  return true;
+}
+
+void TH2FFraction::resetCells()
+{
+  mPassed.assign(numberOfCells(), 0.0);
+  mTotal.assign(numberOfCells(), 0.0);
+}
+
+void TH2FFraction::copyCells(TH2Accumulator& destination) const
+{
+  auto& destinationFraction = static_cast<TH2FFraction&>(destination);
+  destinationFraction.mPassed = mPassed;
+  destinationFraction.mTotal = mTotal;
+}
+
+void TH2FFraction::materialize(int bin, size_t cell)
+{
+  const double total = mTotal[cell];
+  if (total <= 0) {
+    SetBinContent(bin, 0);
+    SetBinError(bin, 0);
+    return;
+  }
+  const double fraction = mPassed[cell] / total;
+  SetBinContent(bin, fraction);
+  SetBinError(bin, std::sqrt(fraction * (1 - fraction) / total));
+}
+
+void TH2FFraction::Streamer(TBuffer& buffer)
+{
+  streamLazily(buffer, TH2FFraction::Class(), this);
+}
+
+// TH2FBitmask
+
+TH2FBitmask::TH2FBitmask(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax)
+  : TH2Accumulator(name, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax)
+{
+  TH2FBitmask::resetCells();
+}
+
+bool TH2FBitmask::mergeCells(const TH2Accumulator& other)
+{
+  const auto& otherBitmask = static_cast<const TH2FBitmask&>(other);
+  if (otherBitmask.mMask.size() != mMask.size()) {
+    return false;
+  }
+  accumulator_kernels::bitwiseOr(mMask.data(), otherBitmask.mMask.data(), mMask.size());
+  return true;
+}
+
+void TH2FBitmask::resetCells()
+{
+  mMask.assign(numberOfCells(), 0);
+}
+
+void TH2FBitmask::copyCells(TH2Accumulator& destination) const
+{
+  static_cast<TH2FBitmask&>(destination).mMask = mMask;
+}
+
+void TH2FBitmask::materialize(int bin, size_t cell)
+{
+  // the displayed value is exact for the masks of up to 24 bits, getMask() should be used for longer ones
+  SetBinContent(bin, static_cast<double>(mMask[cell]));
+}
+
+void TH2FBitmask::Streamer(TBuffer& buffer)
+{
+  streamLazily(buffer, TH2FBitmask::Class(), this);
+}
+
+// TH2FMinMax
+
+TH2FMinMax::TH2FMinMax(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Display display)
+  : TH2Accumulator(name, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax),
+    mDisplay(static_cast<int>(display))
+{
+  TH2FMinMax::resetCells();
+}
+
+bool TH2FMinMax::hasValues(int binx, int biny) const
+{
+  const auto cell = cellOfBin(binx, biny);
+  return mMin[cell] <= mMax[cell];
+}
+
+bool TH2FMinMax::mergeCells(const TH2Accumulator& other)
+{
+  const auto& otherMinMax = static_cast<const TH2FMinMax&>(other);
+  if (otherMinMax.mMin.size() != mMin.size()) {
+    return false;
+  }
+  accumulator_kernels::minimum(mMin.data(), otherMinMax.mMin.data(), mMin.size());
+  accumulator_kernels::maximum(mMax.data(), otherMinMax.mMax.data(), mMax.size());
+  return true;
+}
+
+void TH2FMinMax::resetCells()
+{
+  mMin.assign(numberOfCells(), std::numeric_limits<double>::max());
+  mMax.assign(numberOfCells(), std::numeric_limits<double>::lowest());
+}
+
+void TH2FMinMax::copyCells(TH2Accumulator& destination) const
+{
+  auto& destinationMinMax = static_cast<TH2FMinMax&>(destination);
+  destinationMinMax.mMin = mMin;
+  destinationMinMax.mMax = mMax;
+  destinationMinMax.mDisplay = mDisplay;
+}
+
+void TH2FMinMax::materialize(int bin, size_t cell)
+{
+  if (mMin[cell] > mMax[cell]) {
+    SetBinContent(bin, 0);
+    return;
+  }
+  switch (getDisplay()) {
+    case Display::Min:
+      SetBinContent(bin, mMin[cell]);
+      break;
+    case Display::Max:
+      SetBinContent(bin, mMax[cell]);
+      break;
+    case Display::Range:
+      SetBinContent(bin, mMax[cell] - mMin[cell]);
+      break;
+  }
+}
+
+void TH2FMinMax::Streamer(TBuffer& buffer)
+{
+  streamLazily(buffer, TH2FMinMax::Class(), this);
+}
+
+} // namespace o2::quality_control_modules::common
@@ -0,0 +1,253 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    runAccumulatorMergeBenchmark.cxx
+///
+/// \brief Measures the time needed by a Merger to merge TH2 accumulators, compared to the ad-hoc merges done bin by
+///        bin on ROOT histograms by the detector-specific classes (entries-weighted means, bit masks, min/max, and
+///        fractions recomputed after each merge).
+///
+/// The default binning corresponds to a PHOS module (64 x 56 cells), for larger maps one may use e.g.
+/// --bins-x 1024 --bins-y 512.
+///
+
+#include "Common/TH2Accumulators.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Timer.h>
+#include <TH2F.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control_modules::common;
+
+struct Fill {
+  double x;
+  double y;
+  double value;
+};
+
+// merges the inputs into a fresh object and returns the elapsed time
+template <typename T>
+double timeMerges(const std::vector<std::unique_ptr<T>>& inputs, const std::function<void(T&, const T&)>& mergeFunction, std::unique_ptr<T> target, size_t repetitions, std::unique_ptr<T>& result)
+{
+  double duration = 0;
+  for (size_t r = 0; r < repetitions; r++) {
+    std::unique_ptr<T> merged(static_cast<T*>(target->Clone()));
+    AliceO2::Common::Timer timer;
+    timer.reset();
+    for (const auto& input : inputs) {
+      mergeFunction(*merged, *input);
+    }
+    duration += timer.getTime();
+    result = std::move(merged);
+  }
+  return duration / repetitions;
+}
+
+void printResult(const std::string& statistic, double adhoc, double accumulator)
+{
+  std::cout << std::setw(14) << std::left << statistic
+            << std::setw(18) << adhoc * 1e3
+            << std::setw(22) << accumulator * 1e3
+            << std::setw(10) << adhoc / accumulator << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                 //
+    ("help,h", "Help screen")                                                                        //
+    ("bins-x", bpo::value<int>()->default_value(64), "Number of bins on the X axis")                 //
+    ("bins-y", bpo::value<int>()->default_value(56), "Number of bins on the Y axis")                 //
+    ("inputs", bpo::value<size_t>()->default_value(50), "Number of objects merged into one")         //
+    ("fills", bpo::value<size_t>()->default_value(20000), "Number of entries in each merged object") //
+    ("repetitions", bpo::value<size_t>()->default_value(5), "Number of measurements for each method");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+
+  const auto binsX = vm["bins-x"].as<int>();
+  const auto binsY = vm["bins-y"].as<int>();
+  const auto numberOfInputs = std::max<size_t>(1, vm["inputs"].as<size_t>());
+  const auto fills = vm["fills"].as<size_t>();
+  const auto repetitions = std::max<size_t>(1, vm["repetitions"].as<size_t>());
+  ILOG_INST.filterDiscardDebug(true);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> x(0, binsX);
+  std::uniform_real_distribution<double> y(0, binsY);
+  std::normal_distribution<double> value(100, 10);
+  std::uniform_int_distribution<int> bit(0, 15);
+  std::vector<std::vector<Fill>> fillsPerInput(numberOfInputs);
+  for (auto& inputFills : fillsPerInput) {
+    for (size_t i = 0; i < fills; i++) {
+      inputFills.push_back({ x(generator), y(generator), value(generator) });
+    }
+  }
+
+  auto makeInputs = [&](auto make, auto fill) {
+    using T = typename decltype(make(std::string{}))::element_type;
+    std::vector<std::unique_ptr<T>> inputs;
+    for (size_t i = 0; i < numberOfInputs; i++) {
+      inputs.push_back(make("input_" + std::to_string(i)));
+      for (const auto& f : fillsPerInput[i]) {
+        fill(*inputs.back(), f);
+      }
+    }
+    return inputs;
+  };
+  auto makeTH2F = [&](const std::string& name) { return std::make_unique<TH2F>(name.c_str(), name.c_str(), binsX, 0, binsX, binsY, 0, binsY); };
+  auto forEachBin = [&](TH2F& h, const std::function<void(int)>& function) {
+    for (int biny = 1; biny <= binsY; biny++) {
+      for (int binx = 1; binx <= binsX; binx++) {
+        function(h.GetBin(binx, biny));
+      }
+    }
+  };
+
+  std::cout << "Merging " << numberOfInputs << " objects with " << binsX << " x " << binsY << " bins" << std::endl;
+  std::cout << std::setw(14) << std::left << "statistic"
+            << std::setw(18) << "ad-hoc [ms]"
+            << std::setw(22) << "accumulator [ms]"
+            << std::setw(10) << "speedup" << std::endl;
+
+  // mean: the entries-weighted average of the means (approximate), against the merge of the counts, means and M2
+  {
+    auto adhocInputs = makeInputs(makeTH2F, [](TH2F& h, const Fill& f) { h.Fill(f.x, f.y, f.value); });
+    std::unique_ptr<TH2F> adhocResult;
+    const double adhoc = timeMerges<TH2F>(
+      adhocInputs, [](TH2F& merged, const TH2F& other) {
+        const double sum = merged.GetEntries() + other.GetEntries();
+        if (sum > 0) {
+          const double w1 = merged.GetEntries() / sum;
+          const double w2 = other.GetEntries() / sum;
+          merged.Scale(w1);
+          merged.Add(&other, w2);
+        } },
+      makeTH2F("adhoc"), repetitions, adhocResult);
+
+    auto accumulatorInputs = makeInputs([&](const std::string& name) { return std::make_unique<TH2FMeanVariance>(name.c_str(), name.c_str(), binsX, 0, binsX, binsY, 0, binsY); },
+                                        [](TH2FMeanVariance& h, const Fill& f) { h.fill(f.x, f.y, f.value); });
+    std::unique_ptr<TH2FMeanVariance> accumulatorResult;
+    const double accumulator = timeMerges<TH2FMeanVariance>(
+      accumulatorInputs, [](TH2FMeanVariance& merged, const TH2FMeanVariance& other) { merged.merge(const_cast<TH2FMeanVariance*>(&other)); },
+      std::make_unique<TH2FMeanVariance>("accumulator", "accumulator", binsX, 0, binsX, binsY, 0, binsY), repetitions, accumulatorResult);
+    printResult("mean", adhoc, accumulator);
+  }
+
+  // bit mask: OR bin by bin through GetBinContent/SetBinContent, against the OR of the arrays
+  {
+    auto adhocInputs = makeInputs(makeTH2F, [&](TH2F& h, const Fill& f) {
+      auto bin = h.FindBin(f.x, f.y);
+      h.SetBinContent(bin, int(h.GetBinContent(bin)) | (1 << bit(generator)));
+    });
+    std::unique_ptr<TH2F> adhocResult;
+    const double adhoc = timeMerges<TH2F>(
+      adhocInputs, [&](TH2F& merged, const TH2F& other) {
+        forEachBin(merged, [&](int bin) { merged.SetBinContent(bin, int(merged.GetBinContent(bin)) | int(other.GetBinContent(bin))); });
+      },
+      makeTH2F("adhoc"), repetitions, adhocResult);
+
+    // the same bits as the ad-hoc inputs
+    std::vector<std::unique_ptr<TH2FBitmask>> accumulatorInputs;
+    for (size_t i = 0; i < numberOfInputs; i++) {
+      accumulatorInputs.push_back(std::make_unique<TH2FBitmask>("input", "input", binsX, 0, binsX, binsY, 0, binsY));
+      forEachBin(*adhocInputs[i], [&](int bin) {
+        int binx, biny, binz;
+        adhocInputs[i]->GetBinXYZ(bin, binx, biny, binz);
+        accumulatorInputs[i]->fill(binx - 0.5, biny - 0.5, static_cast<uint64_t>(adhocInputs[i]->GetBinContent(bin)));
+      });
+    }
+    std::unique_ptr<TH2FBitmask> accumulatorResult;
+    const double accumulator = timeMerges<TH2FBitmask>(
+      accumulatorInputs, [](TH2FBitmask& merged, const TH2FBitmask& other) { merged.merge(const_cast<TH2FBitmask*>(&other)); },
+      std::make_unique<TH2FBitmask>("accumulator", "accumulator", binsX, 0, binsX, binsY, 0, binsY), repetitions, accumulatorResult);
+
+    accumulatorResult->update();
+    bool same = true;
+    forEachBin(*adhocResult, [&](int bin) { same &= adhocResult->GetBinContent(bin) == accumulatorResult->GetBinContent(bin); });
+    if (!same) {
+      std::cerr << "The bit masks merged with both methods differ, the benchmark is not valid" << std::endl;
+      return 1;
+    }
+    printResult("bit mask", adhoc, accumulator);
+  }
+
+  // maximum: bin by bin through GetBinContent/SetBinContent, against the max of the arrays (which also keep the min)
+  {
+    auto adhocInputs = makeInputs(makeTH2F, [](TH2F& h, const Fill& f) {
+      auto bin = h.FindBin(f.x, f.y);
+      h.SetBinContent(bin, std::max(h.GetBinContent(bin), f.value));
+    });
+    std::unique_ptr<TH2F> adhocResult;
+    const double adhoc = timeMerges<TH2F>(
+      adhocInputs, [&](TH2F& merged, const TH2F& other) {
+        forEachBin(merged, [&](int bin) { merged.SetBinContent(bin, std::max(merged.GetBinContent(bin), other.GetBinContent(bin))); });
+      },
+      makeTH2F("adhoc"), repetitions, adhocResult);
+
+    auto accumulatorInputs = makeInputs([&](const std::string& name) { return std::make_unique<TH2FMinMax>(name.c_str(), name.c_str(), binsX, 0, binsX, binsY, 0, binsY); },
+                                        [](TH2FMinMax& h, const Fill& f) { h.fill(f.x, f.y, f.value); });
+    std::unique_ptr<TH2FMinMax> accumulatorResult;
+    const double accumulator = timeMerges<TH2FMinMax>(
+      accumulatorInputs, [](TH2FMinMax& merged, const TH2FMinMax& other) { merged.merge(const_cast<TH2FMinMax*>(&other)); },
+      std::make_unique<TH2FMinMax>("accumulator", "accumulator", binsX, 0, binsX, binsY, 0, binsY), repetitions, accumulatorResult);
+
+    accumulatorResult->update();
+    bool same = true;
+    forEachBin(*adhocResult, [&](int bin) { same &= adhocResult->GetBinContent(bin) == accumulatorResult->GetBinContent(bin); });
+    if (!same) {
+      std::cerr << "The maxima merged with both methods differ, the benchmark is not valid" << std::endl;
+      return 1;
+    }
+    printResult("min/max", adhoc, accumulator);
+  }
+
+  // fraction: counts added with TH2::Add and the fractions recomputed bin by bin after each merge,
+  // against the sums of the arrays
+  {
+    auto adhocInputs = makeInputs(makeTH2F, [](TH2F& h, const Fill& f) { h.Fill(f.x, f.y); });
+    std::unique_ptr<TH2F> adhocResult;
+    auto adhocFraction = makeTH2F("adhocFraction");
+    double events = 0;
+    const double adhoc = timeMerges<TH2F>(
+      adhocInputs, [&](TH2F& merged, const TH2F& other) {
+        merged.Add(&other);
+        events += fills;
+        forEachBin(merged, [&](int bin) { adhocFraction->SetBinContent(bin, merged.GetBinContent(bin) / events); });
+      },
+      makeTH2F("adhoc"), repetitions, adhocResult);
+
+    auto accumulatorInputs = makeInputs([&](const std::string& name) { return std::make_unique<TH2FFraction>(name.c_str(), name.c_str(), binsX, 0, binsX, binsY, 0, binsY); },
+                                        [](TH2FFraction& h, const Fill& f) { h.fill(f.x, f.y, f.value > 100); });
+    std::unique_ptr<TH2FFraction> accumulatorResult;
+    const double accumulator = timeMerges<TH2FFraction>(
+      accumulatorInputs, [](TH2FFraction& merged, const TH2FFraction& other) { merged.merge(const_cast<TH2FFraction*>(&other)); },
+      std::make_unique<TH2FFraction>("accumulator", "accumulator", binsX, 0, binsX, binsY, 0, binsY), repetitions, accumulatorResult);
+    printResult("fraction", adhoc, accumulator);
+  }
+
+  return 0;
+}
@@ -0,0 +1,142 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    runRatioMergeBenchmark.cxx
+///
+/// \brief Measures the time needed by a Merger to merge and serialize TH2FRatio objects, when the ratio is
+///        recomputed after each merge (as it used to be) and when it is recomputed only once before serialization.
+///
+/// The default binning corresponds to the MCH occupancy in the electronics view (dual SAMPA index x channel).
+/// For ITS-like occupancy maps, one may use e.g. --bins-x 1024 --bins-y 4608.
+///
+
+#include "Common/TH2Ratio.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Timer.h>
+#include <TBufferFile.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control_modules::common;
+
+std::unique_ptr<TH2FRatio> createRatio(const std::string& name, int binsX, int binsY, size_t fills, std::mt19937* generator)
+{
+  auto ratio = std::make_unique<TH2FRatio>(name.c_str(), name.c_str(), binsX, 0, binsX, binsY, 0, binsY, false);
+  if (generator != nullptr) {
+    std::uniform_real_distribution<double> x(0, binsX);
+    std::uniform_real_distribution<double> y(0, binsY);
+    for (size_t i = 0; i < fills; i++) {
+      auto xValue = x(*generator);
+      auto yValue = y(*generator);
+      ratio->getDen()->Fill(xValue, yValue);
+      if (i % 3) {
+        ratio->getNum()->Fill(xValue, yValue);
+      }
+    }
+  }
+  return ratio;
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                  //
+    ("help,h", "Help screen")                                                                         //
+    ("bins-x", bpo::value<int>()->default_value(16820), "Number of bins on the X axis")               //
+    ("bins-y", bpo::value<int>()->default_value(64), "Number of bins on the Y axis")                  //
+    ("inputs", bpo::value<size_t>()->default_value(20), "Number of objects merged into one")          //
+    ("fills", bpo::value<size_t>()->default_value(100000), "Number of entries in each merged object") //
+    ("repetitions", bpo::value<size_t>()->default_value(3), "Number of measurements for each method");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+
+  const auto binsX = vm["bins-x"].as<int>();
+  const auto binsY = vm["bins-y"].as<int>();
+  const auto numberOfInputs = std::max<size_t>(1, vm["inputs"].as<size_t>());
+  const auto fills = vm["fills"].as<size_t>();
+  const auto repetitions = std::max<size_t>(1, vm["repetitions"].as<size_t>());
+  ILOG_INST.filterDiscardDebug(true);
+
+  std::mt19937 generator(42);
+  std::vector<std::unique_ptr<TH2FRatio>> inputs;
+  for (size_t i = 0; i < numberOfInputs; i++) {
+    inputs.push_back(createRatio("input_" + std::to_string(i), binsX, binsY, fills, &generator));
+  }
+
+  double eagerMergeDuration = 0, eagerSerializationDuration = 0;
+  double lazyMergeDuration = 0, lazySerializationDuration = 0;
+  double eagerResult = 0, lazyResult = 0;
+  for (size_t r = 0; r < repetitions; r++) {
+    // as it used to be, the division is done after each merge
+    auto eager = createRatio("eager", binsX, binsY, 0, nullptr);
+    AliceO2::Common::Timer timer;
+    timer.reset();
+    for (const auto& input : inputs) {
+      eager->merge(input.get());
+      eager->update();
+    }
+    eagerMergeDuration += timer.getTime();
+    timer.reset();
+    TBufferFile eagerBuffer(TBuffer::kWrite);
+    eagerBuffer.WriteObject(eager.get());
+    eagerSerializationDuration += timer.getTime();
+    eagerResult = eager->GetSumOfWeights();
+
+    // the division is done once, when the merged object is serialized
+    auto lazy = createRatio("lazy", binsX, binsY, 0, nullptr);
+    timer.reset();
+    for (const auto& input : inputs) {
+      lazy->merge(input.get());
+    }
+    lazyMergeDuration += timer.getTime();
+    timer.reset();
+    TBufferFile lazyBuffer(TBuffer::kWrite);
+    lazyBuffer.WriteObject(lazy.get());
+    lazySerializationDuration += timer.getTime();
+    lazyResult = lazy->GetSumOfWeights();
+  }
+
+  if (eagerResult != lazyResult) {
+    std::cerr << "The ratios computed with both methods differ, the benchmark is not valid" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Merging " << numberOfInputs << " TH2FRatio with " << binsX << " x " << binsY << " bins" << std::endl;
+  std::cout << std::setw(10) << "ratio"
+            << std::setw(16) << "merge [ms]"
+            << std::setw(22) << "serialization [ms]"
+            << std::setw(16) << "total [ms]" << std::endl;
+  std::cout << std::setw(10) << "eager"
+            << std::setw(16) << eagerMergeDuration / repetitions * 1e3
+            << std::setw(22) << eagerSerializationDuration / repetitions * 1e3
+            << std::setw(16) << (eagerMergeDuration + eagerSerializationDuration) / repetitions * 1e3 << std::endl;
+  std::cout << std::setw(10) << "lazy"
+            << std::setw(16) << lazyMergeDuration / repetitions * 1e3
+            << std::setw(22) << lazySerializationDuration / repetitions * 1e3
+            << std::setw(16) << (lazyMergeDuration + lazySerializationDuration) / repetitions * 1e3 << std::endl;
+  std::cout << "Speedup: " << (eagerMergeDuration + eagerSerializationDuration) / (lazyMergeDuration + lazySerializationDuration) << std::endl;
+
+  return 0;
+}
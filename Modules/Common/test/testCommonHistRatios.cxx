@@ -17,6 +17,7 @@
 #include "QualityControl/QualityObject.h"
 #include "Common/TH1Ratio.h"
 #include "Common/TH2Ratio.h"
+#include <TBufferFile.h>
 
 #define BOOST_TEST_MODULE CommonHistRatios test
 #define BOOST_TEST_MAIN
@@ -47,6 +48,8 @@ BOOST_AUTO_TEST_CASE(test_TH1FRatioUniform)
 
   histoMerged->merge(histo1.get());
   histoMerged->merge(histo2.get());
+  BOOST_REQUIRE(histoMerged->isRatioOutdated());
+  histoMerged->update();
 
   for (int bin = 1; bin <= 10; bin++) {
     float value = 9.0 * bin / 5.0;
@@ -73,6 +76,8 @@ BOOST_AUTO_TEST_CASE(test_TH1FRatio)
 
   histoMerged->merge(histo1.get());
   histoMerged->merge(histo2.get());
+  BOOST_REQUIRE(histoMerged->isRatioOutdated());
+  histoMerged->update();
 
   for (int bin = 1; bin <= 10; bin++) {
     float value = 9.0 * bin / 7.0;
@@ -173,6 +178,8 @@ BOOST_AUTO_TEST_CASE(test_TH2FRatioUniform)
 
   histoMerged->merge(histo1.get());
   histoMerged->merge(histo2.get());
+  BOOST_REQUIRE(histoMerged->isRatioOutdated());
+  histoMerged->update();
 
   for (int ybin = 1; ybin <= 10; ybin++) {
     for (int xbin = 1; xbin <= 10; xbin++) {
@@ -203,6 +210,8 @@ BOOST_AUTO_TEST_CASE(test_TH2FRatio)
 
   histoMerged->merge(histo1.get());
   histoMerged->merge(histo2.get());
+  BOOST_REQUIRE(histoMerged->isRatioOutdated());
+  histoMerged->update();
 
   for (int ybin = 1; ybin <= 10; ybin++) {
     for (int xbin = 1; xbin <= 10; xbin++) {
@@ -303,3 +312,69 @@ BOOST_AUTO_TEST_CASE(test_TH2FRatioClone)
     }
   }
 }
+
+BOOST_AUTO_TEST_CASE(test_TH2FRatioSerializationAfterMerge)
+{
+  auto histo1 = std::make_unique<TH2FRatio>("test1", "test1", 10, 0, 10.0, 10, 0, 10.0, false);
+  auto histoMerged = std::make_unique<TH2FRatio>("testMerged", "testMerged", 10, 0, 10.0, 10, 0, 10.0, false);
+
+  for (int ybin = 1; ybin <= 10; ybin++) {
+    for (int xbin = 1; xbin <= 10; xbin++) {
+      histo1->getNum()->SetBinContent(xbin, ybin, xbin * ybin * 3);
+      histo1->getDen()->SetBinContent(xbin, ybin, xbin * ybin);
+    }
+  }
+
+  // merging does not divide the histograms...
+  histoMerged->merge(histo1.get());
+  histoMerged->merge(histo1.get());
+  BOOST_REQUIRE(histoMerged->isRatioOutdated());
+  BOOST_REQUIRE_EQUAL(histoMerged->GetBinContent(1, 1), 0);
+
+  // ...but sending or storing the object does
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(histoMerged.get());
+  BOOST_REQUIRE(!histoMerged->isRatioOutdated());
+  buffer.SetReadMode();
+  buffer.SetBufferOffset(0);
+  std::unique_ptr<TH2FRatio> histoRead(static_cast<TH2FRatio*>(buffer.ReadObject(TH2FRatio::Class())));
+  BOOST_REQUIRE(histoRead != nullptr);
+  BOOST_REQUIRE(!histoRead->isRatioOutdated());
+
+  for (int ybin = 1; ybin <= 10; ybin++) {
+    for (int xbin = 1; xbin <= 10; xbin++) {
+      BOOST_REQUIRE_EQUAL(histoMerged->GetBinContent(xbin, ybin), 3);
+      BOOST_REQUIRE_EQUAL(histoRead->GetBinContent(xbin, ybin), 3);
+      BOOST_REQUIRE_EQUAL(histoRead->getNum()->GetBinContent(xbin, ybin), xbin * ybin * 6);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_TH2FRatioAddThenRead)
+{
+  // as in MCH HistoOnCycle: the difference between two cycles is read right after Add()
+  auto current = std::make_unique<TH2FRatio>("current", "current", 10, 0, 10.0, 10, 0, 10.0, false);
+  auto previous = std::make_unique<TH2FRatio>("previous", "previous", 10, 0, 10.0, 10, 0, 10.0, false);
+
+  for (int ybin = 1; ybin <= 10; ybin++) {
+    for (int xbin = 1; xbin <= 10; xbin++) {
+      current->getNum()->SetBinContent(xbin, ybin, xbin * ybin * 5);
+      current->getDen()->SetBinContent(xbin, ybin, xbin * ybin * 2);
+      previous->getNum()->SetBinContent(xbin, ybin, xbin * ybin * 2);
+      previous->getDen()->SetBinContent(xbin, ybin, xbin * ybin);
+    }
+  }
+  current->update();
+  previous->update();
+
+  auto onCycle = std::make_unique<TH2FRatio>("onCycle", "onCycle", 10, 0, 10.0, 10, 0, 10.0, false);
+  current->Copy(*onCycle);
+  BOOST_REQUIRE(onCycle->Add(previous.get(), -1));
+  BOOST_REQUIRE(!onCycle->isRatioOutdated());
+
+  for (int ybin = 1; ybin <= 10; ybin++) {
+    for (int xbin = 1; xbin <= 10; xbin++) {
+      BOOST_REQUIRE_EQUAL(onCycle->GetBinContent(xbin, ybin), 3);
+    }
+  }
+}
@@ -0,0 +1,240 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testTH2Accumulators.cxx
+///
+
+#include "Common/TH2Accumulators.h"
+#include <TBufferFile.h>
+#include <cmath>
+#include <memory>
+
+#define BOOST_TEST_MODULE TH2Accumulators test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control_modules::common;
+
+BOOST_AUTO_TEST_CASE(test_TH2FMeanVariance)
+{
+  auto histo1 = std::make_unique<TH2FMeanVariance>("test1", "test1", 4, 0, 4, 2, 0, 2);
+  auto histo2 = std::make_unique<TH2FMeanVariance>("test2", "test2", 4, 0, 4, 2, 0, 2);
+  auto histoMerged = std::make_unique<TH2FMeanVariance>("testMerged", "testMerged", 4, 0, 4, 2, 0, 2);
+
+  // unbalanced inputs: averaging the means weighted by the entries would give 2.5 instead of 2
+  histo1->fill(1.5, 0.5, 1);
+  histo1->fill(1.5, 0.5, 1);
+  histo1->fill(1.5, 0.5, 1);
+  histo2->fill(1.5, 0.5, 5);
+  histo2->Fill(3.5, 1.5, 7);
+  histo2->fill(10, 10, 100); // overflow, ignored
+  BOOST_CHECK(histo1->isOutdated());
+
+  histoMerged->merge(histo1.get());
+  histoMerged->merge(histo2.get());
+  BOOST_REQUIRE(histoMerged->isOutdated());
+  BOOST_CHECK_EQUAL(histoMerged->GetEntries(), 5);
+  BOOST_CHECK_EQUAL(histoMerged->getCount(2, 1), 4);
+  BOOST_CHECK_CLOSE(histoMerged->getMean(2, 1), 2.0, 1e-9);
+  BOOST_CHECK_CLOSE(histoMerged->getVariance(2, 1), 3.0, 1e-9);
+
+  histoMerged->update();
+  BOOST_CHECK(!histoMerged->isOutdated());
+  BOOST_CHECK_EQUAL(histoMerged->GetEntries(), 5);
+  BOOST_CHECK_CLOSE(histoMerged->GetBinContent(2, 1), 2.0, 1e-5);
+  BOOST_CHECK_CLOSE(histoMerged->GetBinError(2, 1), std::sqrt(3.0 / 4), 1e-5);
+  BOOST_CHECK_CLOSE(histoMerged->GetBinContent(4, 2), 7.0, 1e-5);
+  BOOST_CHECK_EQUAL(histoMerged->GetBinContent(1, 1), 0);
+
+  histoMerged->setDisplay(TH2FMeanVariance::Display::StdDev);
+  histoMerged->update();
+  BOOST_CHECK_CLOSE(histoMerged->GetBinContent(2, 1), std::sqrt(3.0), 1e-5);
+
+  histoMerged->Reset();
+  BOOST_CHECK_EQUAL(histoMerged->getCount(2, 1), 0);
+  BOOST_CHECK_EQUAL(histoMerged->GetEntries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_TH2FMeanVarianceLargeOffset)
+{
+  // values around 1e6 with a spread of 1, e.g. timings: sum2/n - mean^2 would lose most of the digits
+  constexpr double offset = 1e6;
+  auto histo1 = std::make_unique<TH2FMeanVariance>("test1", "test1", 1, 0, 1, 1, 0, 1);
+  auto histo2 = std::make_unique<TH2FMeanVariance>("test2", "test2", 1, 0, 1, 1, 0, 1);
+  auto histoMerged = std::make_unique<TH2FMeanVariance>("testMerged", "testMerged", 1, 0, 1, 1, 0, 1);
+
+  // 0.1, 0.2, ..., 1.0 above the offset, split unevenly between the inputs
+  for (int i = 1; i <= 10; i++) {
+    (i <= 3 ? histo1 : histo2)->fill(0.5, 0.5, offset + 0.1 * i);
+  }
+  histoMerged->merge(histo1.get());
+  histoMerged->merge(histo2.get());
+
+  // mean 0.55 above the offset and variance (n^2 - 1) / 12 * 0.1^2 = 0.0825
+  BOOST_CHECK_EQUAL(histoMerged->getCount(1, 1), 10);
+  BOOST_CHECK_CLOSE(histoMerged->getMean(1, 1) - offset, 0.55, 1e-6);
+  BOOST_CHECK_CLOSE(histoMerged->getVariance(1, 1), 0.0825, 1e-6);
+  BOOST_CHECK_CLOSE(histo1->getVariance(1, 1), 0.02 / 3, 1e-6);
+
+  histoMerged->setDisplay(TH2FMeanVariance::Display::StdDev);
+  histoMerged->update();
+  BOOST_CHECK_CLOSE(histoMerged->GetBinContent(1, 1), std::sqrt(0.0825), 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE(test_TH2FFraction)
+{
+  auto histo1 = std::make_unique<TH2FFraction>("test1", "test1", 2, 0, 2, 2, 0, 2);
+  auto histo2 = std::make_unique<TH2FFraction>("test2", "test2", 2, 0, 2, 2, 0, 2);
+
+  histo1->fill(0.5, 0.5, true);
+  histo2->fill(0.5, 0.5, false);
+  histo2->fill(0.5, 0.5, false);
+  histo2->fill(0.5, 0.5, true);
+
+  histo1->merge(histo2.get());
+  histo1->update();
+  BOOST_CHECK_EQUAL(histo1->getPassed(1, 1), 2);
+  BOOST_CHECK_EQUAL(histo1->getTotal(1, 1), 4);
+  BOOST_CHECK_CLOSE(histo1->GetBinContent(1, 1), 0.5, 1e-5);
+  BOOST_CHECK_CLOSE(histo1->GetBinError(1, 1), 0.25, 1e-5);
+}
+
+BOOST_AUTO_TEST_CASE(test_TH2FBitmask)
+{
+  auto histo1 = std::make_unique<TH2FBitmask>("test1", "test1", 32, 0, 32, 15, 0, 15);
+  auto histo2 = std::make_unique<TH2FBitmask>("test2", "test2", 32, 0, 32, 15, 0, 15);
+
+  histo1->fill(3.5, 2.5, 0b0101);
+  histo2->fill(3.5, 2.5, 0b0011);
+  histo2->fill(3.5, 2.5, uint64_t(1) << 40);
+
+  histo1->merge(histo2.get());
+  histo1->update();
+  BOOST_CHECK_EQUAL(histo1->getMask(4, 3), 0b0111 | (uint64_t(1) << 40));
+  BOOST_CHECK_EQUAL(histo2->getMask(4, 3), 0b0011 | (uint64_t(1) << 40));
+  BOOST_CHECK_EQUAL(histo1->getMask(1, 1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_TH2FMinMax)
+{
+  auto histo1 = std::make_unique<TH2FMinMax>("test1", "test1", 2, 0, 2, 1, 0, 1);
+  auto histo2 = std::make_unique<TH2FMinMax>("test2", "test2", 2, 0, 2, 1, 0, 1, TH2FMinMax::Display::Range);
+
+  histo1->fill(0.5, 0.5, 3);
+  histo1->fill(0.5, 0.5, -1);
+  histo2->fill(0.5, 0.5, 10);
+  histo2->fill(1.5, 0.5, -4);
+
+  histo2->merge(histo1.get());
+  BOOST_CHECK(histo2->hasValues(1, 1));
+  BOOST_CHECK_EQUAL(histo2->getMin(1, 1), -1);
+  BOOST_CHECK_EQUAL(histo2->getMax(1, 1), 10);
+  BOOST_CHECK(!histo1->hasValues(2, 1));
+
+  histo2->update();
+  BOOST_CHECK_EQUAL(histo2->GetBinContent(1, 1), 11);
+  BOOST_CHECK_EQUAL(histo2->GetBinContent(2, 1), 0);
+  histo1->update();
+  BOOST_CHECK_EQUAL(histo1->GetBinContent(1, 1), 3);
+  BOOST_CHECK_EQUAL(histo1->GetBinContent(2, 1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_TH2AccumulatorIncompatible)
+{
+  auto histo = std::make_unique<TH2FMeanVariance>("test", "test", 4, 0, 4, 2, 0, 2);
+  auto otherBinning = std::make_unique<TH2FMeanVariance>("otherBinning", "otherBinning", 8, 0, 4, 2, 0, 2);
+  auto otherClass = std::make_unique<TH2FFraction>("otherClass", "otherClass", 4, 0, 4, 2, 0, 2);
+  histo->fill(0.5, 0.5, 1);
+  otherBinning->fill(0.5, 0.5, 1);
+  otherClass->fill(0.5, 0.5, true);
+
+  histo->merge(otherBinning.get());
+  histo->merge(otherClass.get());
+  BOOST_CHECK_EQUAL(histo->getCount(1, 1), 1);
+  BOOST_CHECK_EQUAL(histo->GetEntries(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_TH2AccumulatorSetBins)
+{
+  auto histo = std::make_unique<TH2FMeanVariance>("test", "test", 4, 0, 4, 2, 0, 2);
+  histo->fill(0.5, 0.5, 1);
+
+  // the statistics are resized with the bins and reset
+  histo->SetBins(8, 0, 8, 4, 0, 4);
+  BOOST_CHECK_EQUAL(histo->GetEntries(), 0);
+  BOOST_CHECK_EQUAL(histo->getCount(1, 1), 0);
+  histo->fill(7.5, 3.5, 3);
+  BOOST_CHECK_EQUAL(histo->getCount(8, 4), 1);
+  BOOST_CHECK_EQUAL(histo->getMean(8, 4), 3);
+
+  auto other = std::make_unique<TH2FMeanVariance>("other", "other", 8, 0, 8, 4, 0, 4);
+  other->fill(7.5, 3.5, 5);
+  histo->merge(other.get());
+  BOOST_CHECK_EQUAL(histo->getCount(8, 4), 2);
+  BOOST_CHECK_EQUAL(histo->getMean(8, 4), 4);
+  histo->update();
+  BOOST_CHECK_EQUAL(histo->GetBinContent(8, 4), 4);
+
+  const double xBins[] = { 0, 1, 3 };
+  const double yBins[] = { 0, 2 };
+  auto fraction = std::make_unique<TH2FFraction>("fraction", "fraction", 4, 0, 4, 2, 0, 2);
+  fraction->fill(3.5, 1.5, true);
+  fraction->SetBins(2, xBins, 1, yBins);
+  BOOST_CHECK_EQUAL(fraction->GetEntries(), 0);
+  fraction->fill(2.5, 1.5, true);
+  BOOST_CHECK_EQUAL(fraction->getTotal(2, 1), 1);
+  BOOST_CHECK_EQUAL(fraction->getPassed(2, 1), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_TH2AccumulatorRebin)
+{
+  auto histo = std::make_unique<TH2FMinMax>("test", "test", 4, 0, 4, 2, 0, 2);
+  histo->fill(3.5, 1.5, 2);
+
+  // rebinning would have to combine the statistics of several bins, it is refused and the object stays valid
+  BOOST_CHECK(histo->Rebin2D(2, 2) == nullptr);
+  BOOST_CHECK(histo->RebinX(2) == nullptr);
+  BOOST_CHECK(histo->RebinY(2) == nullptr);
+  BOOST_CHECK_EQUAL(histo->GetNbinsX(), 4);
+  BOOST_CHECK_EQUAL(histo->GetNbinsY(), 2);
+  histo->fill(3.5, 1.5, 5);
+  BOOST_CHECK_EQUAL(histo->getMin(4, 2), 2);
+  BOOST_CHECK_EQUAL(histo->getMax(4, 2), 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_TH2AccumulatorStreamerAndClone)
+{
+  auto histo = std::make_unique<TH2FMeanVariance>("test", "test", 4, 0, 4, 2, 0, 2);
+  histo->fill(0.5, 0.5, 2);
+  histo->fill(0.5, 0.5, 4);
+  BOOST_REQUIRE(histo->isOutdated());
+
+  // the bin contents are computed when the object is serialized
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(histo.get());
+  BOOST_CHECK(!histo->isOutdated());
+  buffer.SetReadMode();
+  buffer.SetBufferOffset(0);
+  std::unique_ptr<TH2FMeanVariance> read(static_cast<TH2FMeanVariance*>(buffer.ReadObject(TH2FMeanVariance::Class())));
+  BOOST_REQUIRE(read != nullptr);
+  BOOST_CHECK_CLOSE(read->GetBinContent(1, 1), 3.0, 1e-5);
+  BOOST_CHECK_EQUAL(read->getCount(1, 1), 2);
+
+  // the statistics go along with the clones, so that they can be merged further
+  std::unique_ptr<TH2FMeanVariance> clone(dynamic_cast<TH2FMeanVariance*>(read->Clone("clone")));
+  BOOST_REQUIRE(clone != nullptr);
+  clone->merge(read.get());
+  BOOST_CHECK_EQUAL(clone->getCount(1, 1), 4);
+  BOOST_CHECK_CLOSE(clone->getMean(1, 1), 3.0, 1e-9);
+}
@@ -0,0 +1,86 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef QC_MODULE_EMCAL_CELLEVENTBUILDER_H
+#define QC_MODULE_EMCAL_CELLEVENTBUILDER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <gsl/span>
+#include "CommonDataFormat/InteractionRecord.h"
+#include "CommonDataFormat/RangeReference.h"
+#include "Headers/DataHeader.h"
+
+namespace o2::emcal
+{
+class Cell;
+class TriggerRecord;
+} // namespace o2::emcal
+
+namespace o2::quality_control_modules::emcal
+{
+
+/// \class CellEventBuilder
+/// \brief Combines the cells received from several FLPs (subevents) into events
+/// \ingroup EMCALQCTasks
+///
+/// The cells and trigger records of one timeframe are registered per subspecification, then build() groups the
+/// trigger records of all subspecifications by interaction record. All the containers are kept between timeframes
+/// and only cleared, so that once they reached the size of a typical timeframe, building the events does not
+/// allocate memory anymore.
+class CellEventBuilder
+{
+ public:
+  using SubSpecificationType = header::DataHeader::SubSpecificationType;
+
+  struct SubEvent {
+    SubSpecificationType mSpecification;
+    gsl::span<const o2::emcal::Cell> mCells; ///< Cells of the subevent, empty if no cells were received for the subspecification
+    bool mHasCells;                          ///< False if no cell payload was received for the subspecification
+  };
+
+  struct CombinedEvent {
+    InteractionRecord mInteractionRecord;
+    uint32_t mTriggerType;
+    int mNumberOfObjects;                              ///< Number of cells in all the subevents, according to the trigger records
+    dataformats::RangeReference<int, int> mSubevents; ///< Range of the subevents, see getSubevents()
+  };
+
+  /// \brief Forgets the data of the previous timeframe, keeping the allocated memory
+  void reset();
+  void addCells(SubSpecificationType specification, gsl::span<const o2::emcal::Cell> cells);
+  void addTriggerRecords(SubSpecificationType specification, gsl::span<const o2::emcal::TriggerRecord> triggerRecords);
+
+  /// \brief Builds the events, sorted by interaction record. The result is valid until the next reset().
+  const std::vector<CombinedEvent>& build();
+  gsl::span<const SubEvent> getSubevents(const CombinedEvent& event) const
+  {
+    return { mSubevents.data() + event.mSubevents.getFirstEntry(), static_cast<size_t>(event.mSubevents.getEntries()) };
+  }
+
+ private:
+  struct Record {
+    InteractionRecord mInteractionRecord;
+    size_t mSubspecificationIndex;
+    const o2::emcal::TriggerRecord* mTriggerRecord;
+  };
+
+  std::vector<std::pair<SubSpecificationType, gsl::span<const o2::emcal::Cell>>> mCells;                   ///< Cells per subspecification
+  std::vector<std::pair<SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>> mTriggerRecords; ///< Trigger records per subspecification
+  std::vector<Record> mRecords;                                                                            ///< Trigger records of all subspecifications, sorted by interaction record
+  std::vector<SubEvent> mSubevents;                                                                        ///< Subevents of all the events
+  std::vector<CombinedEvent> mEvents;                                                                      ///< Combined events
+};
+
+} // namespace o2::quality_control_modules::emcal
+
+#endif // QC_MODULE_EMCAL_CELLEVENTBUILDER_H
@@ -15,7 +15,6 @@
 #include "QualityControl/TaskInterface.h"
 #include <array>
 #include <climits>
-#include <unordered_map>
 #include <string_view>
 #include <gsl/span>
 #include <CCDB/TObjectWrapper.h>
@@ -24,6 +23,7 @@
 #include "CommonDataFormat/RangeReference.h"
 #include "Headers/DataHeader.h"
 #include "DataFormatsEMCAL/TriggerRecord.h"
+#include "EMCAL/CellEventBuilder.h"
 
 class TH1;
 class TH2;
@@ -58,6 +58,14 @@ namespace quality_control_modules::emcal
 class CellTask final : public TaskInterface
 {
  public:
+  /// \brief Trigger classes monitored separately, used as index of the histogram container
+  enum TriggerClass_t {
+    CAL_TRIGGER,
+    PHYS_TRIGGER,
+    NTriggerClasses
+  };
+  static constexpr std::array<const char*, NTriggerClasses> TriggerClassNames = { { "CAL", "PHYS" } };
+
   struct TaskSettings {
     bool mHasAmpVsCellID;
     bool mHasTimeVsCellID;
@@ -122,7 +130,7 @@ class CellTask final : public TaskInterface
     TH1* mCellAmplitudeCalib_tot = nullptr;                                    ///< Cell amplitude Calib in EMCAL,DCAL
     TH1* mCellAmplitudeCalib_EMCAL = nullptr;                                  ///< Cell amplitude Calib in EMCAL
     TH1* mCellAmplitudeCalib_DCAL = nullptr;                                   ///< Cell amplitude Calib in DCAL
-    std::array<TH1*, 4> mCellTimeBC;                                           ///< Cell amplitude in EMCAL for each bc
+    std::array<TH1*, 4> mCellTimeBC{};                                         ///< Cell amplitude in EMCAL for each bc
     TH1* mCellTimeSupermodule_tot = nullptr;                                   ///< Cell time in EMCAL,DCAL per SuperModule
     TH1* mCellTimeSupermoduleEMCAL = nullptr;                                  ///< Cell time in EMCAL per SuperModule
     TH1* mCellTimeSupermoduleDCAL = nullptr;                                   ///< Cell time in DCAL per SuperModule
@@ -162,38 +170,14 @@ class CellTask final : public TaskInterface
   std::string getConfigValueLower(const std::string_view key);
 
  private:
-  struct SubEvent {
-    header::DataHeader::SubSpecificationType mSpecification;
-    dataformats::RangeReference<int, int> mCellRange;
-  };
-
-  struct CombinedEvent {
-    InteractionRecord mInteractionRecord;
-    uint32_t mTriggerType;
-    std::vector<SubEvent> mSubevents;
-
-    [[nodiscard]] int getNumberOfObjects() const
-    {
-      int nObjects = 0;
-      for (auto ev : mSubevents) {
-        nObjects += ev.mCellRange.getEntries();
-      }
-      return nObjects;
-    }
-
-    int getNumberOfSubevents()
-    {
-      return mSubevents.size();
-    };
-  };
   void parseMultiplicityRanges();
   void initDefaultMultiplicityRanges();
   void loadCalibrationObjects(o2::framework::ProcessingContext& ctx);
 
-  [[nodiscard]] std::vector<CombinedEvent> buildCombinedEvents(const std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>& triggerrecords) const;
   TaskSettings mTaskSettings;                                      ///< Settings of the task steered via task parameters
   Bool_t mIgnoreTriggerTypes = false;                              ///< Do not differenciate between trigger types, treat all triggers as phys. triggers
-  std::map<std::string, CellHistograms> mHistogramContainer;       ///< Container with histograms per trigger class
+  std::array<CellHistograms, NTriggerClasses> mHistogramContainer; ///< Container with histograms per trigger class
+  CellEventBuilder mEventBuilder;                                  ///< Combination of the subevents of a timeframe, reused for all timeframes
   o2::emcal::Geometry* mGeometry = nullptr;                        ///< EMCAL geometry
   const o2::emcal::BadChannelMap* mBadChannelMap = nullptr;        ///< EMCAL channel map
   const o2::emcal::TimeCalibrationParams* mTimeCalib = nullptr;    ///< EMCAL time calib
@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CellEventBuilder.cxx
+///
+
+#include <algorithm>
+
+#include "EMCAL/CellEventBuilder.h"
+#include "DataFormatsEMCAL/Cell.h"
+#include "DataFormatsEMCAL/TriggerRecord.h"
+
+namespace o2::quality_control_modules::emcal
+{
+
+void CellEventBuilder::reset()
+{
+  mCells.clear();
+  mTriggerRecords.clear();
+  mRecords.clear();
+  mSubevents.clear();
+  mEvents.clear();
+}
+
+void CellEventBuilder::addCells(SubSpecificationType specification, gsl::span<const o2::emcal::Cell> cells)
+{
+  for (auto& [existing, existingCells] : mCells) {
+    if (existing == specification) {
+      existingCells = cells;
+      return;
+    }
+  }
+  mCells.emplace_back(specification, cells);
+}
+
+void CellEventBuilder::addTriggerRecords(SubSpecificationType specification, gsl::span<const o2::emcal::TriggerRecord> triggerRecords)
+{
+  for (auto& [existing, existingRecords] : mTriggerRecords) {
+    if (existing == specification) {
+      existingRecords = triggerRecords;
+      return;
+    }
+  }
+  mTriggerRecords.emplace_back(specification, triggerRecords);
+}
+
+const std::vector<CellEventBuilder::CombinedEvent>& CellEventBuilder::build()
+{
+  mRecords.clear();
+  mSubevents.clear();
+  mEvents.clear();
+
+  for (size_t index = 0; index < mTriggerRecords.size(); index++) {
+    for (const auto& record : mTriggerRecords[index].second) {
+      mRecords.push_back({ record.getBCData(), index, &record });
+    }
+  }
+  // the order within an interaction record makes the result independent of the sorting algorithm
+  std::sort(mRecords.begin(), mRecords.end(), [](const Record& a, const Record& b) {
+    if (a.mInteractionRecord != b.mInteractionRecord) {
+      return a.mInteractionRecord < b.mInteractionRecord;
+    }
+    if (a.mSubspecificationIndex != b.mSubspecificationIndex) {
+      return a.mSubspecificationIndex < b.mSubspecificationIndex;
+    }
+    return a.mTriggerRecord < b.mTriggerRecord;
+  });
+
+  for (auto first = mRecords.begin(); first != mRecords.end();) {
+    auto last = first;
+    CombinedEvent event{ first->mInteractionRecord, first->mTriggerRecord->getTriggerBits(), 0, { static_cast<int>(mSubevents.size()), 0 } };
+    for (; last != mRecords.end() && last->mInteractionRecord == first->mInteractionRecord; last++) {
+      // only the first trigger record of a subspecification is used for a given interaction
+      if (last != first && (last - 1)->mSubspecificationIndex == last->mSubspecificationIndex) {
+        continue;
+      }
+      auto specification = mTriggerRecords[last->mSubspecificationIndex].first;
+      auto cells = std::find_if(mCells.begin(), mCells.end(), [specification](const auto& entry) { return entry.first == specification; });
+      SubEvent subevent{ specification, {}, cells != mCells.end() };
+      if (subevent.mHasCells) {
+        subevent.mCells = gsl::span<const o2::emcal::Cell>(cells->second.data() + last->mTriggerRecord->getFirstEntry(), last->mTriggerRecord->getNumberOfObjects());
+      }
+      mSubevents.push_back(subevent);
+      event.mNumberOfObjects += last->mTriggerRecord->getNumberOfObjects();
+    }
+    event.mSubevents.setEntries(static_cast<int>(mSubevents.size()) - event.mSubevents.getFirstEntry());
+    mEvents.push_back(event);
+    first = last;
+  }
+  return mEvents;
+}
+
+} // namespace o2::quality_control_modules::emcal
@@ -38,7 +38,6 @@
 #include <Framework/InputRecord.h>
 #include <Framework/InputRecordWalker.h>
 #include <CommonConstants/Triggers.h>
-#include <set>
 
 namespace o2::quality_control_modules::emcal
 {
@@ -50,8 +49,8 @@ CellTask::~CellTask()
       delete hist;
     }
   };
-  for (auto en : mHistogramContainer) {
-    en.second.clean();
+  for (auto& histos : mHistogramContainer) {
+    histos.clean();
   }
   cleanOptional(mEvCounterTF);
   cleanOptional(mEvCounterTFPHYS);
@@ -167,13 +166,11 @@ void CellTask::initialize(o2::framework::InitContext& /*ctx*/)
     mGeometry = o2::emcal::Geometry::GetInstanceFromRunNumber(300000);
   }
 
-  std::array<std::string, 2> triggers = { { "CAL", "PHYS" } };
-  for (const auto& trg : triggers) {
-    CellHistograms histos;
+  for (int trg = 0; trg < NTriggerClasses; trg++) {
+    auto& histos = mHistogramContainer[trg];
     histos.mGeometry = mGeometry;
-    histos.initForTrigger(trg.data(), mTaskSettings);
+    histos.initForTrigger(TriggerClassNames[trg], mTaskSettings);
     histos.startPublishing(*getObjectsManager());
-    mHistogramContainer[trg] = histos;
   } // trigger type
   // new histos
   mTFPerCyclesTOT = new TH1D("NumberOfTFperCycles_TOT", "NumberOfTFperCycles_TOT", 100, -0.5, 99.5); //
@@ -365,11 +362,9 @@ void CellTask::monitorData(o2::framework::ProcessingContext& ctx)
   using MaskType_t = o2::emcal::BadChannelMap::MaskType_t;
 
   // Handling of inputs from multiple subevents (multiple FLPs)
-  // Build maps of trigger records and cells according to the subspecification
-  // and combine trigger records from different maps into a single map of range
-  // references and subspecifications
-  std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::Cell>> cellSubEvents;
-  std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>> triggerRecordSubevents;
+  // Register trigger records and cells according to the subspecification
+  // and combine trigger records from different subspecifications into events
+  mEventBuilder.reset();
 
   loadCalibrationObjects(ctx);
 
@@ -384,7 +379,7 @@ void CellTask::monitorData(o2::framework::ProcessingContext& ctx)
     if (subspecification == 0xDEADBEEF) {
       continue;
     }
-    cellSubEvents[subspecification] = ctx.inputs().get<gsl::span<o2::emcal::Cell>>(celldata);
+    mEventBuilder.addCells(subspecification, ctx.inputs().get<gsl::span<o2::emcal::Cell>>(celldata));
   }
   for (decltype(numSlotsTriggerRecords) islot = 0; islot < numSlotsTriggerRecords; islot++) {
     auto trgrecorddata = ctx.inputs().getByPos(posTriggerRecords, islot);
@@ -393,10 +388,10 @@ void CellTask::monitorData(o2::framework::ProcessingContext& ctx)
     if (subspecification == 0xDEADBEEF) {
       continue;
     }
-    triggerRecordSubevents[subspecification] = ctx.inputs().get<gsl::span<o2::emcal::TriggerRecord>>(trgrecorddata);
+    mEventBuilder.addTriggerRecords(subspecification, ctx.inputs().get<gsl::span<o2::emcal::TriggerRecord>>(trgrecorddata));
   }
 
-  auto combinedEvents = buildCombinedEvents(triggerRecordSubevents);
+  const auto& combinedEvents = mEventBuilder.build();
 
   //  ILOG(Info, Support) <<"Received " << cellcontainer.size() << " cells " << ENDM;
   int eventcounter = 0;
@@ -409,25 +404,25 @@ void CellTask::monitorData(o2::framework::ProcessingContext& ctx)
   std::array<double, 20> totalEnergies;
   std::fill(numCellsSM.begin(), numCellsSM.end(), 0);
   std::fill(numCellsSM_Thres.begin(), numCellsSM_Thres.end(), 0);
-  for (auto trg : combinedEvents) {
-    if (!trg.getNumberOfObjects()) {
+  for (const auto& trg : combinedEvents) {
+    if (!trg.mNumberOfObjects) {
       continue;
     }
-    ILOG(Debug, Support) << "Next event " << eventcounter << " has " << trg.getNumberOfObjects() << " cells from " << trg.getNumberOfSubevents() << " subevent(s)" << ENDM;
+    ILOG(Debug, Support) << "Next event " << eventcounter << " has " << trg.mNumberOfObjects << " cells from " << trg.mSubevents.getEntries() << " subevent(s)" << ENDM;
 
     // trigger type
     auto triggertype = trg.mTriggerType;
     bool isPhysTrigger = mIgnoreTriggerTypes || (triggertype & o2::trigger::PhT),
          isCalibTrigger = (!mIgnoreTriggerTypes) && (triggertype & o2::trigger::Cal);
-    std::string trgClass;
+    TriggerClass_t trgClass;
     if (isPhysTrigger) {
-      trgClass = "PHYS";
+      trgClass = PHYS_TRIGGER;
       eventcounterPHYS++;
       if (mBCCounterPHYS) {
         mBCCounterPHYS->Fill(trg.mInteractionRecord.bc);
       }
     } else if (isCalibTrigger) {
-      trgClass = "CAL";
+      trgClass = CAL_TRIGGER;
       eventcounterCALIB++;
       if (mBCCounterCalib) {
         mBCCounterCalib->Fill(trg.mInteractionRecord.bc);
@@ -441,7 +436,7 @@ void CellTask::monitorData(o2::framework::ProcessingContext& ctx)
     if (isCalibTrigger) {
       bcphase = 0;
     }
-    auto histos = mHistogramContainer[trgClass];
+    auto& histos = mHistogramContainer[trgClass];
     std::fill(numCellsSM.begin(), numCellsSM.end(), 0);
     std::fill(numCellsSM_Thres.begin(), numCellsSM_Thres.end(), 0);
     std::fill(numCellsGood.begin(), numCellsGood.end(), 0);
@@ -449,14 +444,12 @@ void CellTask::monitorData(o2::framework::ProcessingContext& ctx)
     std::fill(totalEnergies.begin(), totalEnergies.end(), 0.);
 
     // iterate over subevents
-    for (auto& subev : trg.mSubevents) {
-      auto cellsSubspec = cellSubEvents.find(subev.mSpecification);
-      if (cellsSubspec == cellSubEvents.end()) {
+    for (const auto& subev : mEventBuilder.getSubevents(trg)) {
+      if (!subev.mHasCells) {
         ILOG(Error, Support) << "No cell data found for subspecification " << subev.mSpecification << ENDM;
       } else {
-        ILOG(Debug, Support) << subev.mCellRange.getEntries() << " cells in subevent from equipment " << subev.mSpecification << ENDM;
-        gsl::span<const o2::emcal::Cell> eventcells(cellsSubspec->second.data() + subev.mCellRange.getFirstEntry(), subev.mCellRange.getEntries());
-        for (auto cell : eventcells) {
+        ILOG(Debug, Support) << subev.mCells.size() << " cells in subevent from equipment " << subev.mSpecification << ENDM;
+        for (const auto& cell : subev.mCells) {
           if (cell.getLEDMon()) {
             // Drop LEDMON cells
             continue;
@@ -594,8 +587,8 @@ void CellTask::reset()
   // clean all the monitor objects here
 
   ILOG(Debug, Support) << "Resetting the histogram" << ENDM;
-  for (auto cont : mHistogramContainer) {
-    cont.second.reset();
+  for (auto& histos : mHistogramContainer) {
+    histos.reset();
   }
   auto resetOptional = [](auto* hist) {
     if (hist) {
@@ -725,45 +718,6 @@ void CellTask::parseMultiplicityRanges()
   }
 }
 
-std::vector<CellTask::CombinedEvent> CellTask::buildCombinedEvents(const std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>& triggerrecords) const
-{
-  std::vector<CellTask::CombinedEvent> events;
-
-  // Search interaction records from all subevents
-  std::set<o2::InteractionRecord> allInteractions;
-  for (auto& [subspecification, trgrec] : triggerrecords) {
-    for (auto rec : trgrec) {
-      auto eventIR = rec.getBCData();
-      if (allInteractions.find(eventIR) == allInteractions.end()) {
-        allInteractions.insert(eventIR);
-      }
-    }
-  }
-
-  // iterate over all subevents for all bunch crossings
-  for (auto collision : allInteractions) {
-    CombinedEvent nextevent;
-    nextevent.mInteractionRecord = collision;
-    bool first = true,
-         hasSubevent = false;
-    for (auto [subspecification, records] : triggerrecords) {
-      auto found = std::find_if(records.begin(), records.end(), [&collision](const o2::emcal::TriggerRecord& rec) { return rec.getBCData() == collision; });
-      if (found != records.end()) {
-        hasSubevent = true;
-        if (first) {
-          nextevent.mTriggerType = found->getTriggerBits();
-          first = false;
-        }
-        nextevent.mSubevents.push_back({ subspecification, o2::dataformats::RangeReference(found->getFirstEntry(), found->getNumberOfObjects()) });
-      }
-    }
-    if (hasSubevent) {
-      events.emplace_back(nextevent);
-    }
-  }
-  return events;
-}
-
 bool CellTask::hasConfigValue(const std::string_view key)
 {
   if (auto param = mCustomParameters.find(key.data()); param != mCustomParameters.end()) {
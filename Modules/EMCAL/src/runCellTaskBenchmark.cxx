@@ -0,0 +1,248 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   runCellTaskBenchmark.cxx
+///
+/// \brief Measures the throughput of the per-event loop of the EMCAL CellTask on synthetic cells, with the
+///        subevent combination and trigger class dispatch used before (maps built for each timeframe, histogram
+///        groups copied for each event) and with the reusable CellEventBuilder and the array of histogram groups.
+///
+
+#include "EMCAL/CellEventBuilder.h"
+#include "EMCAL/CellTask.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Timer.h>
+#include <CommonConstants/Triggers.h>
+#include <DataFormatsEMCAL/Cell.h>
+#include <DataFormatsEMCAL/Constants.h>
+#include <DataFormatsEMCAL/TriggerRecord.h>
+#include <EMCALBase/Geometry.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control_modules::emcal;
+using SubSpecificationType = o2::header::DataHeader::SubSpecificationType;
+using CellHistograms = CellTask::CellHistograms;
+
+namespace
+{
+
+struct Subevent {
+  SubSpecificationType specification;
+  std::vector<o2::emcal::Cell> cells;
+  std::vector<o2::emcal::TriggerRecord> triggerRecords;
+};
+
+std::vector<Subevent> generateTimeframe(size_t nSubevents, size_t nEvents, size_t nCells, std::mt19937& generator)
+{
+  std::uniform_int_distribution<short> tower(0, 17663);
+  std::exponential_distribution<float> energy(2.);
+  std::normal_distribution<float> time(0., 20.);
+  std::vector<Subevent> subevents(nSubevents);
+  for (size_t s = 0; s < nSubevents; s++) {
+    subevents[s].specification = s;
+    for (size_t e = 0; e < nEvents; e++) {
+      // one event out of ten is a calibration trigger
+      auto triggerBits = e % 10 ? o2::trigger::PhT : o2::trigger::Cal;
+      o2::InteractionRecord ir(e * 8 % 3564, 1 + e * 8 / 3564);
+      subevents[s].triggerRecords.emplace_back(ir, triggerBits, subevents[s].cells.size(), nCells);
+      for (size_t c = 0; c < nCells; c++) {
+        subevents[s].cells.emplace_back(tower(generator), energy(generator), time(generator), o2::emcal::ChannelType_t::HIGH_GAIN);
+      }
+    }
+  }
+  return subevents;
+}
+
+// the implementation of CellTask before the CellEventBuilder, kept as the reference
+struct LegacySubEvent {
+  SubSpecificationType mSpecification;
+  o2::dataformats::RangeReference<int, int> mCellRange;
+};
+
+struct LegacyCombinedEvent {
+  o2::InteractionRecord mInteractionRecord;
+  uint32_t mTriggerType;
+  std::vector<LegacySubEvent> mSubevents;
+};
+
+std::vector<LegacyCombinedEvent> buildLegacyCombinedEvents(const std::unordered_map<SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>& triggerrecords)
+{
+  std::vector<LegacyCombinedEvent> events;
+  std::set<o2::InteractionRecord> allInteractions;
+  for (auto& [subspecification, trgrec] : triggerrecords) {
+    for (auto rec : trgrec) {
+      allInteractions.insert(rec.getBCData());
+    }
+  }
+  for (auto collision : allInteractions) {
+    LegacyCombinedEvent nextevent;
+    nextevent.mInteractionRecord = collision;
+    bool first = true;
+    for (auto [subspecification, records] : triggerrecords) {
+      auto found = std::find_if(records.begin(), records.end(), [&collision](const o2::emcal::TriggerRecord& rec) { return rec.getBCData() == collision; });
+      if (found != records.end()) {
+        if (first) {
+          nextevent.mTriggerType = found->getTriggerBits();
+          first = false;
+        }
+        nextevent.mSubevents.push_back({ subspecification, o2::dataformats::RangeReference(found->getFirstEntry(), found->getNumberOfObjects()) });
+      }
+    }
+    if (!nextevent.mSubevents.empty()) {
+      events.emplace_back(nextevent);
+    }
+  }
+  return events;
+}
+
+size_t processLegacy(const std::vector<Subevent>& timeframe, std::map<std::string, CellHistograms>& container)
+{
+  std::unordered_map<SubSpecificationType, gsl::span<const o2::emcal::Cell>> cellSubEvents;
+  std::unordered_map<SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>> triggerRecordSubevents;
+  for (const auto& subevent : timeframe) {
+    cellSubEvents[subevent.specification] = subevent.cells;
+    triggerRecordSubevents[subevent.specification] = subevent.triggerRecords;
+  }
+  size_t nCells = 0;
+  for (auto trg : buildLegacyCombinedEvents(triggerRecordSubevents)) {
+    bool isPhysTrigger = trg.mTriggerType & o2::trigger::PhT;
+    std::string trgClass = isPhysTrigger ? "PHYS" : "CAL";
+    auto bcphase = isPhysTrigger ? trg.mInteractionRecord.bc % 4 : 0;
+    auto histos = container[trgClass];
+    for (auto& subev : trg.mSubevents) {
+      auto cellsSubspec = cellSubEvents.find(subev.mSpecification);
+      gsl::span<const o2::emcal::Cell> eventcells(cellsSubspec->second.data() + subev.mCellRange.getFirstEntry(), subev.mCellRange.getEntries());
+      for (auto cell : eventcells) {
+        histos.fillHistograms(cell, true, 0., 1., bcphase);
+        nCells++;
+      }
+    }
+    histos.countEvent();
+  }
+  return nCells;
+}
+
+size_t processBuilder(const std::vector<Subevent>& timeframe, CellEventBuilder& builder, std::array<CellHistograms, CellTask::NTriggerClasses>& container)
+{
+  builder.reset();
+  for (const auto& subevent : timeframe) {
+    builder.addCells(subevent.specification, subevent.cells);
+    builder.addTriggerRecords(subevent.specification, subevent.triggerRecords);
+  }
+  size_t nCells = 0;
+  for (const auto& trg : builder.build()) {
+    bool isPhysTrigger = trg.mTriggerType & o2::trigger::PhT;
+    auto bcphase = isPhysTrigger ? trg.mInteractionRecord.bc % 4 : 0;
+    auto& histos = container[isPhysTrigger ? CellTask::PHYS_TRIGGER : CellTask::CAL_TRIGGER];
+    for (const auto& subev : builder.getSubevents(trg)) {
+      for (const auto& cell : subev.mCells) {
+        histos.fillHistograms(cell, true, 0., 1., bcphase);
+        nCells++;
+      }
+    }
+    histos.countEvent();
+  }
+  return nCells;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                  //
+    ("help,h", "Help screen")                                                                         //
+    ("timeframes", bpo::value<size_t>()->default_value(20), "Number of timeframes")                   //
+    ("subevents", bpo::value<size_t>()->default_value(4), "Number of subevents (FLPs) per event")     //
+    ("events", bpo::value<size_t>()->default_value(1000), "Number of events per timeframe")           //
+    ("cells", bpo::value<size_t>()->default_value(10), "Number of cells per subevent")                //
+    ("repetitions", bpo::value<size_t>()->default_value(3), "Number of measurements for each method");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+
+  const auto nTimeframes = std::max<size_t>(1, vm["timeframes"].as<size_t>());
+  const auto repetitions = std::max<size_t>(1, vm["repetitions"].as<size_t>());
+  ILOG_INST.filterDiscardDebug(true);
+
+  std::mt19937 generator(42);
+  std::vector<std::vector<Subevent>> timeframes;
+  for (size_t tf = 0; tf < nTimeframes; tf++) {
+    timeframes.push_back(generateTimeframe(vm["subevents"].as<size_t>(), vm["events"].as<size_t>(), vm["cells"].as<size_t>(), generator));
+  }
+
+  CellTask::TaskSettings settings{};
+  auto geometry = o2::emcal::Geometry::GetInstanceFromRunNumber(300000);
+  std::array<CellHistograms, CellTask::NTriggerClasses> histograms{};
+  std::map<std::string, CellHistograms> legacyContainer;
+  for (int trg = 0; trg < CellTask::NTriggerClasses; trg++) {
+    histograms[trg].mGeometry = geometry;
+    histograms[trg].initForTrigger(CellTask::TriggerClassNames[trg], settings);
+    legacyContainer[CellTask::TriggerClassNames[trg]] = histograms[trg];
+  }
+
+  double legacyDuration = 0;
+  double builderDuration = 0;
+  size_t legacyCells = 0;
+  size_t builderCells = 0;
+  CellEventBuilder builder;
+  AliceO2::Common::Timer timer;
+  for (size_t r = 0; r < repetitions; r++) {
+    timer.reset();
+    for (const auto& timeframe : timeframes) {
+      legacyCells += processLegacy(timeframe, legacyContainer);
+    }
+    legacyDuration += timer.getTime();
+
+    timer.reset();
+    for (const auto& timeframe : timeframes) {
+      builderCells += processBuilder(timeframe, builder, histograms);
+    }
+    builderDuration += timer.getTime();
+  }
+
+  if (legacyCells != builderCells) {
+    std::cerr << "The two methods did not process the same number of cells, the benchmark is not valid" << std::endl;
+    return 1;
+  }
+
+  std::cout << std::setw(12) << "method"
+            << std::setw(16) << "time [ms]"
+            << std::setw(20) << "cells/s" << std::endl;
+  std::cout << std::setw(12) << "legacy"
+            << std::setw(16) << legacyDuration / repetitions * 1e3
+            << std::setw(20) << legacyCells / legacyDuration << std::endl;
+  std::cout << std::setw(12) << "builder"
+            << std::setw(16) << builderDuration / repetitions * 1e3
+            << std::setw(20) << builderCells / builderDuration << std::endl;
+  std::cout << "Speedup: " << legacyDuration / builderDuration << std::endl;
+
+  for (auto& histos : histograms) {
+    histos.clean();
+  }
+  return 0;
+}
@@ -0,0 +1,136 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ChannelBookkeeping.h
+/// \brief Fixed-size containers for the per-digit path of the FIT DigitQcTasks, which does not allocate
+
+#ifndef QC_MODULE_FIT_CHANNELBOOKKEEPING_H
+#define QC_MODULE_FIT_CHANNELBOOKKEEPING_H
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace o2::quality_control_modules::fit
+{
+
+/// Values indexed by channel ID, with the set of channels which have one.
+/// It replaces the pairs std::set<chID> + std::map<chID, value> used to select the channels with dedicated histograms.
+template <std::size_t NChannels, typename ValueType>
+class ChannelArray
+{
+ public:
+  constexpr static std::size_t sNchannels = NChannels;
+
+  /// Returns false if the channel ID is out of range
+  bool set(std::size_t chID, ValueType value)
+  {
+    if (chID >= NChannels) {
+      return false;
+    }
+    mIsSet.set(chID);
+    mValues[chID] = value;
+    return true;
+  }
+  bool contains(std::size_t chID) const { return chID < NChannels && mIsSet.test(chID); }
+  bool empty() const { return mIsSet.none(); }
+  std::size_t size() const { return mIsSet.count(); }
+  /// No check, the channel has to be contained
+  const ValueType& operator[](std::size_t chID) const { return mValues[chID]; }
+  void clear()
+  {
+    mIsSet.reset();
+    mValues.fill(ValueType{});
+  }
+
+  /// Calls func(chID, value) for the channels which have a value, by increasing channel ID
+  template <typename Func>
+  void forEach(Func&& func) const
+  {
+    for (std::size_t chID = 0; chID < NChannels; chID++) {
+      if (mIsSet.test(chID)) {
+        func(chID, mValues[chID]);
+      }
+    }
+  }
+
+ private:
+  std::bitset<NChannels> mIsSet;
+  std::array<ValueType, NChannels> mValues{};
+};
+
+/// Per-digit bookkeeping of the FEE modules, indexed by the module hash (its bin in the FEE histograms).
+/// It replaces the std::set of fired modules and the std::map of the PM amplitude sums built for each digit:
+/// clear() only resets what the previous digit touched.
+template <std::size_t NModules = 256>
+class FEEModulesOfDigit
+{
+ public:
+  void clear()
+  {
+    for (std::size_t i = 0; i < mNFired; i++) {
+      mIsFired.reset(mFired[i]);
+    }
+    for (std::size_t i = 0; i < mNWithAmplitude; i++) {
+      mHasAmplitude.reset(mWithAmplitude[i]);
+      mSumAmpl[mWithAmplitude[i]] = 0;
+    }
+    mNFired = 0;
+    mNWithAmplitude = 0;
+  }
+  void setFired(uint8_t moduleHash)
+  {
+    if (!mIsFired.test(moduleHash)) {
+      mIsFired.set(moduleHash);
+      mFired[mNFired++] = moduleHash;
+    }
+  }
+  void addAmplitude(uint8_t moduleHash, int amplitude)
+  {
+    if (!mHasAmplitude.test(moduleHash)) {
+      mHasAmplitude.set(moduleHash);
+      mWithAmplitude[mNWithAmplitude++] = moduleHash;
+    }
+    mSumAmpl[moduleHash] += amplitude;
+  }
+  /// Calls func(moduleHash) once for each fired module
+  template <typename Func>
+  void forEachFired(Func&& func) const
+  {
+    for (std::size_t i = 0; i < mNFired; i++) {
+      func(mFired[i]);
+    }
+  }
+  /// Calls func(moduleHash, sumAmpl) once for each module which got an amplitude
+  template <typename Func>
+  void forEachAmplitude(Func&& func) const
+  {
+    for (std::size_t i = 0; i < mNWithAmplitude; i++) {
+      func(mWithAmplitude[i], mSumAmpl[mWithAmplitude[i]]);
+    }
+  }
+
+ private:
+  static_assert(NModules <= 256, "the module hashes are stored in uint8_t");
+  std::bitset<NModules> mIsFired;
+  std::bitset<NModules> mHasAmplitude;
+  std::array<uint8_t, NModules> mFired{};
+  std::array<uint8_t, NModules> mWithAmplitude{};
+  std::array<int, NModules> mSumAmpl{};
+  std::size_t mNFired = 0;
+  std::size_t mNWithAmplitude = 0;
+};
+
+} // namespace o2::quality_control_modules::fit
+
+#endif // QC_MODULE_FIT_CHANNELBOOKKEEPING_H
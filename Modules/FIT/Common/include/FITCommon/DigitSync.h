@@ -25,6 +25,9 @@
 #include <functional>
 #include <bitset>
 #include <array>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
 
 #include "CommonDataFormat/InteractionRecord.h"
 
@@ -93,6 +96,119 @@ struct DigitSync {
     fillSyncMap(mapIR2Digits, vecDigitsFV0);
     return mapIR2Digits;
   }
+
+  /// Range over the digits synchronized by interaction record, computed on the fly by merging the three containers.
+  /// It requires the containers to be sorted by interaction record (see isSorted()), which is the case for the digits
+  /// and the reconstructed points of one TF, and then gives the same sequence of (IR, DigitSync) pairs as iterating over
+  /// the map returned by makeSyncMap(), in linear time and without allocation.
+  /// The containers are referenced, they must outlive the range.
+  template <typename DigitFDDcont, typename DigitFT0cont, typename DigitFV0cont>
+  class SyncRange
+  {
+   public:
+    using value_type = std::pair<o2::InteractionRecord, DigitSync>;
+
+    class iterator
+    {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = SyncRange::value_type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const value_type*;
+      using reference = const value_type&;
+
+      iterator(const SyncRange* range, bool isEnd) : mRange(range), mIsEnd(isEnd)
+      {
+        if (!mIsEnd) {
+          advance();
+        }
+      }
+      reference operator*() const { return mEntry; }
+      pointer operator->() const { return &mEntry; }
+      iterator& operator++()
+      {
+        advance();
+        return *this;
+      }
+      bool operator==(const iterator& other) const { return mIsEnd == other.mIsEnd && (mIsEnd || mPositions == other.mPositions); }
+      bool operator!=(const iterator& other) const { return !(*this == other); }
+
+     private:
+      template <typename ContType>
+      void findFirstIR(const ContType& vecDigits, EDetectorBit detector, bool& isFound, o2::InteractionRecord& ir) const
+      {
+        const auto position = mPositions[detector];
+        if (position < vecDigits.size()) {
+          const auto irDigit = getIR(vecDigits[position]);
+          if (!isFound || irDigit < ir) {
+            ir = irDigit;
+            isFound = true;
+          }
+        }
+      }
+      // in case of several digits with the same IR in one detector, the last one is kept, as in makeSyncMap()
+      template <typename ContType>
+      void take(const ContType& vecDigits, EDetectorBit detector)
+      {
+        auto& position = mPositions[detector];
+        while (position < vecDigits.size() && getIR(vecDigits[position]) == mEntry.first) {
+          mEntry.second.mActiveDets.set(detector);
+          mEntry.second.mDigitIndexes[detector] = position;
+          position++;
+        }
+      }
+      void advance()
+      {
+        bool isFound = false;
+        o2::InteractionRecord ir{};
+        findFirstIR(mRange->mVecDigitsFDD, EDetectorBit::kFDD, isFound, ir);
+        findFirstIR(mRange->mVecDigitsFT0, EDetectorBit::kFT0, isFound, ir);
+        findFirstIR(mRange->mVecDigitsFV0, EDetectorBit::kFV0, isFound, ir);
+        if (!isFound) {
+          mIsEnd = true;
+          return;
+        }
+        mEntry.first = ir;
+        mEntry.second = DigitSync{};
+        take(mRange->mVecDigitsFDD, EDetectorBit::kFDD);
+        take(mRange->mVecDigitsFT0, EDetectorBit::kFT0);
+        take(mRange->mVecDigitsFV0, EDetectorBit::kFV0);
+      }
+
+      const SyncRange* mRange;
+      std::array<Index_t, sNdetectors> mPositions{};
+      value_type mEntry{};
+      bool mIsEnd;
+    };
+
+    SyncRange(const DigitFDDcont& vecDigitsFDD, const DigitFT0cont& vecDigitsFT0, const DigitFV0cont& vecDigitsFV0)
+      : mVecDigitsFDD(vecDigitsFDD), mVecDigitsFT0(vecDigitsFT0), mVecDigitsFV0(vecDigitsFV0)
+    {
+    }
+    iterator begin() const { return iterator(this, false); }
+    iterator end() const { return iterator(this, true); }
+
+   private:
+    const DigitFDDcont& mVecDigitsFDD;
+    const DigitFT0cont& mVecDigitsFT0;
+    const DigitFV0cont& mVecDigitsFV0;
+  };
+
+  template <typename DigitFDDcont, typename DigitFT0cont, typename DigitFV0cont>
+  static SyncRange<DigitFDDcont, DigitFT0cont, DigitFV0cont> makeSyncRange(const DigitFDDcont& vecDigitsFDD,
+                                                                           const DigitFT0cont& vecDigitsFT0,
+                                                                           const DigitFV0cont& vecDigitsFV0)
+  {
+    return { vecDigitsFDD, vecDigitsFT0, vecDigitsFV0 };
+  }
+
+  /// Checks whether the digits are sorted by interaction record, the precondition of makeSyncRange()
+  template <typename ContType>
+  static bool isSorted(const ContType& vecDigits)
+  {
+    return std::is_sorted(vecDigits.begin(), vecDigits.end(), [](const auto& first, const auto& second) { return getIR(first) < getIR(second); });
+  }
+
   Index_t getIndexFDD() const { return mDigitIndexes[EDetectorBit::kFDD]; }
   Index_t getIndexFT0() const { return mDigitIndexes[EDetectorBit::kFT0]; }
   Index_t getIndexFV0() const { return mDigitIndexes[EDetectorBit::kFV0]; }
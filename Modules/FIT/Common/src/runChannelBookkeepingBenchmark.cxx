@@ -0,0 +1,237 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   runChannelBookkeepingBenchmark.cxx
+/// \brief Compares the per-digit channel bookkeeping of the FIT DigitQcTasks done with std::set and std::map
+/// (as it used to be) and with the fixed-size containers of ChannelBookkeeping.h, for the FDD, FT0 and FV0 geometries.
+///
+
+#include "FITCommon/ChannelBookkeeping.h"
+
+#include <Common/Timer.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control_modules::fit;
+
+// The part of a channel which matters for the bookkeeping
+struct Channel {
+  uint8_t chID;
+  int amplitude;
+  bool isInADCgate;
+};
+
+struct Digit {
+  size_t firstChannel;
+  size_t nChannels;
+};
+
+// What the tasks compute from the bookkeeping, to verify that both implementations agree
+struct Result {
+  int64_t sumAmplA = 0;
+  int64_t sumAmplC = 0;
+  uint64_t firedModules = 0;
+  uint64_t selectedChannels = 0;
+  bool operator==(const Result& other) const
+  {
+    return sumAmplA == other.sumAmplA && sumAmplC == other.sumAmplC && firedModules == other.firedModules && selectedChannels == other.selectedChannels;
+  }
+};
+
+struct Geometry {
+  std::vector<uint8_t> chID2PMhash;
+  std::map<uint8_t, bool> mapPMhash2isAside;
+  std::bitset<256> pmHash2isAside;
+  uint8_t tcmHash;
+};
+
+Geometry makeGeometry(size_t nChannels, size_t channelsPerPM)
+{
+  Geometry geometry;
+  const size_t nPMs = (nChannels + channelsPerPM - 1) / channelsPerPM;
+  for (size_t chID = 0; chID < nChannels; chID++) {
+    geometry.chID2PMhash.push_back(chID / channelsPerPM);
+  }
+  for (size_t pm = 0; pm < nPMs; pm++) {
+    geometry.mapPMhash2isAside.insert({ pm, pm < nPMs / 2 });
+    geometry.pmHash2isAside.set(pm, pm < nPMs / 2);
+  }
+  geometry.tcmHash = nPMs;
+  return geometry;
+}
+
+// as DigitQcTask::monitorData used to do it
+Result runWithStdContainers(const std::vector<Digit>& digits, const std::vector<Channel>& channels, Geometry& geometry, const std::set<unsigned int>& selectedChIDs)
+{
+  Result result;
+  for (const auto& digit : digits) {
+    std::set<uint8_t> setFEEmodules{};
+    std::map<uint8_t, int> mapPMhash2sumAmpl;
+    for (const auto& entry : geometry.mapPMhash2isAside) {
+      mapPMhash2sumAmpl.insert({ entry.first, 0 });
+    }
+    for (size_t i = digit.firstChannel; i < digit.firstChannel + digit.nChannels; i++) {
+      const auto& chData = channels[i];
+      if (selectedChIDs.size() != 0 && selectedChIDs.find(static_cast<unsigned int>(chData.chID)) != selectedChIDs.end()) {
+        result.selectedChannels++;
+      }
+      setFEEmodules.insert(geometry.chID2PMhash[chData.chID]);
+      if (chData.isInADCgate) {
+        mapPMhash2sumAmpl[geometry.chID2PMhash[chData.chID]] += chData.amplitude;
+      }
+    }
+    for (const auto& entry : mapPMhash2sumAmpl) {
+      if (geometry.mapPMhash2isAside[entry.first]) {
+        result.sumAmplA += (entry.second >> 3);
+      } else {
+        result.sumAmplC += (entry.second >> 3);
+      }
+    }
+    setFEEmodules.insert(geometry.tcmHash);
+    for (const auto& feeHash : setFEEmodules) {
+      result.firedModules += feeHash + 1;
+    }
+  }
+  return result;
+}
+
+template <size_t NChannels>
+Result runWithFixedContainers(const std::vector<Digit>& digits, const std::vector<Channel>& channels, const Geometry& geometry, const ChannelArray<NChannels, int>& selectedChIDs)
+{
+  Result result;
+  FEEModulesOfDigit<> modulesOfDigit;
+  for (const auto& digit : digits) {
+    modulesOfDigit.clear();
+    for (size_t i = digit.firstChannel; i < digit.firstChannel + digit.nChannels; i++) {
+      const auto& chData = channels[i];
+      if (selectedChIDs.contains(chData.chID)) {
+        result.selectedChannels++;
+      }
+      modulesOfDigit.setFired(geometry.chID2PMhash[chData.chID]);
+      if (chData.isInADCgate) {
+        modulesOfDigit.addAmplitude(geometry.chID2PMhash[chData.chID], chData.amplitude);
+      }
+    }
+    modulesOfDigit.forEachAmplitude([&](uint8_t pmHash, int sumAmpl) {
+      if (geometry.pmHash2isAside.test(pmHash)) {
+        result.sumAmplA += (sumAmpl >> 3);
+      } else {
+        result.sumAmplC += (sumAmpl >> 3);
+      }
+    });
+    modulesOfDigit.setFired(geometry.tcmHash);
+    modulesOfDigit.forEachFired([&](uint8_t feeHash) { result.firedModules += feeHash + 1; });
+  }
+  return result;
+}
+
+template <size_t NChannels>
+bool runDetector(const std::string& name, size_t channelsPerPM, size_t nDigits, double occupancy, size_t nSelected, size_t repetitions)
+{
+  std::mt19937 generator(42);
+  std::bernoulli_distribution isFired(occupancy);
+  std::bernoulli_distribution isInADCgate(0.9);
+  std::uniform_int_distribution<int> amplitude(0, 4000);
+
+  std::vector<Digit> digits;
+  std::vector<Channel> channels;
+  for (size_t d = 0; d < nDigits; d++) {
+    Digit digit{ channels.size(), 0 };
+    for (size_t chID = 0; chID < NChannels; chID++) {
+      if (isFired(generator)) {
+        channels.push_back({ static_cast<uint8_t>(chID), amplitude(generator), isInADCgate(generator) });
+        digit.nChannels++;
+      }
+    }
+    digits.push_back(digit);
+  }
+
+  auto geometry = makeGeometry(NChannels, channelsPerPM);
+  std::set<unsigned int> selectedSet;
+  ChannelArray<NChannels, int> selectedArray;
+  for (size_t chID = 0; chID < std::min(nSelected, NChannels); chID++) {
+    selectedSet.insert(chID * 7 % NChannels);
+    selectedArray.set(chID * 7 % NChannels, 1);
+  }
+
+  Result resultStd;
+  Result resultFixed;
+  AliceO2::Common::Timer timer;
+  timer.reset();
+  for (size_t r = 0; r < repetitions; r++) {
+    resultStd = runWithStdContainers(digits, channels, geometry, selectedSet);
+  }
+  const double stdDuration = timer.getTime();
+  timer.reset();
+  for (size_t r = 0; r < repetitions; r++) {
+    resultFixed = runWithFixedContainers<NChannels>(digits, channels, geometry, selectedArray);
+  }
+  const double fixedDuration = timer.getTime();
+
+  if (!(resultStd == resultFixed)) {
+    std::cerr << name << ": the results differ, the benchmark is not valid" << std::endl;
+    return false;
+  }
+  const double processedDigits = static_cast<double>(nDigits * repetitions);
+  std::cout << std::setw(10) << std::left << name
+            << std::setw(12) << NChannels
+            << std::setw(16) << static_cast<double>(channels.size()) / nDigits
+            << std::setw(22) << processedDigits / stdDuration
+            << std::setw(22) << processedDigits / fixedDuration
+            << std::setw(10) << stdDuration / fixedDuration << std::endl;
+  return true;
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                           //
+    ("help,h", "Help screen")                                                                                  //
+    ("digits", bpo::value<size_t>()->default_value(100000), "Number of digits per detector")                   //
+    ("occupancy", bpo::value<double>()->default_value(0.2), "Fraction of the channels fired in a digit")       //
+    ("selected-channels", bpo::value<size_t>()->default_value(8), "Channels with dedicated histograms")        //
+    ("repetitions", bpo::value<size_t>()->default_value(5), "Number of times the digits are processed");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+
+  const auto nDigits = std::max<size_t>(1, vm["digits"].as<size_t>());
+  const auto occupancy = std::clamp(vm["occupancy"].as<double>(), 0.0, 1.0);
+  const auto nSelected = vm["selected-channels"].as<size_t>();
+  const auto repetitions = std::max<size_t>(1, vm["repetitions"].as<size_t>());
+
+  std::cout << std::setw(10) << std::left << "detector"
+            << std::setw(12) << "channels"
+            << std::setw(16) << "fired/digit"
+            << std::setw(22) << "std digits/s"
+            << std::setw(22) << "fixed-size digits/s"
+            << std::setw(10) << "speedup" << std::endl;
+  // channel counts of the DigitQcTasks (sNCHANNELS_PM, sNCHANNELS_FV0_PLUSREF), 12 channels per PM (8 for FDD)
+  bool valid = runDetector<20>("FDD", 8, nDigits, occupancy, nSelected, repetitions);
+  valid &= runDetector<208>("FT0", 12, nDigits, occupancy, nSelected, repetitions);
+  valid &= runDetector<49>("FV0", 12, nDigits, occupancy, nSelected, repetitions);
+  return valid ? 0 : 1;
+}
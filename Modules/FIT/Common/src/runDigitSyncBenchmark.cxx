@@ -0,0 +1,187 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   runDigitSyncBenchmark.cxx
+/// \brief Compares the synchronization of FDD, FT0 and FV0 digits with DigitSync::makeSyncMap and DigitSync::makeSyncRange
+///
+
+#include "FITCommon/DigitSync.h"
+#include "CommonConstants/LHCConstants.h"
+
+#include <Common/Timer.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control_modules::fit;
+
+// Only the interaction record matters for the synchronization, the payload stands for the size of the real digits.
+template <int Detector, size_t PayloadSize>
+struct SyntheticDigit {
+  o2::InteractionRecord mIntRecord;
+  std::array<char, PayloadSize> mPayload{};
+  const o2::InteractionRecord& getIntRecord() const { return mIntRecord; }
+};
+using DigitFDD = SyntheticDigit<0, 24>;
+using DigitFT0 = SyntheticDigit<1, 48>;
+using DigitFV0 = SyntheticDigit<2, 40>;
+using DigitSyncBenchmark = DigitSync<DigitFDD, DigitFT0, DigitFV0>;
+
+template <typename DigitType>
+std::vector<DigitType> makeDigits(const std::vector<o2::InteractionRecord>& collisions, double efficiency, size_t noiseDigits, uint32_t orbits, std::mt19937& generator)
+{
+  std::bernoulli_distribution isSeen(efficiency);
+  std::uniform_int_distribution<uint32_t> orbitDistribution(0, orbits - 1);
+  std::uniform_int_distribution<uint16_t> bcDistribution(0, o2::constants::lhc::LHCMaxBunches - 1);
+  std::vector<DigitType> digits;
+  digits.reserve(collisions.size() + noiseDigits);
+  for (const auto& ir : collisions) {
+    if (isSeen(generator)) {
+      digits.push_back(DigitType{ ir });
+    }
+  }
+  for (size_t i = 0; i < noiseDigits; i++) {
+    digits.push_back(DigitType{ o2::InteractionRecord(bcDistribution(generator), orbitDistribution(generator)) });
+  }
+  // as in the TFs, the digits are sorted by IR and there is one digit per IR
+  std::sort(digits.begin(), digits.end(), [](const auto& a, const auto& b) { return a.mIntRecord < b.mIntRecord; });
+  digits.erase(std::unique(digits.begin(), digits.end(), [](const auto& a, const auto& b) { return a.mIntRecord == b.mIntRecord; }), digits.end());
+  return digits;
+}
+
+// what a task does with each synchronized entry, enough to keep the compiler from removing the loop
+template <typename EntryType>
+uint64_t consume(const EntryType& entry)
+{
+  const auto& digitSync = entry.second;
+  return entry.first.bc + digitSync.mActiveDets.to_ulong() + digitSync.getIndexFDD() + digitSync.getIndexFT0() + digitSync.getIndexFV0();
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                                  //
+    ("help,h", "Help screen")                                                                                         //
+    ("interaction-rate", bpo::value<double>()->default_value(50), "Interaction rate [kHz], 50 for Pb-Pb, 500 for pp") //
+    ("orbits", bpo::value<uint32_t>()->default_value(32), "Number of orbits in a TF")                                 //
+    ("noise-fraction", bpo::value<double>()->default_value(0.1), "Digits without collision, relative to collisions")  //
+    ("tfs", bpo::value<size_t>()->default_value(100), "Number of different TFs")                                      //
+    ("repetitions", bpo::value<size_t>()->default_value(10), "Number of times each TF is synchronized");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+
+  const auto interactionRate = vm["interaction-rate"].as<double>() * 1e3;
+  const auto orbits = std::max<uint32_t>(1, vm["orbits"].as<uint32_t>());
+  const auto noiseFraction = vm["noise-fraction"].as<double>();
+  const auto tfs = std::max<size_t>(1, vm["tfs"].as<size_t>());
+  const auto repetitions = std::max<size_t>(1, vm["repetitions"].as<size_t>());
+
+  // collisions are distributed uniformly among the bunch crossings of the TF
+  const double collisionsPerTF = interactionRate * orbits * o2::constants::lhc::LHCOrbitNS * 1e-9;
+  const double probabilityPerBC = std::min(1.0, collisionsPerTF / (orbits * o2::constants::lhc::LHCMaxBunches));
+  std::mt19937 generator(42);
+  std::bernoulli_distribution isCollision(probabilityPerBC);
+
+  std::vector<std::vector<DigitFDD>> digitsFDD(tfs);
+  std::vector<std::vector<DigitFT0>> digitsFT0(tfs);
+  std::vector<std::vector<DigitFV0>> digitsFV0(tfs);
+  size_t totalDigits = 0;
+  for (size_t tf = 0; tf < tfs; tf++) {
+    std::vector<o2::InteractionRecord> collisions;
+    for (uint32_t orbit = 0; orbit < orbits; orbit++) {
+      for (uint16_t bc = 0; bc < o2::constants::lhc::LHCMaxBunches; bc++) {
+        if (isCollision(generator)) {
+          collisions.emplace_back(bc, orbit);
+        }
+      }
+    }
+    const auto noiseDigits = static_cast<size_t>(noiseFraction * collisions.size());
+    digitsFDD[tf] = makeDigits<DigitFDD>(collisions, 0.8, noiseDigits, orbits, generator);
+    digitsFT0[tf] = makeDigits<DigitFT0>(collisions, 0.95, noiseDigits, orbits, generator);
+    digitsFV0[tf] = makeDigits<DigitFV0>(collisions, 0.9, noiseDigits, orbits, generator);
+    totalDigits += digitsFDD[tf].size() + digitsFT0[tf].size() + digitsFV0[tf].size();
+  }
+
+  // both methods have to give the same entries in the same order
+  for (size_t tf = 0; tf < tfs; tf++) {
+    const auto map = DigitSyncBenchmark::makeSyncMap(digitsFDD[tf], digitsFT0[tf], digitsFV0[tf]);
+    const auto range = DigitSyncBenchmark::makeSyncRange(digitsFDD[tf], digitsFT0[tf], digitsFV0[tf]);
+    auto itMap = map.begin();
+    for (const auto& entry : range) {
+      if (itMap == map.end() || !(itMap->first == entry.first) || itMap->second.mActiveDets != entry.second.mActiveDets ||
+          itMap->second.mDigitIndexes != entry.second.mDigitIndexes) {
+        std::cerr << "The synchronized entries differ, the benchmark is not valid" << std::endl;
+        return 1;
+      }
+      ++itMap;
+    }
+    if (itMap != map.end()) {
+      std::cerr << "The synchronized entries differ, the benchmark is not valid" << std::endl;
+      return 1;
+    }
+  }
+
+  uint64_t checksumMap = 0;
+  AliceO2::Common::Timer timer;
+  timer.reset();
+  for (size_t r = 0; r < repetitions; r++) {
+    for (size_t tf = 0; tf < tfs; tf++) {
+      for (const auto& entry : DigitSyncBenchmark::makeSyncMap(digitsFDD[tf], digitsFT0[tf], digitsFV0[tf])) {
+        checksumMap += consume(entry);
+      }
+    }
+  }
+  const double mapDuration = timer.getTime();
+
+  uint64_t checksumRange = 0;
+  timer.reset();
+  for (size_t r = 0; r < repetitions; r++) {
+    for (size_t tf = 0; tf < tfs; tf++) {
+      for (const auto& entry : DigitSyncBenchmark::makeSyncRange(digitsFDD[tf], digitsFT0[tf], digitsFV0[tf])) {
+        checksumRange += consume(entry);
+      }
+    }
+  }
+  const double rangeDuration = timer.getTime();
+
+  if (checksumMap != checksumRange) {
+    std::cerr << "The checksums differ, the benchmark is not valid" << std::endl;
+    return 1;
+  }
+
+  const double synchronizedTFs = static_cast<double>(tfs * repetitions);
+  std::cout << "Interaction rate: " << interactionRate * 1e-3 << " kHz, orbits per TF: " << orbits
+            << ", digits per TF (FDD+FT0+FV0): " << static_cast<double>(totalDigits) / tfs << std::endl;
+  std::cout << std::setw(16) << std::left << "method"
+            << std::setw(16) << "us per TF"
+            << std::setw(20) << "ns per digit" << std::endl;
+  std::cout << std::setw(16) << std::left << "makeSyncMap"
+            << std::setw(16) << mapDuration / synchronizedTFs * 1e6
+            << std::setw(20) << mapDuration / (totalDigits * repetitions) * 1e9 << std::endl;
+  std::cout << std::setw(16) << std::left << "makeSyncRange"
+            << std::setw(16) << rangeDuration / synchronizedTFs * 1e6
+            << std::setw(20) << rangeDuration / (totalDigits * repetitions) * 1e9 << std::endl;
+  std::cout << "speedup: " << mapDuration / rangeDuration << std::endl;
+
+  return 0;
+}
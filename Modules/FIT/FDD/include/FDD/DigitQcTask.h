@@ -24,6 +24,7 @@
 #include <map>
 #include <vector>
 #include <array>
+#include <bitset>
 #include <boost/algorithm/string.hpp>
 
 #include "TH1.h"
@@ -41,6 +42,7 @@
 #include "QualityControl/TaskInterface.h"
 #include "FDDBase/Constants.h"
 #include "FITCommon/DetectorFIT.h"
+#include "FITCommon/ChannelBookkeeping.h"
 
 using namespace o2::quality_control::core;
 
@@ -123,7 +125,9 @@ class DigitQcTask final : public TaskInterface
   std::array<o2::InteractionRecord, sNCHANNELS_PM> mStateLastIR2Ch;
   std::array<uint8_t, sNCHANNELS_PM> mChID2PMhash; // map chID->hashed PM value
   uint8_t mTCMhash;                                // hash value for TCM, and bin position in hist
-  std::map<uint8_t, bool> mMapPMhash2isAside;
+  std::bitset<256> mPMhash2isAside;                // PM hash -> true for A side
+  // reused for each digit
+  o2::quality_control_modules::fit::FEEModulesOfDigit<> mFEEmodulesOfDigit;
 
   typename Detector_t::TrgMap_t mMapPMbits = Detector_t::sMapPMbits;
   typename Detector_t::TrgMap_t mMapTechTrgBits = Detector_t::sMapTechTrgBits;
@@ -175,7 +179,7 @@ class DigitQcTask final : public TaskInterface
 
   // Object which will be published
   std::unique_ptr<TH2F> mHist2CorrTCMchAndPMch;
-  std::map<unsigned int, TH1F*> mMapHistAmp1DCoincidence;
+  o2::quality_control_modules::fit::ChannelArray<sNCHANNELS_PM, TH1F*> mArrHistAmp1DCoincidence;
   std::map<std::string, TH2F*> mMapPmModuleBcOrbit;
   std::unique_ptr<TH2F> mHistAmp2Ch;
   std::unique_ptr<TH2F> mHistTime2Ch;
@@ -198,7 +202,7 @@ class DigitQcTask final : public TaskInterface
   std::unique_ptr<TH1D> mHistCycleDuration;
   std::unique_ptr<TH1D> mHistCycleDurationNTF;
   std::unique_ptr<TH1D> mHistCycleDurationRange;
-  std::map<unsigned int, TH2F*> mMapHistAmpVsTime;
+  o2::quality_control_modules::fit::ChannelArray<sNCHANNELS_PM, TH2F*> mArrHistAmpVsTime;
   std::unique_ptr<TH2F> mHistBCvsTrg;
   std::unique_ptr<TH2F> mHistBCvsFEEmodules;
   std::unique_ptr<TH2F> mHistOrbitVsTrg;
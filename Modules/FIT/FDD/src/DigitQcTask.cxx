@@ -269,10 +269,9 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
     const auto& strChID = lutEntry.mChannelID;
     const auto& pairIt = mapFEE2hash.insert({ moduleName, binPos });
     if (pairIt.second) {
-      if (moduleName.find("PMA") != std::string::npos)
-        mMapPMhash2isAside.insert({ binPos, true });
-      else if (moduleName.find("PMC") != std::string::npos)
-        mMapPMhash2isAside.insert({ binPos, false });
+      if (moduleName.find("PMA") != std::string::npos) {
+        mPMhash2isAside.set(binPos);
+      }
       binPos++;
     }
     if (std::regex_match(strChID, std::regex("[[\\d]{1,3}"))) {
@@ -338,18 +337,24 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   }
 
   for (const auto& chID : mSetAllowedChIDs) {
-    auto pairHistAmpCoincidence = mMapHistAmp1DCoincidence.insert({ chID, new TH1F(Form("Amp_channelCoincidence%i", chID), Form("AmplitudeCoincidence, channel %i", chID), 4200, -100, 4100) });
-    if (pairHistAmpCoincidence.second) {
-      getObjectsManager()->startPublishing(pairHistAmpCoincidence.first->second);
-      mListHistGarbage->Add(pairHistAmpCoincidence.first->second);
+    if (chID >= sNCHANNELS_PM) {
+      ILOG(Warning, Support) << "ChannelIDs: channel " << chID << " does not exist, ignored" << ENDM;
+      continue;
     }
+    auto histAmpCoincidence = new TH1F(Form("Amp_channelCoincidence%i", chID), Form("AmplitudeCoincidence, channel %i", chID), 4200, -100, 4100);
+    getObjectsManager()->startPublishing(histAmpCoincidence);
+    mListHistGarbage->Add(histAmpCoincidence);
+    mArrHistAmp1DCoincidence.set(chID, histAmpCoincidence);
   }
   for (const auto& chID : mSetAllowedChIDsAmpVsTime) {
-    auto pairHistAmpVsTime = mMapHistAmpVsTime.insert({ chID, new TH2F(Form("Amp_vs_time_channel%i", chID), Form("Amplitude vs time, channel %i;Amp;Time", chID), 420, -100, 4100, 410, -2050, 2050) });
-    if (pairHistAmpVsTime.second) {
-      mListHistGarbage->Add(pairHistAmpVsTime.first->second);
-      getObjectsManager()->startPublishing(pairHistAmpVsTime.first->second);
+    if (chID >= sNCHANNELS_PM) {
+      ILOG(Warning, Support) << "ChannelIDsAmpVsTime: channel " << chID << " does not exist, ignored" << ENDM;
+      continue;
     }
+    auto histAmpVsTime = new TH2F(Form("Amp_vs_time_channel%i", chID), Form("Amplitude vs time, channel %i;Amp;Time", chID), 420, -100, 4100, 410, -2050, 2050);
+    mListHistGarbage->Add(histAmpVsTime);
+    getObjectsManager()->startPublishing(histAmpVsTime);
+    mArrHistAmpVsTime.set(chID, histAmpVsTime);
   }
 
   rebinFromConfig(); // after all histos are created
@@ -458,12 +463,9 @@ void DigitQcTask::startOfActivity(const Activity& activity)
   mHistPmTcmAverageTimeC->Reset();
   mHistTriggersSw->Reset();
   mHistTriggersSoftwareVsTCM->Reset();
-  for (auto& entry : mMapHistAmp1DCoincidence) {
-    entry.second->Reset();
-  }
-  for (auto& entry : mMapHistAmpVsTime) {
-    entry.second->Reset();
-  }
+  auto resetHist = [](std::size_t, auto* hist) { hist->Reset(); };
+  mArrHistAmp1DCoincidence.forEach(resetHist);
+  mArrHistAmpVsTime.forEach(resetHist);
 }
 
 void DigitQcTask::startOfCycle()
@@ -511,14 +513,14 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     // Fill the amplitude, if there is a coincidence of the signals in in the front or back layers
     bool hasData[16] = { 0 };
     for (const auto& chData : vecChData) {
-      if (mSetAllowedChIDs.find(static_cast<unsigned int>(chData.mPMNumber)) != mSetAllowedChIDs.end()) {
+      if (mArrHistAmp1DCoincidence.contains(chData.mPMNumber)) {
         if (static_cast<int>(chData.mPMNumber) < 16) {
           hasData[static_cast<int>(chData.mPMNumber)] = 1;
         }
       }
     } // ak
 
-    std::set<uint8_t> setFEEmodules{};
+    mFEEmodulesOfDigit.clear();
     // reset triggers
     for (auto& entry : mMapTrgSoftware) {
       mMapTrgSoftware[entry.first] = false;
@@ -538,10 +540,6 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     // Initialize array elements to zero using std::fill
     std::fill(ChVertexArray.begin(), ChVertexArray.end(), 0);
 
-    std::map<uint8_t, int> mapPMhash2sumAmpl;
-    for (const auto& entry : mMapPMhash2isAside) {
-      mapPMhash2sumAmpl.insert({ entry.first, 0 });
-    }
     for (const auto& chData : vecChData) {
       if (static_cast<int>(chData.mPMNumber) < sNCHANNELS_C)
         mPMChargeTotalCside += chData.mChargeADC;
@@ -557,72 +555,72 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
         mHistNumADC->Fill(chData.mPMNumber);
       }
       mHistNumCFD->Fill(chData.mPMNumber);
-      if (mSetAllowedChIDs.size() != 0 && mSetAllowedChIDs.find(static_cast<unsigned int>(chData.mPMNumber)) != mSetAllowedChIDs.end()) {
+      if (mArrHistAmp1DCoincidence.contains(chData.mPMNumber)) {
         if (static_cast<int>(chData.mPMNumber) == 0 && hasData[4]) {
-          mMapHistAmp1DCoincidence[0]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[0]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 1 && hasData[5]) {
-          mMapHistAmp1DCoincidence[1]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[1]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 2 && hasData[6]) {
-          mMapHistAmp1DCoincidence[2]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[2]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 3 && hasData[7]) {
-          mMapHistAmp1DCoincidence[3]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[3]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 4 && hasData[0]) {
-          mMapHistAmp1DCoincidence[4]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[4]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 5 && hasData[1]) {
-          mMapHistAmp1DCoincidence[5]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[5]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 6 && hasData[2]) {
-          mMapHistAmp1DCoincidence[6]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[6]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 7 && hasData[3]) {
-          mMapHistAmp1DCoincidence[7]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[7]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 8 && hasData[12]) {
-          mMapHistAmp1DCoincidence[8]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[8]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 9 && hasData[13]) {
-          mMapHistAmp1DCoincidence[9]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[9]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 10 && hasData[14]) {
-          mMapHistAmp1DCoincidence[10]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[10]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 11 && hasData[15]) {
-          mMapHistAmp1DCoincidence[11]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[11]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 12 && hasData[8]) {
-          mMapHistAmp1DCoincidence[12]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[12]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 13 && hasData[9]) {
-          mMapHistAmp1DCoincidence[13]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[13]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 14 && hasData[10]) {
-          mMapHistAmp1DCoincidence[14]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[14]->Fill(chData.mChargeADC);
         }
         if (static_cast<int>(chData.mPMNumber) == 15 && hasData[11]) {
-          mMapHistAmp1DCoincidence[15]->Fill(chData.mChargeADC);
+          mArrHistAmp1DCoincidence[15]->Fill(chData.mChargeADC);
         }
       }
-      if (mSetAllowedChIDsAmpVsTime.size() != 0 && mSetAllowedChIDsAmpVsTime.find(static_cast<unsigned int>(chData.mPMNumber)) != mSetAllowedChIDsAmpVsTime.end()) {
-        mMapHistAmpVsTime[chData.mPMNumber]->Fill(chData.mChargeADC, chData.mTime);
+      if (mArrHistAmpVsTime.contains(chData.mPMNumber)) {
+        mArrHistAmpVsTime[chData.mPMNumber]->Fill(chData.mChargeADC, chData.mTime);
       }
       for (const auto& binPos : mHashedBitBinPos[chData.mFEEBits]) {
         mHistChDataBits->Fill(chData.mPMNumber, binPos);
       }
 
-      setFEEmodules.insert(mChID2PMhash[chData.mPMNumber]);
+      mFEEmodulesOfDigit.setFired(mChID2PMhash[chData.mPMNumber]);
 
       if (chIsVertexEvent(chData, true)) {
-        if (!mMapPMhash2isAside[mChID2PMhash[static_cast<uint8_t>(chData.mPMNumber)]]) {
+        if (!mPMhash2isAside.test(mChID2PMhash[static_cast<uint8_t>(chData.mPMNumber)])) {
           pmSumTimeC += chData.mTime;
           pmNChanC++;
           if ((int)chData.mPMNumber < sNCHANNELS_Physics)
             ChVertexArray[chData.mPMNumber] = 1;
-        } else if (mMapPMhash2isAside[mChID2PMhash[static_cast<uint8_t>(chData.mPMNumber)]]) {
+        } else {
           pmSumTimeA += chData.mTime;
           pmNChanA++;
           if ((int)chData.mPMNumber < sNCHANNELS_Physics)
@@ -639,16 +637,16 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
       }
 
       if (chData.getFlag(o2::fdd::ChannelData::kIsCFDinADCgate)) {
-        mapPMhash2sumAmpl[mChID2PMhash[static_cast<uint8_t>(chData.mPMNumber)]] += static_cast<Int_t>(chData.mChargeADC);
+        mFEEmodulesOfDigit.addAmplitude(mChID2PMhash[static_cast<uint8_t>(chData.mPMNumber)], static_cast<Int_t>(chData.mChargeADC));
       }
     }
 
-    for (const auto& entry : mapPMhash2sumAmpl) {
-      if (mMapPMhash2isAside[entry.first])
-        pmSumAmplA += static_cast<int>(entry.second >> 3);
+    mFEEmodulesOfDigit.forEachAmplitude([&](uint8_t pmHash, int sumAmpl) {
+      if (mPMhash2isAside.test(pmHash))
+        pmSumAmplA += static_cast<int>(sumAmpl >> 3);
       else
-        pmSumAmplC += static_cast<int>(entry.second >> 3);
-    }
+        pmSumAmplC += static_cast<int>(sumAmpl >> 3);
+    });
     auto pmNChan = pmNChanA + pmNChanC;
     auto pmSumAmpl = pmSumAmplA + pmSumAmplC;
     if (isTCM) {
@@ -671,15 +669,15 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     mPMChargeTotalCside = static_cast<int>(mPMChargeTotalCside >> 3);
 
     if (isTCM) {
-      setFEEmodules.insert(mTCMhash);
+      mFEEmodulesOfDigit.setFired(mTCMhash);
       mHist2CorrTCMchAndPMch->Fill(digit.mTriggers.getAmplA() + digit.mTriggers.getAmplC(), (digit.mTriggers.getAmplA() + digit.mTriggers.getAmplC()) - (mPMChargeTotalAside + mPMChargeTotalCside));
     }
-    for (const auto& feeHash : setFEEmodules) {
+    mFEEmodulesOfDigit.forEachFired([&](uint8_t feeHash) {
       mHistBCvsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
       mHistOrbitVsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().orbit % sOrbitsPerTF), static_cast<double>(feeHash));
       if (digit.mTriggers.getVertex())
         mHistBcVsFeeForVtxTrg->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
-    }
+    });
 
     if (isTCM && digit.mTriggers.getDataIsValid() && !digit.mTriggers.getOutputsAreBlocked()) {
       if (digit.mTriggers.getNChanA() > 0) {
@@ -918,12 +916,9 @@ void DigitQcTask::reset()
   mHistPmTcmAverageTimeC->Reset();
   mHistTriggersSw->Reset();
   mHistTriggersSoftwareVsTCM->Reset();
-  for (auto& entry : mMapHistAmp1DCoincidence) {
-    entry.second->Reset();
-  }
-  for (auto& entry : mMapHistAmpVsTime) {
-    entry.second->Reset();
-  }
+  auto resetHist = [](std::size_t, auto* hist) { hist->Reset(); };
+  mArrHistAmp1DCoincidence.forEach(resetHist);
+  mArrHistAmpVsTime.forEach(resetHist);
 }
 
 } // namespace o2::quality_control_modules::fdd
@@ -99,9 +99,8 @@ void RecoFITQcTask::monitorData(o2::framework::ProcessingContext& ctx)
   const auto& vecChannelsFV0 = mIsFV0 ? ctx.inputs().get<gsl::span<o2::fv0::ChannelDataFloat>>("channelsFV0") : gsl::span<o2::fv0::ChannelDataFloat>{};
   const auto& vecRecPointsFV0 = mIsFV0 ? ctx.inputs().get<gsl::span<o2::fv0::RecPoints>>("recPointsFV0") : gsl::span<o2::fv0::RecPoints>{};
 
-  const auto& mapDigitSync = DigitSyncFIT::makeSyncMap(vecRecPointsFDD, vecRecPointsFT0, vecRecPointsFV0);
   const auto start = std::chrono::high_resolution_clock::now();
-  for (const auto& entry : mapDigitSync) {
+  auto processEntry = [&](const auto& entry) {
     const o2::InteractionRecord& ir = entry.first;
     const auto& digitSync = entry.second;
     const auto& recPointsFDD = digitSync.getDigitFDD(vecRecPointsFDD); // o2::fdd::RecPoint
@@ -131,6 +130,16 @@ void RecoFITQcTask::monitorData(o2::framework::ProcessingContext& ctx)
         mHistTrgCorrelationFT0_FV0->Fill(ir.bc, trgCorrStatusFT0_FV0);
       }
     }
+  };
+  // the reconstructed points of a TF are ordered by IR, the map is only needed if it is not the case
+  if (DigitSyncFIT::isSorted(vecRecPointsFDD) && DigitSyncFIT::isSorted(vecRecPointsFT0) && DigitSyncFIT::isSorted(vecRecPointsFV0)) {
+    for (const auto& entry : DigitSyncFIT::makeSyncRange(vecRecPointsFDD, vecRecPointsFT0, vecRecPointsFV0)) {
+      processEntry(entry);
+    }
+  } else {
+    for (const auto& entry : DigitSyncFIT::makeSyncMap(vecRecPointsFDD, vecRecPointsFT0, vecRecPointsFV0)) {
+      processEntry(entry);
+    }
   }
   const auto stop = std::chrono::high_resolution_clock::now();
   const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
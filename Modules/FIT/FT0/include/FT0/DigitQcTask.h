@@ -24,6 +24,7 @@
 #include <map>
 #include <vector>
 #include <array>
+#include <bitset>
 #include <boost/algorithm/string.hpp>
 
 #include "TH1.h"
@@ -42,6 +43,7 @@
 #include "DataFormatsFT0/ChannelData.h"
 #include "FITCommon/DetectorFIT.h"
 #include "FITCommon/HelperFIT.h"
+#include "FITCommon/ChannelBookkeeping.h"
 
 using namespace o2::quality_control::core;
 
@@ -94,7 +96,9 @@ class DigitQcTask final : public TaskInterface
   std::array<o2::InteractionRecord, sNCHANNELS_PM> mStateLastIR2Ch;
   std::array<uint8_t, sNCHANNELS_PM> mChID2PMhash; // map chID->hashed PM value
   uint8_t mTCMhash;                                // hash value for TCM, and bin position in hist
-  std::map<uint8_t, bool> mMapPMhash2isAside;
+  std::bitset<256> mPMhash2isAside;                // PM hash -> true for A side
+  // reused for each digit
+  o2::quality_control_modules::fit::FEEModulesOfDigit<> mFEEmodulesOfDigit;
   typename Detector_t::TrgMap_t mMapPMbits = Detector_t::sMapPMbits;
   typename Detector_t::TrgMap_t mMapTechTrgBitsExtra = Detector_t::sMapTechTrgBitsExtra;
   typename Detector_t::TrgMap_t mMapTrgBits = Detector_t::sMapTrgBits;
@@ -129,10 +133,10 @@ class DigitQcTask final : public TaskInterface
   std::unique_ptr<TH1D> mHistCycleDuration;
   std::unique_ptr<TH1D> mHistCycleDurationNTF;
   std::unique_ptr<TH1D> mHistCycleDurationRange;
-  std::map<unsigned int, TH1F*> mMapHistAmp1D;
-  std::map<unsigned int, TH1F*> mMapHistTime1D;
-  std::map<unsigned int, TH1F*> mMapHistPMbits;
-  std::map<unsigned int, TH2F*> mMapHistAmpVsTime;
+  o2::quality_control_modules::fit::ChannelArray<sNCHANNELS_PM, TH1F*> mArrHistAmp1D;
+  o2::quality_control_modules::fit::ChannelArray<sNCHANNELS_PM, TH1F*> mArrHistTime1D;
+  o2::quality_control_modules::fit::ChannelArray<sNCHANNELS_PM, TH1F*> mArrHistPMbits;
+  o2::quality_control_modules::fit::ChannelArray<sNCHANNELS_PM, TH2F*> mArrHistAmpVsTime;
   std::unique_ptr<TH2F> mHistBCvsTrg;
   std::unique_ptr<TH2F> mHistBCvsFEEmodules;
   std::unique_ptr<TH2F> mHistOrbitVsTrg;
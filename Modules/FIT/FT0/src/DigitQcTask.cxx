@@ -27,6 +27,7 @@
 
 #include "FITCommon/HelperHist.h"
 #include "FITCommon/HelperCommon.h"
+#include "FITCommon/ChannelBookkeeping.h"
 
 namespace o2::quality_control_modules::ft0
 {
@@ -137,10 +138,9 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
     const auto& strChID = lutEntry.mChannelID;
     const auto& pairIt = mapFEE2hash.insert({ moduleName, binPos });
     if (pairIt.second) {
-      if (moduleName.find("PMA") != std::string::npos)
-        mMapPMhash2isAside.insert({ binPos, true });
-      else if (moduleName.find("PMC") != std::string::npos)
-        mMapPMhash2isAside.insert({ binPos, false });
+      if (moduleName.find("PMA") != std::string::npos) {
+        mPMhash2isAside.set(binPos);
+      }
       binPos++;
     }
     if (std::regex_match(strChID, std::regex("[\\d]{1,3}"))) {
@@ -197,31 +197,33 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   }
 
   for (const auto& chID : mSetAllowedChIDs) {
-    auto pairHistAmp = mMapHistAmp1D.insert({ chID, new TH1F(Form("Amp_channel%i", chID), Form("Amplitude, channel %i", chID), 4200, -100, 4100) });
-    auto pairHistTime = mMapHistTime1D.insert({ chID, new TH1F(Form("Time_channel%i", chID), Form("Time, channel %i", chID), 4100, -2050, 2050) });
-    auto pairHistBits = mMapHistPMbits.insert({ chID, new TH1F(Form("Bits_channel%i", chID), Form("Bits, channel %i", chID), mMapPMbits.size(), 0, mMapPMbits.size()) });
-    for (const auto& entry : mMapPMbits) {
-      pairHistBits.first->second->GetXaxis()->SetBinLabel(entry.first + 1, entry.second.c_str());
+    if (chID >= sNCHANNELS_PM) {
+      ILOG(Warning, Support) << "ChannelIDs: channel " << chID << " does not exist, ignored" << ENDM;
+      continue;
     }
-    if (pairHistAmp.second) {
-      getObjectsManager()->startPublishing(pairHistAmp.first->second);
-      mListHistGarbage->Add(pairHistAmp.first->second);
-    }
-    if (pairHistTime.second) {
-      mListHistGarbage->Add(pairHistTime.first->second);
-      getObjectsManager()->startPublishing(pairHistTime.first->second);
+    auto histAmp = new TH1F(Form("Amp_channel%i", chID), Form("Amplitude, channel %i", chID), 4200, -100, 4100);
+    auto histTime = new TH1F(Form("Time_channel%i", chID), Form("Time, channel %i", chID), 4100, -2050, 2050);
+    auto histBits = new TH1F(Form("Bits_channel%i", chID), Form("Bits, channel %i", chID), mMapPMbits.size(), 0, mMapPMbits.size());
+    for (const auto& entry : mMapPMbits) {
+      histBits->GetXaxis()->SetBinLabel(entry.first + 1, entry.second.c_str());
     }
-    if (pairHistBits.second) {
-      mListHistGarbage->Add(pairHistBits.first->second);
-      getObjectsManager()->startPublishing(pairHistBits.first->second);
+    for (auto hist : { histAmp, histTime, histBits }) {
+      mListHistGarbage->Add(hist);
+      getObjectsManager()->startPublishing(hist);
     }
+    mArrHistAmp1D.set(chID, histAmp);
+    mArrHistTime1D.set(chID, histTime);
+    mArrHistPMbits.set(chID, histBits);
   }
   for (const auto& chID : mSetAllowedChIDsAmpVsTime) {
-    auto pairHistAmpVsTime = mMapHistAmpVsTime.insert({ chID, new TH2F(Form("Amp_vs_time_channel%i", chID), Form("Amplitude vs time, channel %i;Amp;Time", chID), 420, -100, 4100, 410, -2050, 2050) });
-    if (pairHistAmpVsTime.second) {
-      mListHistGarbage->Add(pairHistAmpVsTime.first->second);
-      getObjectsManager()->startPublishing(pairHistAmpVsTime.first->second);
+    if (chID >= sNCHANNELS_PM) {
+      ILOG(Warning, Support) << "ChannelIDsAmpVsTime: channel " << chID << " does not exist, ignored" << ENDM;
+      continue;
     }
+    auto histAmpVsTime = new TH2F(Form("Amp_vs_time_channel%i", chID), Form("Amplitude vs time, channel %i;Amp;Time", chID), 420, -100, 4100, 410, -2050, 2050);
+    mListHistGarbage->Add(histAmpVsTime);
+    getObjectsManager()->startPublishing(histAmpVsTime);
+    mArrHistAmpVsTime.set(chID, histAmpVsTime);
   }
 
   rebinFromConfig(); // after all histos are created
@@ -275,18 +277,11 @@ void DigitQcTask::startOfActivity(const Activity& activity)
   mHistPmTcmAverageTimeC->Reset();
   mHistTriggersSoftwareVsTCM->Reset();
   mHistChIDperBC->Reset();
-  for (auto& entry : mMapHistAmp1D) {
-    entry.second->Reset();
-  }
-  for (auto& entry : mMapHistTime1D) {
-    entry.second->Reset();
-  }
-  for (auto& entry : mMapHistPMbits) {
-    entry.second->Reset();
-  }
-  for (auto& entry : mMapHistAmpVsTime) {
-    entry.second->Reset();
-  }
+  auto resetHist = [](std::size_t, auto* hist) { hist->Reset(); };
+  mArrHistAmp1D.forEach(resetHist);
+  mArrHistTime1D.forEach(resetHist);
+  mArrHistPMbits.forEach(resetHist);
+  mArrHistAmpVsTime.forEach(resetHist);
 }
 
 void DigitQcTask::startOfCycle()
@@ -325,7 +320,7 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     mHistOrbit2BC->Fill(digit.getIntRecord().orbit % sOrbitsPerTF, digit.getIntRecord().bc);
     mHistBC->Fill(digit.getBC());
 
-    std::set<uint8_t> setFEEmodules{};
+    mFEEmodulesOfDigit.clear();
 
     int32_t pmSumAmplA = 0;
     int32_t pmSumAmplC = 0;
@@ -336,54 +331,48 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     int pmAverTimeA{ 0 };
     int pmAverTimeC{ 0 };
 
-    std::map<uint8_t, int> mapPMhash2sumAmpl;
-    for (const auto& entry : mMapPMhash2isAside) {
-      mapPMhash2sumAmpl.insert({ entry.first, 0 });
-    }
     for (const auto& chData : vecChData) {
       mHistTime2Ch->Fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.CFDTime));
       mHistAmp2Ch->Fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.QTCAmpl));
       mStateLastIR2Ch[chData.ChId] = digit.mIntRecord;
       mHistChannelID->Fill(chData.ChId);
-      if (mSetAllowedChIDs.size() != 0 && mSetAllowedChIDs.find(static_cast<unsigned int>(chData.ChId)) != mSetAllowedChIDs.end()) {
-        mMapHistAmp1D[chData.ChId]->Fill(chData.QTCAmpl);
-        mMapHistTime1D[chData.ChId]->Fill(chData.CFDTime);
-        for (const auto& entry : mMapPMbits) {
-          if ((chData.ChainQTC & (1 << entry.first))) {
-            mMapHistPMbits[chData.ChId]->Fill(entry.first);
-          }
+      if (mArrHistAmp1D.contains(chData.ChId)) {
+        mArrHistAmp1D[chData.ChId]->Fill(chData.QTCAmpl);
+        mArrHistTime1D[chData.ChId]->Fill(chData.CFDTime);
+        for (const auto& binPos : mHashedBitBinPos[chData.ChainQTC]) {
+          mArrHistPMbits[chData.ChId]->Fill(binPos);
         }
       }
-      if (mSetAllowedChIDsAmpVsTime.size() != 0 && mSetAllowedChIDsAmpVsTime.find(static_cast<unsigned int>(chData.ChId)) != mSetAllowedChIDsAmpVsTime.end()) {
-        mMapHistAmpVsTime[chData.ChId]->Fill(chData.QTCAmpl, chData.CFDTime);
+      if (mArrHistAmpVsTime.contains(chData.ChId)) {
+        mArrHistAmpVsTime[chData.ChId]->Fill(chData.QTCAmpl, chData.CFDTime);
       }
       for (const auto& binPos : mHashedBitBinPos[chData.ChainQTC]) {
         mHistChDataBits->Fill(chData.ChId, binPos);
       }
 
-      setFEEmodules.insert(mChID2PMhash[chData.ChId]);
+      mFEEmodulesOfDigit.setFired(mChID2PMhash[chData.ChId]);
 
       if (((chData.ChainQTC & mPMbitsToCheck_ChID) == mGoodPMbits_ChID) && std::abs(static_cast<Int_t>(chData.CFDTime)) < mTrgValidation.mTrgOrGate) {
-        if (!mMapPMhash2isAside[mChID2PMhash[static_cast<uint8_t>(chData.ChId)]]) {
+        if (!mPMhash2isAside.test(mChID2PMhash[static_cast<uint8_t>(chData.ChId)])) {
           pmSumTimeC += chData.CFDTime;
           pmNChanC++;
-        } else if (mMapPMhash2isAside[mChID2PMhash[static_cast<uint8_t>(chData.ChId)]]) {
+        } else {
           pmSumTimeA += chData.CFDTime;
           pmNChanA++;
         }
         mHistChIDperBC->Fill(digit.getBC(), chData.ChId);
       }
       if (chData.getFlag(o2::ft0::ChannelData::kIsCFDinADCgate)) {
-        mapPMhash2sumAmpl[mChID2PMhash[static_cast<uint8_t>(chData.ChId)]] += static_cast<Int_t>(chData.QTCAmpl);
+        mFEEmodulesOfDigit.addAmplitude(mChID2PMhash[static_cast<uint8_t>(chData.ChId)], static_cast<Int_t>(chData.QTCAmpl));
       }
     }
 
-    for (const auto& entry : mapPMhash2sumAmpl) {
-      if (mMapPMhash2isAside[entry.first])
-        pmSumAmplA += (entry.second >> 3);
+    mFEEmodulesOfDigit.forEachAmplitude([&](uint8_t pmHash, int sumAmpl) {
+      if (mPMhash2isAside.test(pmHash))
+        pmSumAmplA += (sumAmpl >> 3);
       else
-        pmSumAmplC += (entry.second >> 3);
-    }
+        pmSumAmplC += (sumAmpl >> 3);
+    });
 
     if (isTCM) {
       if (pmNChanA > 1) {
@@ -400,7 +389,7 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
       } else {
         pmAverTimeC = 0;
       }
-      setFEEmodules.insert(mTCMhash);
+      mFEEmodulesOfDigit.setFired(mTCMhash);
 
     } else {
       pmAverTimeA = o2::fit::Triggers::DEFAULT_TIME;
@@ -408,10 +397,10 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
     auto vtxPos = (pmNChanA && pmNChanC) ? (pmAverTimeC - pmAverTimeA) / 2 : 0;
 
-    for (const auto& feeHash : setFEEmodules) {
+    mFEEmodulesOfDigit.forEachFired([&](uint8_t feeHash) {
       mHistBCvsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
       mHistOrbitVsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().orbit % sOrbitsPerTF), static_cast<double>(feeHash));
-    }
+    });
 
     if (isTCM && digit.mTriggers.getDataIsValid() && !digit.mTriggers.getOutputsAreBlocked()) {
       if (digit.mTriggers.getNChanA() > 0) {
@@ -434,18 +423,19 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
       mHistTimeSum2Diff->Fill((digit.mTriggers.getTimeC() - digit.mTriggers.getTimeA()) * sCFDChannel2NS / 2, (digit.mTriggers.getTimeC() + digit.mTriggers.getTimeA()) * sCFDChannel2NS / 2);
     }
     if (isTCM) {
-      std::vector<unsigned int> vecTrgWords{};
+      std::array<unsigned int, 64> arrTrgBits{}; // the extended trigger word has 64 bits at most
+      std::size_t nTrgBits = 0;
       const uint64_t trgWordExt = digit.mTriggers.getExtendedTrgWordFT0();
       for (const auto& entry : mMapTechTrgBitsExtra) {
         const auto& trgBit = entry.first;
         if (((1 << trgBit) & trgWordExt) > 0) {
           mHistTriggersCorrelation->Fill(trgBit, trgBit);
-          for (const auto& prevTrgBit : vecTrgWords) {
-            mHistTriggersCorrelation->Fill(trgBit, prevTrgBit);
+          for (std::size_t iPrevTrgBit = 0; iPrevTrgBit < nTrgBits; iPrevTrgBit++) {
+            mHistTriggersCorrelation->Fill(trgBit, arrTrgBits[iPrevTrgBit]);
           }
           mHistBCvsTrg->Fill(digit.getIntRecord().bc, trgBit);
           mHistOrbitVsTrg->Fill(digit.getIntRecord().orbit % sOrbitsPerTF, trgBit);
-          vecTrgWords.push_back(trgBit);
+          arrTrgBits[nTrgBits++] = trgBit;
         }
       }
     }
@@ -516,18 +506,11 @@ void DigitQcTask::reset()
   mHistPmTcmAverageTimeC->Reset();
   mHistTriggersSoftwareVsTCM->Reset();
   mHistChIDperBC->Reset();
-  for (auto& entry : mMapHistAmp1D) {
-    entry.second->Reset();
-  }
-  for (auto& entry : mMapHistTime1D) {
-    entry.second->Reset();
-  }
-  for (auto& entry : mMapHistPMbits) {
-    entry.second->Reset();
-  }
-  for (auto& entry : mMapHistAmpVsTime) {
-    entry.second->Reset();
-  }
+  auto resetHist = [](std::size_t, auto* hist) { hist->Reset(); };
+  mArrHistAmp1D.forEach(resetHist);
+  mArrHistTime1D.forEach(resetHist);
+  mArrHistPMbits.forEach(resetHist);
+  mArrHistAmpVsTime.forEach(resetHist);
 }
 
 } // namespace o2::quality_control_modules::ft0
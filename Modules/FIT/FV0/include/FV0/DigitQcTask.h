@@ -24,6 +24,7 @@
 #include <map>
 #include <vector>
 #include <array>
+#include <bitset>
 #include <boost/algorithm/string.hpp>
 
 #include "TH1.h"
@@ -41,6 +42,7 @@
 #include "DataFormatsFV0/ChannelData.h"
 
 #include "FITCommon/DetectorFIT.h"
+#include "FITCommon/ChannelBookkeeping.h"
 
 using namespace o2::quality_control::core;
 
@@ -119,7 +121,9 @@ class DigitQcTask final : public TaskInterface
   std::array<o2::InteractionRecord, sNCHANNELS_FV0_PLUSREF> mStateLastIR2Ch;
   std::array<uint8_t, sNCHANNELS_FV0_PLUSREF> mChID2PMhash; // map chID->hashed PM value
   uint8_t mTCMhash;                                         // hash value for TCM, and bin position in hist
-  std::map<uint8_t, bool> mMapPMhash2isInner;
+  std::bitset<256> mPMhash2isInner;                         // PM hash -> true for the inner rings
+  // reused for each digit
+  o2::quality_control_modules::fit::FEEModulesOfDigit<> mFEEmodulesOfDigit;
 
   typename Detector_t::TrgMap_t mMapPMbits = Detector_t::sMapPMbits;
   typename Detector_t::TrgMap_t mMapTechTrgBits = Detector_t::sMapTechTrgBits;
@@ -176,7 +180,7 @@ class DigitQcTask final : public TaskInterface
   std::unique_ptr<TH1D> mHistCycleDuration;
   std::unique_ptr<TH1D> mHistCycleDurationNTF;
   std::unique_ptr<TH1D> mHistCycleDurationRange;
-  std::map<unsigned int, TH2F*> mMapHistAmpVsTime;
+  o2::quality_control_modules::fit::ChannelArray<sNCHANNELS_FV0_PLUSREF, TH2F*> mArrHistAmpVsTime;
   std::unique_ptr<TH2F> mHistBCvsTrg;
   std::unique_ptr<TH2F> mHistBCvsFEEmodules;
   std::unique_ptr<TH2F> mHistBcVsFeeForOrATrg;
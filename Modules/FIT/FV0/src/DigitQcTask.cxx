@@ -232,6 +232,7 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   auto lutSorted = lut;
   std::sort(lutSorted.begin(), lutSorted.end(), [](const auto& first, const auto& second) { return first.mModuleName < second.mModuleName; });
   uint8_t binPos{ 0 };
+  std::bitset<256> isPMhashInitialized{}; // the first channel of a PM decides if it is inner or outer
   for (const auto& lutEntry : lutSorted) {
     const auto& moduleName = lutEntry.mModuleName;
     const auto& moduleType = lutEntry.mModuleType;
@@ -244,7 +245,10 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
       int chID = std::stoi(strChID);
       if (chID < sNCHANNELS_FV0_PLUSREF) {
         mChID2PMhash[chID] = mapFEE2hash[moduleName];
-        mMapPMhash2isInner.insert({ mapFEE2hash[moduleName], chID < sNCHANNELS_FV0_INNER });
+        if (!isPMhashInitialized.test(mapFEE2hash[moduleName])) {
+          isPMhashInitialized.set(mapFEE2hash[moduleName]);
+          mPMhash2isInner.set(mapFEE2hash[moduleName], chID < sNCHANNELS_FV0_INNER);
+        }
       } else {
         LOG(error) << "Incorrect LUT entry: chID " << strChID << " | " << moduleName;
       }
@@ -307,11 +311,14 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   }
 
   for (const auto& chID : mSetAllowedChIDsAmpVsTime) {
-    auto pairHistAmpVsTime = mMapHistAmpVsTime.insert({ chID, new TH2F(Form("Amp_vs_time_channel%i", chID), Form("Amplitude vs time, channel %i;Amp;Time", chID), 420, -100, 4100, 410, -2050, 2050) });
-    if (pairHistAmpVsTime.second) {
-      mListHistGarbage->Add(pairHistAmpVsTime.first->second);
-      getObjectsManager()->startPublishing(pairHistAmpVsTime.first->second);
+    if (chID >= sNCHANNELS_FV0_PLUSREF) {
+      ILOG(Warning, Support) << "ChannelIDsAmpVsTime: channel " << chID << " does not exist, ignored" << ENDM;
+      continue;
     }
+    auto histAmpVsTime = new TH2F(Form("Amp_vs_time_channel%i", chID), Form("Amplitude vs time, channel %i;Amp;Time", chID), 420, -100, 4100, 410, -2050, 2050);
+    mListHistGarbage->Add(histAmpVsTime);
+    getObjectsManager()->startPublishing(histAmpVsTime);
+    mArrHistAmpVsTime.set(chID, histAmpVsTime);
   }
 
   rebinFromConfig(); // after all histos are created
@@ -418,9 +425,7 @@ void DigitQcTask::startOfActivity(const Activity& activity)
   mHistPmTcmAverageTimeA->Reset();
   mHistTriggersSw->Reset();
   mHistTriggersSoftwareVsTCM->Reset();
-  for (auto& entry : mMapHistAmpVsTime) {
-    entry.second->Reset();
-  }
+  mArrHistAmpVsTime.forEach([](std::size_t, TH2F* hist) { hist->Reset(); });
 }
 
 void DigitQcTask::startOfCycle()
@@ -463,7 +468,7 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     mHistOrbit2BC->Fill(digit.getIntRecord().orbit % sOrbitsPerTF, digit.getIntRecord().bc);
     mHistBC->Fill(digit.getBC());
 
-    std::set<uint8_t> setFEEmodules{};
+    mFEEmodulesOfDigit.clear();
     // reset triggers
     for (auto& entry : mMapTrgSoftware) {
       mMapTrgSoftware[entry.first] = false;
@@ -475,11 +480,6 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     Int_t pmSumTime = 0;
     Int_t pmAverTime = 0;
 
-    std::map<uint8_t, int> mapPMhash2sumAmpl;
-    for (const auto& entry : mMapPMhash2isInner) {
-      mapPMhash2sumAmpl.insert({ entry.first, 0 });
-    }
-
     for (const auto& chData : vecChData) {
       mHistTime2Ch->Fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.CFDTime));
       mHistAmp2Ch->Fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.QTCAmpl));
@@ -490,14 +490,14 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
         mHistNumADC->Fill(chData.ChId);
       }
       mHistNumCFD->Fill(chData.ChId);
-      if (mSetAllowedChIDsAmpVsTime.size() != 0 && mSetAllowedChIDsAmpVsTime.find(static_cast<unsigned int>(chData.ChId)) != mSetAllowedChIDsAmpVsTime.end()) {
-        mMapHistAmpVsTime[chData.ChId]->Fill(chData.QTCAmpl, chData.CFDTime);
+      if (mArrHistAmpVsTime.contains(chData.ChId)) {
+        mArrHistAmpVsTime[chData.ChId]->Fill(chData.QTCAmpl, chData.CFDTime);
       }
       for (const auto& binPos : mHashedBitBinPos[chData.ChainQTC]) {
         mHistChDataBits->Fill(chData.ChId, binPos);
       }
 
-      setFEEmodules.insert(mChID2PMhash[chData.ChId]);
+      mFEEmodulesOfDigit.setFired(mChID2PMhash[chData.ChId]);
 
       if (chData.ChId >= sNCHANNELS_FV0) { // skip reference PMT
         continue;
@@ -512,16 +512,16 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
         }
       }
       if (chData.getFlag(o2::fv0::ChannelData::kIsCFDinADCgate)) {
-        mapPMhash2sumAmpl[mChID2PMhash[static_cast<uint8_t>(chData.ChId)]] += static_cast<Int_t>(chData.QTCAmpl);
+        mFEEmodulesOfDigit.addAmplitude(mChID2PMhash[static_cast<uint8_t>(chData.ChId)], static_cast<Int_t>(chData.QTCAmpl));
       }
     } // channel data loop
 
-    for (const auto& entry : mapPMhash2sumAmpl) {
-      if (mMapPMhash2isInner[entry.first])
-        pmSumAmplIn += static_cast<int>(entry.second >> 3);
+    mFEEmodulesOfDigit.forEachAmplitude([&](uint8_t pmHash, int sumAmpl) {
+      if (mPMhash2isInner.test(pmHash))
+        pmSumAmplIn += static_cast<int>(sumAmpl >> 3);
       else
-        pmSumAmplOut += static_cast<int>(entry.second >> 3);
-    }
+        pmSumAmplOut += static_cast<int>(sumAmpl >> 3);
+    });
 
     auto pmNChan = pmNChanIn + pmNChanOut;
     auto pmSumAmpl = pmSumAmplIn + pmSumAmplOut;
@@ -532,9 +532,9 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
 
     if (isTCM) {
-      setFEEmodules.insert(mTCMhash);
+      mFEEmodulesOfDigit.setFired(mTCMhash);
     }
-    for (const auto& feeHash : setFEEmodules) {
+    mFEEmodulesOfDigit.forEachFired([&](uint8_t feeHash) {
       mHistBCvsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
       if (digit.mTriggers.getOrA())
         mHistBcVsFeeForOrATrg->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
@@ -547,7 +547,7 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
       if (digit.mTriggers.getOrAIn())
         mHistBcVsFeeForOrAInTrg->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
       mHistOrbitVsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().orbit % sOrbitsPerTF), static_cast<double>(feeHash));
-    }
+    });
 
     if (isTCM && digit.mTriggers.getDataIsValid() && !digit.mTriggers.getOutputsAreBlocked()) {
       if (digit.mTriggers.getNChanA() > 0) {
@@ -707,9 +707,7 @@ void DigitQcTask::reset()
   mHistPmTcmAverageTimeA->Reset();
   mHistTriggersSw->Reset();
   mHistTriggersSoftwareVsTCM->Reset();
-  for (auto& entry : mMapHistAmpVsTime) {
-    entry.second->Reset();
-  }
+  mArrHistAmpVsTime.forEach([](std::size_t, TH2F* hist) { hist->Reset(); });
 }
 
 } // namespace o2::quality_control_modules::fv0
@@ -18,6 +18,7 @@
 #define QC_MODULE_ITS_ITSCLUSTERTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/HistogramShards.h"
 #include "Common/TH2Ratio.h"
 
 #include <DataFormatsITSMFT/TopologyDictionary.h>
@@ -56,6 +57,7 @@ class ITSClusterTask : public TaskInterface
 
  private:
   void publishHistos();
+  void createHistoShards();
   template <class T>
   void formatAxes(T* obj, const char* xTitle, const char* yTitle, float xOffset, float yOffset)
   {
@@ -105,6 +107,9 @@ class ITSClusterTask : public TaskInterface
   TH2D* hClusterVsBunchCrossing = nullptr;
   std::unique_ptr<TH2DRatio> mGeneralOccupancy = nullptr;
 
+  // per-thread copies of the histograms filled in parallel
+  o2::quality_control::core::HistogramShards mShards;
+
   // Fine checks
 
   std::shared_ptr<TH2DRatio> hAverageClusterOccupancySummaryFine[NLayer];
@@ -19,6 +19,7 @@
 #define QC_MODULE_ITS_ITSFHRTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/HistogramShards.h"
 #include <ITSMFTReconstruction/ChipMappingITS.h>
 #include <ITSMFTReconstruction/PixelData.h>
 #include <ITSBase/GeometryTGeo.h>
@@ -142,6 +143,7 @@ class ITSFhrTask final : public TaskInterface
   TH2D* mChipStaveOccupancy = nullptr;
   TH2I* mChipStaveEventHitCheck = nullptr;
   TH1D* mOccupancyPlot = nullptr;
+  o2::quality_control::core::HistogramShards mOccupancyShards; // per-thread copies of mOccupancyPlot
   bool mIgnoreRampUpData = true;
   // Geometry decoder
   o2::its::GeometryTGeo* mGeom = nullptr;
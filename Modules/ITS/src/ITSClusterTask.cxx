@@ -103,6 +103,7 @@ void ITSClusterTask::initialize(o2::framework::InitContext& /*ctx*/)
   mGeneralOccupancy->GetZaxis()->SetTitle("Max Avg Cluster occ (clusters/event/chip)");
 
   publishHistos();
+  createHistoShards();
 }
 
 void ITSClusterTask::startOfActivity(const Activity& /*activity*/)
@@ -139,7 +140,21 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
   auto clusArr = ctx.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("compclus");
   auto clusRofArr = ctx.inputs().get<gsl::span<o2::itsmft::ROFRecord>>("clustersrof");
   auto clusPatternArr = ctx.inputs().get<gsl::span<unsigned char>>("patterns");
-  auto pattIt = clusPatternArr.begin();
+
+  // The patterns of the clusters which need one are stored one after another, thus we find where the patterns
+  // of each ROF start, so that the ROFs can be processed in any order.
+  std::vector<decltype(clusPatternArr.begin())> rofPatterns(clusRofArr.size());
+  auto nextPattern = clusPatternArr.begin();
+  for (unsigned int iROF = 0; iROF < clusRofArr.size(); iROF++) {
+    rofPatterns[iROF] = nextPattern;
+    const auto& ROF = clusRofArr[iROF];
+    for (int icl = ROF.getFirstEntry(); icl < ROF.getFirstEntry() + ROF.getNEntries(); icl++) {
+      auto ClusterID = clusArr[icl].getPatternID();
+      if (ClusterID == o2::itsmft::CompCluster::InvalidPatternID || mDict->isGroup(ClusterID)) {
+        o2::itsmft::ClusterPattern::skipPattern(nextPattern);
+      }
+    }
+  }
 
   // Reset this histo to have the latest picture
   hEmptyLaneFractionGlobal->Reset("ICES");
@@ -149,10 +164,16 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
 #pragma omp parallel for schedule(dynamic)
 #endif
 
-  // Filling cluster histogram for each ROF by open_mp
+  // Filling cluster histogram for each ROF by open_mp, each thread fills its own copies of the histograms
   for (unsigned int iROF = 0; iROF < clusRofArr.size(); iROF++) {
 
+#ifdef WITH_OPENMP
+    const size_t shard = omp_get_thread_num();
+#else
+    const size_t shard = 0;
+#endif
     const auto& ROF = clusRofArr[iROF];
+    auto pattIt = rofPatterns[iROF];
     const auto bcdata = ROF.getBCData();
     int nClustersForBunchCrossing = 0;
     int nLongClusters[ChipBoundary[NLayerIB]] = {};
@@ -226,37 +247,37 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
       }
 
       if (lay < NLayerIB) {
-        hAverageClusterOccupancySummaryIB[lay]->getNum()->Fill(chip, sta);
-        hAverageClusterSizeSummaryIB[lay]->getNum()->Fill(chip, sta, (double)npix);
-        hAverageClusterSizeSummaryIB[lay]->getDen()->Fill(chip, sta, 1.);
+        mShards.get(hAverageClusterOccupancySummaryIB[lay]->getNum(), shard)->Fill(chip, sta);
+        mShards.get(hAverageClusterSizeSummaryIB[lay]->getNum(), shard)->Fill(chip, sta, (double)npix);
+        mShards.get(hAverageClusterSizeSummaryIB[lay]->getDen(), shard)->Fill(chip, sta, 1.);
         if (mDoPublish1DSummary == 1) {
-          hClusterTopologySummaryIB[lay][sta][chip]->Fill(ClusterID);
+          mShards.get(hClusterTopologySummaryIB[lay][sta][chip], shard)->Fill(ClusterID);
         }
 
-        hClusterSizeLayerSummary[lay]->Fill(npix);
-        hClusterTopologyLayerSummary[lay]->Fill(ClusterID);
+        mShards.get(hClusterSizeLayerSummary[lay], shard)->Fill(npix);
+        mShards.get(hClusterTopologyLayerSummary[lay], shard)->Fill(ClusterID);
 
         if (isGrouped) {
           if (mDoPublish1DSummary == 1) {
-            hGroupedClusterSizeSummaryIB[lay][sta][chip]->Fill(npix);
+            mShards.get(hGroupedClusterSizeSummaryIB[lay][sta][chip], shard)->Fill(npix);
           }
-          hGroupedClusterSizeLayerSummary[lay]->Fill(npix);
+          mShards.get(hGroupedClusterSizeLayerSummary[lay], shard)->Fill(npix);
         }
       } else {
-        hAverageClusterOccupancySummaryOB[lay]->getNum()->Fill(lane, sta, 1. / (mNChipsPerHic[lay] / mNLanePerHic[lay])); // 14 To have occupation per chip -> 7 because we're considering lanes
-        hAverageClusterSizeSummaryOB[lay]->getNum()->Fill(lane, sta, (double)npix);
-        hAverageClusterSizeSummaryOB[lay]->getDen()->Fill(lane, sta, 1);
+        mShards.get(hAverageClusterOccupancySummaryOB[lay]->getNum(), shard)->Fill(lane, sta, 1. / (mNChipsPerHic[lay] / mNLanePerHic[lay])); // 14 To have occupation per chip -> 7 because we're considering lanes
+        mShards.get(hAverageClusterSizeSummaryOB[lay]->getNum(), shard)->Fill(lane, sta, (double)npix);
+        mShards.get(hAverageClusterSizeSummaryOB[lay]->getDen(), shard)->Fill(lane, sta, 1);
         if (mDoPublish1DSummary == 1) {
-          hClusterTopologySummaryOB[lay][sta]->Fill(ClusterID);
-          hClusterSizeSummaryOB[lay][sta]->Fill(npix);
+          mShards.get(hClusterTopologySummaryOB[lay][sta], shard)->Fill(ClusterID);
+          mShards.get(hClusterSizeSummaryOB[lay][sta], shard)->Fill(npix);
         }
-        hClusterSizeLayerSummary[lay]->Fill(npix);
-        hClusterTopologyLayerSummary[lay]->Fill(ClusterID);
+        mShards.get(hClusterSizeLayerSummary[lay], shard)->Fill(npix);
+        mShards.get(hClusterTopologyLayerSummary[lay], shard)->Fill(ClusterID);
         if (isGrouped) {
           if (mDoPublish1DSummary == 1) {
-            hGroupedClusterSizeSummaryOB[lay][sta]->Fill(npix);
+            mShards.get(hGroupedClusterSizeSummaryOB[lay][sta], shard)->Fill(npix);
           }
-          hGroupedClusterSizeLayerSummary[lay]->Fill(npix);
+          mShards.get(hGroupedClusterSizeLayerSummary[lay], shard)->Fill(npix);
         }
       }
 
@@ -266,14 +287,14 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
         float phi = (float)TMath::ATan2(gloC.Y(), gloC.X());
 
         phi = (float)(phi * 180 / TMath::Pi());
-        hAverageClusterOccupancySummaryZPhi[lay]->getNum()->Fill(gloC.Z(), phi);
-        hAverageClusterSizeSummaryZPhi[lay]->getNum()->Fill(gloC.Z(), phi, (float)npix);
+        mShards.get(hAverageClusterOccupancySummaryZPhi[lay]->getNum(), shard)->Fill(gloC.Z(), phi);
+        mShards.get(hAverageClusterSizeSummaryZPhi[lay]->getNum(), shard)->Fill(gloC.Z(), phi, (float)npix);
 
-        hAverageClusterOccupancySummaryFine[lay]->getNum()->Fill(getHorizontalBin(locC.Z(), chip, lay, lane), getVerticalBin(locC.X(), sta, lay));
-        hAverageClusterSizeSummaryFine[lay]->getNum()->Fill(getHorizontalBin(locC.Z(), chip, lay, lane), getVerticalBin(locC.X(), sta, lay), (float)npix);
+        mShards.get(hAverageClusterOccupancySummaryFine[lay]->getNum(), shard)->Fill(getHorizontalBin(locC.Z(), chip, lay, lane), getVerticalBin(locC.X(), sta, lay));
+        mShards.get(hAverageClusterSizeSummaryFine[lay]->getNum(), shard)->Fill(getHorizontalBin(locC.Z(), chip, lay, lane), getVerticalBin(locC.X(), sta, lay), (float)npix);
       }
     }
-    hClusterVsBunchCrossing->Fill(bcdata.bc, nClustersForBunchCrossing); // we count only the number of clusters, not their sizes
+    mShards.get(hClusterVsBunchCrossing, shard)->Fill(bcdata.bc, nClustersForBunchCrossing); // we count only the number of clusters, not their sizes
 
     // filling these anomaly plots once per ROF, ignoring chips w/o long clusters
     for (int ichip = 0; ichip < ChipBoundary[NLayerIB]; ichip++) {
@@ -286,10 +307,11 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
       while (ichip >= ChipBoundary[ilayer + 1]) {
         ilayer++;
       }
-      hLongClustersPerChip[ilayer]->Fill(ichip, nLong);
-      hMultPerChipWhenLongClusters[ilayer]->Fill(ichip, nHitsFromClusters[ichip]);
+      mShards.get(hLongClustersPerChip[ilayer], shard)->Fill(ichip, nLong);
+      mShards.get(hMultPerChipWhenLongClusters[ilayer], shard)->Fill(ichip, nHitsFromClusters[ichip]);
     }
   }
+  mShards.merge();
 
   if ((int)clusRofArr.size() > 0) {
 
@@ -392,6 +414,7 @@ void ITSClusterTask::endOfActivity(const Activity& /*activity*/)
 void ITSClusterTask::reset()
 {
   ILOG(Debug, Devel) << "Resetting the histograms" << ENDM;
+  mShards.reset();
   hClusterVsBunchCrossing->Reset();
   hEmptyLaneFractionGlobal->Reset("ICES");
   mGeneralOccupancy->Reset();
@@ -623,6 +646,57 @@ void ITSClusterTask::createAllHistos()
   }
 }
 
+void ITSClusterTask::createHistoShards()
+{
+  // only the histograms filled in the parallel loop of monitorData()
+#ifdef WITH_OPENMP
+  mShards.setNumberOfShards(mNThreads);
+#endif
+  mShards.clear();
+  mShards.add(hClusterVsBunchCrossing);
+  for (int iLayer = 0; iLayer < NLayer; iLayer++) {
+    if (!mEnableLayers[iLayer])
+      continue;
+
+    mShards.add(hClusterSizeLayerSummary[iLayer]);
+    mShards.add(hGroupedClusterSizeLayerSummary[iLayer]);
+    mShards.add(hClusterTopologyLayerSummary[iLayer]);
+    if (mDoPublishDetailedSummary == 1) {
+      mShards.add(hAverageClusterOccupancySummaryZPhi[iLayer]->getNum());
+      mShards.add(hAverageClusterSizeSummaryZPhi[iLayer]->getNum());
+      mShards.add(hAverageClusterOccupancySummaryFine[iLayer]->getNum());
+      mShards.add(hAverageClusterSizeSummaryFine[iLayer]->getNum());
+    }
+
+    if (iLayer < NLayerIB) {
+      mShards.add(hLongClustersPerChip[iLayer]);
+      mShards.add(hMultPerChipWhenLongClusters[iLayer]);
+      mShards.add(hAverageClusterOccupancySummaryIB[iLayer]->getNum());
+      mShards.add(hAverageClusterSizeSummaryIB[iLayer]->getNum());
+      mShards.add(hAverageClusterSizeSummaryIB[iLayer]->getDen());
+      if (mDoPublish1DSummary == 1) {
+        for (int iStave = 0; iStave < mNStaves[iLayer]; iStave++) {
+          for (int iChip = 0; iChip < mNChipsPerHic[iLayer]; iChip++) {
+            mShards.add(hClusterTopologySummaryIB[iLayer][iStave][iChip]);
+            mShards.add(hGroupedClusterSizeSummaryIB[iLayer][iStave][iChip]);
+          }
+        }
+      }
+    } else {
+      mShards.add(hAverageClusterOccupancySummaryOB[iLayer]->getNum());
+      mShards.add(hAverageClusterSizeSummaryOB[iLayer]->getNum());
+      mShards.add(hAverageClusterSizeSummaryOB[iLayer]->getDen());
+      if (mDoPublish1DSummary == 1) {
+        for (int iStave = 0; iStave < mNStaves[iLayer]; iStave++) {
+          mShards.add(hClusterTopologySummaryOB[iLayer][iStave]);
+          mShards.add(hClusterSizeSummaryOB[iLayer][iStave]);
+          mShards.add(hGroupedClusterSizeSummaryOB[iLayer][iStave]);
+        }
+      }
+    }
+  }
+}
+
 void ITSClusterTask::getJsonParameters()
 {
   mNThreads = o2::quality_control_modules::common::getFromConfig<int>(mCustomParameters, "nThreads", mNThreads);
@@ -105,6 +105,10 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
   createGeneralPlots();
   createOccupancyPlots();
   setPlotsFormat();
+#ifdef WITH_OPENMP
+  mOccupancyShards.setNumberOfShards(mNThreads);
+#endif
+  mOccupancyShards.add(mOccupancyPlot);
   mDecoder = new o2::itsmft::RawPixelDecoder<o2::itsmft::ChipMappingITS>();
   mDecoder->init();
   mDecoder->setSkipRampUpData(mIgnoreRampUpData);
@@ -529,12 +533,6 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
   mErrorPlots->Reset();
   mErrorVsFeeid->Reset(); // Error is   statistic by decoder so if we didn't reset decoder, then we need reset Error plots, and use TH::SetBinContent function
 
-  // define tmp occupancy plot, which will use for multiple threads
-  TH1D** occupancyPlotTmp = new TH1D*[(int)activeStaves.size()];
-  for (int i = 0; i < (int)activeStaves.size(); i++) {
-    occupancyPlotTmp[i] = new TH1D("", "", 300, -15, 0);
-  }
-
   int totalhit = 0;
 #ifdef WITH_OPENMP
   omp_set_num_threads(mNThreads);
@@ -542,7 +540,13 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
                                                      : totalhit)
 #endif
   // fill Monitor Objects use openMP multiple threads, and calculate the occupancy
+  // each thread fills its own copy of the occupancy plot
   for (int i = 0; i < (int)activeStaves.size(); i++) {
+#ifdef WITH_OPENMP
+    const size_t shard = omp_get_thread_num();
+#else
+    const size_t shard = 0;
+#endif
     int istave = activeStaves[i];
     if (digVec[istave][0].size() < 1 && mLayer < NLayerIB) {
       continue;
@@ -577,7 +581,7 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
             if ((iter->second > mHitCutForNoisyPixel) &&
                 (iter->second / (double)GBTLinkInfo->statistics.nTriggers) > mOccupancyCutForNoisyPixel) {
               mNoisyPixelNumber[mLayer][istave]++; // count only in 10000 events as soon as nTriggers is 1e6
-              occupancyPlotTmp[i]->Fill(log10((double)iter->second / GBTLinkInfo->statistics.nTriggers));
+              mOccupancyShards.get(mOccupancyPlot, shard)->Fill(log10((double)iter->second / GBTLinkInfo->statistics.nTriggers));
             }
 
             totalhit += (int)iter->second;
@@ -617,7 +621,7 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
                 if ((iter->second > mHitCutForNoisyPixel) &&
                     (iter->second / (double)GBTLinkInfo->statistics.nTriggers) > mOccupancyCutForNoisyPixel) {
                   mNoisyPixelNumber[mLayer][istave]++;
-                  occupancyPlotTmp[i]->Fill(log10((double)iter->second / GBTLinkInfo->statistics.nTriggers));
+                  mOccupancyShards.get(mOccupancyPlot, shard)->Fill(log10((double)iter->second / GBTLinkInfo->statistics.nTriggers));
                 }
               }
             }
@@ -640,10 +644,11 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
       }
     }
   }
+  mOccupancyShards.merge();
+
   // fill Occupancy plots, chip stave occupancy plots and error statistic plots
   for (int i = 0; i < (int)activeStaves.size(); i++) {
     int istave = activeStaves[i];
-    mOccupancyPlot->Add(occupancyPlotTmp[i]);
     if (mLayer < NLayerIB) {
       for (int ichip = 0; ichip < nChipsPerHic[mLayer]; ichip++) {
         mChipStaveOccupancy->SetBinContent(ichip + 1, istave + 1, mOccupancyLane[istave][ichip]);
@@ -709,11 +714,6 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
   }
   delete[] digVec;
 
-  for (int i = 0; i < (int)activeStaves.size(); i++) {
-    delete occupancyPlotTmp[i];
-  }
-  delete[] occupancyPlotTmp;
-
   end = std::chrono::high_resolution_clock::now();
   difference = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 
@@ -761,6 +761,7 @@ void ITSFhrTask::resetOccupancyPlots()
   mChipStaveOccupancy->Reset();
   mChipStaveEventHitCheck->Reset();
   mOccupancyPlot->Reset();
+  mOccupancyShards.reset();
   mDeadChipPos->Reset();
   mAliveChipPos->Reset();
   mTotalDeadChipPos->Reset();
@@ -18,6 +18,7 @@
 #include <memory>
 #include "MCHGeometryTransformer/Transformations.h"
 #include "MUONCommon/HistPlotter.h"
+#include "MCH/PadLookupTable.h"
 #include <TProfile.h>
 #include <TH1F.h>
 
@@ -68,6 +69,7 @@ class ClustersTask /*final*/ : public TaskInterface
   o2::mch::raw::Det2ElecMapper mDet2ElecMapper;
   o2::mch::raw::Solar2FeeLinkMapper mSolar2FeeLinkMapper;
   std::unique_ptr<o2::mch::geo::TransformationCreator> mTransformation;
+  const PadLookupTable* mPadLookup{ nullptr }; //! shared pad to electronics mapping
 
   muon::HistPlotter mHistPlotter;
 };
@@ -25,6 +25,7 @@
 #endif
 #include "MCHDigitFiltering/DigitFilter.h"
 #include "Common/TH2Ratio.h"
+#include "MCH/PadLookupTable.h"
 
 class TH1F;
 class TH2F;
@@ -71,6 +72,8 @@ class DigitsTask /*final*/ : public TaskInterface // todo add back the "final" w
 
   o2::mch::DigitFilter mIsSignalDigit;
 
+  const PadLookupTable* mPadLookup{ nullptr }; //! shared pad to electronics mapping
+
   uint32_t mNOrbits{ 0 };
 
   // 2D Histograms, using Elec view (where x and y uniquely identify each pad based on its Elec info (fee, link, de)
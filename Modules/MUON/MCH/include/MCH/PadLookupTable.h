@@ -0,0 +1,69 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   PadLookupTable.h
+///
+
+#ifndef QC_MODULE_MUONCHAMBERS_PADLOOKUPTABLE_H
+#define QC_MODULE_MUONCHAMBERS_PADLOOKUPTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+/// \brief Electronics and detector coordinates of one pad
+struct PadElecInfo {
+  uint16_t fecId;  // global index of the dual SAMPA, as returned by o2::mch::getDsIndex()
+  uint8_t channel; // channel of the pad in the dual SAMPA
+  uint8_t chamber; // chamber index, from 0 to 9
+  uint8_t station; // station index, from 0 to 4
+};
+
+/// \brief Flat table mapping (deId, padId) to the electronics coordinates of the pad
+///
+/// Looking up the segmentation of the detection element, the dual SAMPA of the pad and its global index for each
+/// digit is a significant part of the processing time of the MCH tasks. The table is filled once for all the pads
+/// of the spectrometer (~1M entries of 6 bytes) and shared by all the tasks running in the same process, so that
+/// each lookup is reduced to two array accesses. Tasks should call instance() in initialize(), so that the table is
+/// not built while processing the first data.
+class PadLookupTable
+{
+ public:
+  /// \brief Returns the table of the process, which is built by the first call. Thread-safe.
+  static const PadLookupTable& instance();
+
+  /// \brief Returns the pad coordinates, or nullptr if the detection element or the pad does not exist
+  const PadElecInfo* find(int deId, int padId) const
+  {
+    if (deId < 0 || deId >= static_cast<int>(mNofPads.size()) || padId < 0 || padId >= mNofPads[deId]) {
+      return nullptr;
+    }
+    return &mPads[mOffsets[deId] + padId];
+  }
+
+  /// \brief Number of pads in the table
+  size_t size() const { return mPads.size(); }
+
+ private:
+  PadLookupTable();
+
+  std::vector<uint32_t> mOffsets;  // index of the first pad of each detection element in mPads, indexed by deId
+  std::vector<int32_t> mNofPads;   // number of pads of each detection element, indexed by deId, 0 if it does not exist
+  std::vector<PadElecInfo> mPads;  // all the pads, grouped by detection element
+};
+
+} // namespace o2::quality_control_modules::muonchambers
+
+#endif // QC_MODULE_MUONCHAMBERS_PADLOOKUPTABLE_H
@@ -28,6 +28,7 @@
 #endif
 #include "MCHDigitFiltering/DigitFilter.h"
 #include "MCHBase/PreCluster.h"
+#include "MCH/PadLookupTable.h"
 
 using namespace o2::quality_control_modules::common;
 
@@ -66,6 +67,8 @@ class PreclustersTask /*final*/ : public o2::quality_control::core::TaskInterfac
 
   o2::mch::DigitFilter mIsSignalDigit;
 
+  const PadLookupTable* mPadLookup{ nullptr }; //! shared pad to electronics mapping
+
   std::unique_ptr<TH2FRatio> mHistogramPseudoeffElec; // Mergeable object, Occupancy histogram (Elec view)
 
   std::unique_ptr<TH1DRatio> mHistogramPreclustersPerDE;       // number of pre-clusters per DE and per TF
@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include "MCH/ClustersTask.h"
+#include "MCH/PadLookupTable.h"
 
 #include "MCHGlobalMapping/DsIndex.h"
 #include "MUONCommon/HistPlotter.h"
@@ -101,6 +102,7 @@ void ClustersTask::initialize(o2::framework::InitContext& /*ic*/)
 
   mDet2ElecMapper = o2::mch::raw::createDet2ElecMapper<o2::mch::raw::ElectronicMapperGenerated>();
   mSolar2FeeLinkMapper = o2::mch::raw::createSolar2FeeLinkMapper<o2::mch::raw::ElectronicMapperGenerated>();
+  mPadLookup = &PadLookupTable::instance();
 }
 
 void ClustersTask::startOfActivity(const Activity& activity)
@@ -138,13 +140,11 @@ void ClustersTask::fillClusterHistos(gsl::span<const o2::mch::Cluster> clusters)
 
     seg.findPadPairByPosition(local.X(), local.Y(), b, nb);
 
-    if (b >= 0) {
-      int dsId = seg.padDualSampaId(b);
-      mNofClustersPerDualSampa->Fill(o2::mch::getDsIndex(o2::mch::raw::DsDetId(deId, dsId)));
+    if (const auto* pad = mPadLookup->find(deId, b); pad != nullptr) {
+      mNofClustersPerDualSampa->Fill(pad->fecId);
     }
-    if (nb >= 0) {
-      int dsId = seg.padDualSampaId(nb);
-      mNofClustersPerDualSampa->Fill(o2::mch::getDsIndex(o2::mch::raw::DsDetId(deId, dsId)));
+    if (const auto* pad = mPadLookup->find(deId, nb); pad != nullptr) {
+      mNofClustersPerDualSampa->Fill(pad->fecId);
     }
     int chamberId = cluster.getChamberId();
     mClusterSizePerChamber->Fill(chamberId + 1, cluster.nDigits);
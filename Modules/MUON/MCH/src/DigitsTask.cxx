@@ -17,8 +17,8 @@
 
 #include "MCH/DigitsTask.h"
 #include "MCH/Helpers.h"
+#include "MCH/PadLookupTable.h"
 #include "MUONCommon/Helpers.h"
-#include "MCHMappingInterface/Segmentation.h"
 #include "MCHRawDecoder/DataDecoder.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "DetectorsBase/GRPGeomHelper.h"
@@ -61,6 +61,7 @@ void DigitsTask::initialize(o2::framework::InitContext& /*ctx*/)
   ILOG(Debug, Devel) << "initialize DigitsTask" << AliceO2::InfoLogger::InfoLogger::endm;
 
   mIsSignalDigit = o2::mch::createDigitFilter(20, true, true);
+  mPadLookup = &PadLookupTable::instance();
 
   // flag to enable extra disagnostics plots; it also enables on-cycle plots
   mFullHistos = getConfigurationParameter<bool>(mCustomParameters, "FullHistos", mFullHistos);
@@ -145,10 +146,12 @@ void DigitsTask::plotDigit(const o2::mch::Digit& digit)
   }
 
   // Fill NHits Elec Histogram and ADC distribution
-  const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(deId);
+  const auto* pad = mPadLookup->find(deId, padId);
+  if (pad == nullptr) {
+    return;
+  }
 
-  int dsId = segment.padDualSampaId(padId);
-  int channel = segment.padDualSampaChannel(padId);
+  int channel = pad->channel;
 
   bool isSignal = mIsSignalDigit(digit);
 
@@ -157,7 +160,7 @@ void DigitsTask::plotDigit(const o2::mch::Digit& digit)
   //--------------------------------------------------------------------------
 
   // fecId and channel uniquely identify each physical pad
-  int fecId = getDsIndex(DsDetId{ deId, dsId });
+  int fecId = pad->fecId;
 
   mHistogramOccupancyElec->getNum()->Fill(fecId, channel);
   if (isSignal) {
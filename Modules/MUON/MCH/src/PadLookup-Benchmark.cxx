@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   PadLookup-Benchmark.cxx
+///
+/// \brief Compares the number of digits per second converted to electronics coordinates with the mapping
+///        interface, as the MCH tasks used to do, and with the PadLookupTable.
+///
+
+#include "MCH/PadLookupTable.h"
+#include "MCHConstants/DetectionElements.h"
+#include "MCHGlobalMapping/DsIndex.h"
+#include "MCHMappingInterface/Segmentation.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Timer.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace po = boost::program_options;
+using namespace o2::quality_control_modules::muonchambers;
+
+struct Pad {
+  int deId;
+  int padId;
+};
+
+int main(int argc, char* argv[])
+{
+  po::options_description desc{ "Options" };
+  desc.add_options()                                                                                  //
+    ("help,h", "Help screen")                                                                         //
+    ("digits", po::value<size_t>()->default_value(10'000'000), "Number of digits in each measurement") //
+    ("repetitions", po::value<size_t>()->default_value(5), "Number of measurements");
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  po::notify(vm);
+
+  const auto nDigits = vm["digits"].as<size_t>();
+  const auto repetitions = std::max<size_t>(1, vm["repetitions"].as<size_t>());
+  ILOG_INST.filterDiscardDebug(true);
+
+  AliceO2::Common::Timer timer;
+  timer.reset();
+  const auto& table = PadLookupTable::instance();
+  std::cout << "Lookup table with " << table.size() << " pads built in " << timer.getTime() * 1e3 << " ms" << std::endl;
+
+  // digits spread randomly over the whole spectrometer, so that consecutive digits rarely share a detection element
+  std::vector<Pad> pads(nDigits);
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<size_t> deDistribution(0, o2::mch::constants::deIdsForAllMCH.size() - 1);
+  for (auto& pad : pads) {
+    pad.deId = o2::mch::constants::deIdsForAllMCH[deDistribution(generator)];
+    std::uniform_int_distribution<int> padDistribution(0, o2::mch::mapping::segmentation(pad.deId).nofPads() - 1);
+    pad.padId = padDistribution(generator);
+  }
+
+  // the checksums make sure that both methods give the same result and that the loops are not optimised away
+  uint64_t mappingChecksum = 0;
+  uint64_t tableChecksum = 0;
+  double mappingDuration = 0;
+  double tableDuration = 0;
+  for (size_t r = 0; r < repetitions; r++) {
+    mappingChecksum = 0;
+    timer.reset();
+    for (const auto& pad : pads) {
+      const auto& segment = o2::mch::mapping::segmentation(pad.deId);
+      int dsId = segment.padDualSampaId(pad.padId);
+      int channel = segment.padDualSampaChannel(pad.padId);
+      int fecId = o2::mch::getDsIndex(o2::mch::raw::DsDetId{ pad.deId, dsId });
+      mappingChecksum += fecId * 64 + channel;
+    }
+    mappingDuration += timer.getTime();
+
+    tableChecksum = 0;
+    timer.reset();
+    for (const auto& pad : pads) {
+      const auto* info = table.find(pad.deId, pad.padId);
+      tableChecksum += info->fecId * 64 + info->channel;
+    }
+    tableDuration += timer.getTime();
+  }
+  mappingDuration /= repetitions;
+  tableDuration /= repetitions;
+
+  if (mappingChecksum != tableChecksum) {
+    std::cerr << "The lookup table does not give the same electronics coordinates as the mapping" << std::endl;
+    return 1;
+  }
+
+  std::cout << std::setw(12) << "method"
+            << std::setw(16) << "time [ms]"
+            << std::setw(20) << "digits/s" << std::endl;
+  std::cout << std::setw(12) << "mapping"
+            << std::setw(16) << mappingDuration * 1e3
+            << std::setw(20) << nDigits / mappingDuration << std::endl;
+  std::cout << std::setw(12) << "table"
+            << std::setw(16) << tableDuration * 1e3
+            << std::setw(20) << nDigits / tableDuration << std::endl;
+  std::cout << "Speedup: " << mappingDuration / tableDuration << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   PadLookupTable.cxx
+///
+
+#include "MCH/PadLookupTable.h"
+#include "MCHConstants/DetectionElements.h"
+#include "MCHGlobalMapping/DsIndex.h"
+#include "MCHMappingInterface/Segmentation.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <algorithm>
+
+namespace o2::quality_control_modules::muonchambers
+{
+
+const PadLookupTable& PadLookupTable::instance()
+{
+  static const PadLookupTable table;
+  return table;
+}
+
+PadLookupTable::PadLookupTable()
+{
+  int maxDeId = *std::max_element(o2::mch::constants::deIdsForAllMCH.begin(), o2::mch::constants::deIdsForAllMCH.end());
+  mOffsets.resize(maxDeId + 1, 0);
+  mNofPads.resize(maxDeId + 1, 0);
+
+  size_t nofPads = 0;
+  for (auto deId : o2::mch::constants::deIdsForAllMCH) {
+    mNofPads[deId] = o2::mch::mapping::segmentation(deId).nofPads();
+    nofPads += mNofPads[deId];
+  }
+  mPads.reserve(nofPads);
+
+  for (auto deId : o2::mch::constants::deIdsForAllMCH) {
+    const auto& segmentation = o2::mch::mapping::segmentation(deId);
+    const auto chamber = static_cast<uint8_t>(deId / 100 - 1);
+    const auto station = static_cast<uint8_t>(chamber / 2);
+    mOffsets[deId] = mPads.size();
+    for (int padId = 0; padId < mNofPads[deId]; padId++) {
+      int dsId = segmentation.padDualSampaId(padId);
+      auto fecId = o2::mch::getDsIndex(o2::mch::raw::DsDetId{ deId, dsId });
+      mPads.push_back({ static_cast<uint16_t>(fecId), static_cast<uint8_t>(segmentation.padDualSampaChannel(padId)), chamber, station });
+    }
+  }
+
+  ILOG(Debug, Devel) << "MCH pad lookup table built with " << mPads.size() << " pads" << ENDM;
+}
+
+} // namespace o2::quality_control_modules::muonchambers
@@ -17,6 +17,7 @@
 
 #include "MCH/PreclustersTask.h"
 #include "MCH/Helpers.h"
+#include "MCH/PadLookupTable.h"
 #ifdef MCH_HAS_MAPPING_FACTORY
 #include "MCHMappingFactory/CreateSegmentation.h"
 #endif
@@ -55,6 +56,7 @@ void PreclustersTask::initialize(o2::framework::InitContext& /*ctx*/)
   ILOG(Info, Devel) << "initialize PreclustersTask" << AliceO2::InfoLogger::InfoLogger::endm;
 
   mIsSignalDigit = o2::mch::createDigitFilter(20, true, true);
+  mPadLookup = &PadLookupTable::instance();
 
   mHistogramPreclustersPerDE = std::make_unique<TH1DRatio>("PreclustersPerDE", "Number of pre-clusters for each DE", getNumDE(), 0, getNumDE());
   publishObject(mHistogramPreclustersPerDE.get(), "hist", false);
@@ -249,12 +251,14 @@ static void CoG(gsl::span<const o2::mch::Digit> precluster, double& Xcog, double
 
 //_________________________________________________________________________________________________
 
-static void getFecChannel(int deId, int padId, int& fecId, int& channel)
+static void getFecChannel(const PadLookupTable& padLookup, int deId, int padId, int& fecId, int& channel)
 {
-  const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(deId);
-  int dsId = segment.padDualSampaId(padId);
-  fecId = getDsIndex(DsDetId{ deId, dsId });
-  channel = segment.padDualSampaChannel(padId);
+  const auto* pad = padLookup.find(deId, padId);
+  if (pad == nullptr) {
+    return;
+  }
+  fecId = pad->fecId;
+  channel = pad->channel;
 }
 
 //_________________________________________________________________________________________________
@@ -325,8 +329,8 @@ void PreclustersTask::plotPrecluster(const o2::mch::PreCluster& preCluster, gsl:
   int fecIdNB = -1;
   int channelNB = -1;
   if (segment.findPadPairByPosition(Xcog, Ycog, padIdB, padIdNB)) {
-    getFecChannel(deId, padIdB, fecIdB, channelB);
-    getFecChannel(deId, padIdNB, fecIdNB, channelNB);
+    getFecChannel(*mPadLookup, deId, padIdB, fecIdB, channelB);
+    getFecChannel(*mPadLookup, deId, padIdNB, fecIdNB, channelNB);
   }
 
   // criteria to define a "good" charge cluster in one cathode:
@@ -66,6 +66,8 @@ class Clusters /*final*/ : public TaskInterface // todo add back the "final" whe
 
   void processClusterNative(o2::framework::InputRecord& inputs);
   void processKrClusters(o2::framework::InputRecord& inputs);
+  /// \brief Draws the summary canvases of the normalized data, done once per cycle before the publication
+  void drawCanvases();
 };
 
 } // namespace o2::quality_control_modules::tpc
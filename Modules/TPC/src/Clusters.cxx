@@ -146,28 +146,30 @@ void Clusters::monitorData(ProcessingContext& ctx)
 
   processClusterNative(ctx.inputs());
   processKrClusters(ctx.inputs());
-
-  if (!mIsMergeable) {
-    mQCClusters.getClusters().normalize();
-
-    fillCanvases(mQCClusters.getClusters().getNClusters(), mNClustersCanvasVec, mCustomParameters, "NClusters");
-    fillCanvases(mQCClusters.getClusters().getQMax(), mQMaxCanvasVec, mCustomParameters, "Qmax");
-    fillCanvases(mQCClusters.getClusters().getQTot(), mQTotCanvasVec, mCustomParameters, "Qtot");
-    fillCanvases(mQCClusters.getClusters().getSigmaTime(), mSigmaTimeCanvasVec, mCustomParameters, "SigmaPad");
-    fillCanvases(mQCClusters.getClusters().getSigmaPad(), mSigmaPadCanvasVec, mCustomParameters, "SigmaTime");
-    fillCanvases(mQCClusters.getClusters().getTimeBin(), mTimeBinCanvasVec, mCustomParameters, "TimeBin");
-  }
 }
 
 void Clusters::endOfCycle()
 {
   ILOG(Debug, Devel) << "endOfCycle" << ENDM;
 
-  if (mIsMergeable) {
-    mQCClusters.getClusters().normalize();
+  // the objects are published right after endOfCycle, so the data is normalized and the canvases are drawn
+  // only once per cycle, not for each TF. The next call to monitorData() denormalizes the data again.
+  mQCClusters.getClusters().normalize();
+  if (!mIsMergeable) {
+    drawCanvases();
   }
 }
 
+void Clusters::drawCanvases()
+{
+  fillCanvases(mQCClusters.getClusters().getNClusters(), mNClustersCanvasVec, mCustomParameters, "NClusters");
+  fillCanvases(mQCClusters.getClusters().getQMax(), mQMaxCanvasVec, mCustomParameters, "Qmax");
+  fillCanvases(mQCClusters.getClusters().getQTot(), mQTotCanvasVec, mCustomParameters, "Qtot");
+  fillCanvases(mQCClusters.getClusters().getSigmaTime(), mSigmaTimeCanvasVec, mCustomParameters, "SigmaPad");
+  fillCanvases(mQCClusters.getClusters().getSigmaPad(), mSigmaPadCanvasVec, mCustomParameters, "SigmaTime");
+  fillCanvases(mQCClusters.getClusters().getTimeBin(), mTimeBinCanvasVec, mCustomParameters, "TimeBin");
+}
+
 void Clusters::endOfActivity(const Activity& /*activity*/)
 {
   ILOG(Debug, Devel) << "endOfActivity" << ENDM;